@@ -25,7 +25,10 @@ public class LotA : ModuleRules
 
 		PrivateDependencyModuleNames.AddRange(new string[]
 		{
-			// Add private modules here if needed
+			"AssetRegistry",
+			"NetCore",
+			"RenderCore",
+			"RHI"
 		});
 
 		// Optional: Add include paths if required
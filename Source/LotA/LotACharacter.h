@@ -9,6 +9,7 @@
 
 class USpringArmComponent;
 class UCameraComponent;
+class UEncumbranceComponent;
 class UInputMappingContext;
 class UInputAction;
 struct FInputActionValue;
@@ -44,6 +45,10 @@ class ALotACharacter : public ACharacter
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
 	UInputAction* LookAction;
 
+	/** Scales movement from carried bag weight */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Inventory, meta = (AllowPrivateAccess = "true"))
+	UEncumbranceComponent* Encumbrance;
+
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Input, meta = (AllowPrivateAccess = "true"))
 	UInputAction* IA_ToggleBags;
 
@@ -75,5 +80,7 @@ public:
 	FORCEINLINE class USpringArmComponent* GetCameraBoom() const { return CameraBoom; }
 	/** Returns FollowCamera subobject **/
 	FORCEINLINE class UCameraComponent* GetFollowCamera() const { return FollowCamera; }
+	/** Returns Encumbrance subobject **/
+	FORCEINLINE class UEncumbranceComponent* GetEncumbrance() const { return Encumbrance; }
 };
 
@@ -2,14 +2,84 @@
 #include "BagComponent.h"
 #include "Net/UnrealNetwork.h"
 #include "GameFramework/PlayerController.h"
+#include "InventorySlotPoolSubsystem.h"
+#include "InventoryAuditSubsystem.h"
+#include "ItemInstanceSubsystem.h"
+#include "ItemRegistrySubsystem.h"
+#include "InventoryRegistryComponent.h"
+#include "InventoryStoreSubsystem.h"
+
+namespace
+{
+    // Lightweight copy of a slot used to dry-run placements before touching real slots
+    struct FSimulatedSlot
+    {
+        FName ItemID;
+        int32 Count;
+    };
+
+    // Mirrors UBagComponent::AddItemToSlots on simulated slots
+    int32 SimulateAddItem(TArray<FSimulatedSlot>& Slots, const FS_ItemInfo& Item, int32 Count)
+    {
+        const int32 MaxStack = Item.GetMaxStack();
+
+        for (FSimulatedSlot& Slot : Slots)
+        {
+            if (Count > 0 && Slot.Count > 0 && Slot.ItemID == Item.ItemID)
+            {
+                const int32 ToAdd = FMath::Min(MaxStack - Slot.Count, Count);
+                if (ToAdd > 0)
+                {
+                    Slot.Count += ToAdd;
+                    Count -= ToAdd;
+                }
+            }
+        }
+
+        for (FSimulatedSlot& Slot : Slots)
+        {
+            if (Count > 0 && Slot.Count == 0)
+            {
+                const int32 ToAdd = FMath::Min(MaxStack, Count);
+                Slot.ItemID = Item.ItemID;
+                Slot.Count = ToAdd;
+                Count -= ToAdd;
+            }
+        }
+
+        return Count;
+    }
+}
 
 UBagComponent::UBagComponent()
 {
     PrimaryComponentTick.bCanEverTick = false;
     bIsOpen = false;
+    ContentsWeight = 0.0;
+    SnapshotRevision = 0;
     SetIsReplicatedByDefault(true);
 }
 
+void UBagComponent::OnRegister()
+{
+    Super::OnRegister();
+
+    // Bags on a pawn that isn't possessed yet are picked up by the registry on possession
+    if (UInventoryRegistryComponent* Registry = UInventoryRegistryComponent::FindForActor(GetOwner()))
+    {
+        Registry->RegisterContainer(this);
+    }
+}
+
+void UBagComponent::OnUnregister()
+{
+    if (UInventoryRegistryComponent* Registry = UInventoryRegistryComponent::FindForActor(GetOwner()))
+    {
+        Registry->UnregisterContainer(this);
+    }
+    Super::OnUnregister();
+}
+
 void UBagComponent::BeginPlay()
 {
     Super::BeginPlay();
@@ -17,7 +87,7 @@ void UBagComponent::BeginPlay()
     // Create inventory slots if we're the server
     if (GetOwnerRole() == ROLE_Authority)
     {
-        CreateInventorySlots();
+        ResizeSlots(BagInfo.BagSlots);
     }
 }
 
@@ -25,16 +95,7 @@ void UBagComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
     Super::EndPlay(EndPlayReason);
     CloseBag();
-
-    // Clean up inventory slots
-    for (auto* Slot : InventorySlots)
-    {
-        if (Slot)
-        {
-            Slot->DestroyComponent();
-        }
-    }
-    InventorySlots.Empty();
+    ReleaseAllSlots();
 }
 
 void UBagComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -42,7 +103,9 @@ void UBagComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLif
     Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
     DOREPLIFETIME(UBagComponent, bIsOpen);
-    DOREPLIFETIME(UBagComponent, BagInfo);
+    DOREPLIFETIME(UBagComponent, BagItem);
+    DOREPLIFETIME(UBagComponent, UncookedBagInfo);
+    DOREPLIFETIME_CONDITION(UBagComponent, InventorySlots, COND_OwnerOnly);
 }
 
 bool UBagComponent::OpenBag()
@@ -85,71 +148,425 @@ void UBagComponent::OnRep_IsOpen()
     }
 }
 
-bool UBagComponent::HasItems() const
+void UBagComponent::OnRep_InventorySlots()
 {
-    for (const auto* Slot : InventorySlots)
+    SyncStoreSize(InventorySlots.Num());
+    for (int32 i = 0; i < InventorySlots.Num(); ++i)
     {
-        if (Slot && !Slot->IsEmpty())
+        if (InventorySlots[i])
         {
-            return true;
+            InventorySlots[i]->SetOwningBag(this, i);
         }
     }
-    return false;
+
+    // Resizes change the slot count without touching the bag item
+    BagInfo.BagSlots = InventorySlots.Num();
+    ++SnapshotRevision;
+    OnResized.Broadcast(this);
 }
 
-float UBagComponent::GetTotalWeight() const
+void UBagComponent::OnRep_BagInfo()
 {
-    float TotalWeight = BagInfo.Weight;
+    const UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+    const FItemRegistryEntry* Entry = Registry ? Registry->FindEntry(BagItem.ItemID) : nullptr;
+    if (Entry)
+    {
+        BagInfo = Entry->Info;
+    }
+    else if (UncookedBagInfo.ItemID == BagItem.ItemID)
+    {
+        BagInfo = UncookedBagInfo;
+    }
+    else
+    {
+        BagInfo = FS_ItemInfo();
+        BagInfo.ItemID = BagItem.ItemID;
+    }
 
-    // Add weight of contents
-    for (const auto* Slot : InventorySlots)
+    if (InventorySlots.Num() > 0)
     {
-        if (Slot && !Slot->IsEmpty())
+        BagInfo.BagSlots = InventorySlots.Num();
+    }
+    ++SnapshotRevision;
+    OnWeightChanged.Broadcast(this, GetTotalWeight());
+}
+
+FInventoryStoreSlot UBagComponent::ReadSlot(int32 SlotIndex) const
+{
+    return StoreSubsystem ? StoreSubsystem->GetStore().GetSlot(StoreHandle, SlotIndex) : FInventoryStoreSlot();
+}
+
+void UBagComponent::WriteSlot(int32 SlotIndex, const FInventoryStoreSlot& Contents)
+{
+    if (!StoreSubsystem)
+        return;
+
+    FInventoryStore& Store = StoreSubsystem->GetStore();
+    const FInventoryStoreSlot OldContents = Store.GetSlot(StoreHandle, SlotIndex);
+    Store.SetSlot(StoreHandle, SlotIndex, Contents);
+    const FInventoryStoreSlot NewContents = Store.GetSlot(StoreHandle, SlotIndex);
+
+    if (OldContents.ItemIndex == NewContents.ItemIndex && OldContents.Count == NewContents.Count && OldContents.Instance == NewContents.Instance)
+        return;
+
+    if (GetOwnerRole() == ROLE_Authority && InventorySlots.IsValidIndex(SlotIndex) && InventorySlots[SlotIndex])
+    {
+        InventorySlots[SlotIndex]->UpdateNetContents();
+    }
+    HandleSlotChanged(SlotIndex, OldContents, NewContents);
+}
+
+void UBagComponent::HandleSlotChanged(int32 SlotIndex, const FInventoryStoreSlot& OldContents, const FInventoryStoreSlot& NewContents)
+{
+    // Only the server's changes are authoritative; client-side replays of them aren't audited
+    UInventoryAuditSubsystem* Audit = GetOwnerRole() == ROLE_Authority ? UInventoryAuditSubsystem::Get() : nullptr;
+    ++SnapshotRevision;
+
+    const UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+    const FItemRegistryEntry* OldEntry = Registry && !OldContents.IsEmpty() ? Registry->GetEntry(OldContents.ItemIndex) : nullptr;
+    const FItemRegistryEntry* NewEntry = Registry && !NewContents.IsEmpty() ? Registry->GetEntry(NewContents.ItemIndex) : nullptr;
+    const FName OldItemID = OldEntry ? OldEntry->Info.ItemID : NAME_None;
+    const FName NewItemID = NewEntry ? NewEntry->Info.ItemID : NAME_None;
+
+    auto AdjustCount = [this, Audit, SlotIndex](FName ItemID, int32 Delta)
+    {
+        if (ItemID.IsNone() || Delta == 0)
+            return;
+
+        if (Audit)
         {
-            TotalWeight += Slot->ItemData.Weight * Slot->StackCount;
+            Audit->RecordChange(this, SlotIndex, ItemID, Delta);
         }
+        OnItemCountChanged.Broadcast(this, ItemID, Delta);
+    };
+
+    if (OldItemID == NewItemID)
+    {
+        AdjustCount(NewItemID, NewContents.Count - OldContents.Count);
+    }
+    else
+    {
+        AdjustCount(OldItemID, -OldContents.Count);
+        AdjustCount(NewItemID, NewContents.Count);
+    }
+
+    OnSlotChanged.Broadcast(this, SlotIndex);
+
+    const double OldWeight = OldEntry ? double(OldEntry->Info.Weight) * OldContents.Count : 0.0;
+    const double NewWeight = NewEntry ? double(NewEntry->Info.Weight) * NewContents.Count : 0.0;
+    if (OldWeight != NewWeight)
+    {
+        // Snap to zero when empty so float drift can't accumulate over a long session
+        ContentsWeight = HasItems() ? FMath::Max(0.0, ContentsWeight + NewWeight - OldWeight) : 0.0;
+        OnWeightChanged.Broadcast(this, GetTotalWeight());
     }
+}
+
+bool UBagComponent::HasItems() const
+{
+    return StoreSubsystem && StoreSubsystem->GetStore().GetFreeSlotCount(StoreHandle) < StoreSubsystem->GetStore().GetNumSlots(StoreHandle);
+}
+
+int32 UBagComponent::GetFreeSlotCount() const
+{
+    return StoreSubsystem ? StoreSubsystem->GetStore().GetFreeSlotCount(StoreHandle) : 0;
+}
+
+int32 UBagComponent::GetItemCount(FName ItemID) const
+{
+    const UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+    const int32 ItemIndex = Registry ? Registry->FindItemIndex(ItemID) : INDEX_NONE;
+    return StoreSubsystem && ItemIndex != INDEX_NONE ? StoreSubsystem->GetStore().GetItemCount(StoreHandle, ItemIndex) : 0;
+}
+
+float UBagComponent::GetTotalWeight() const
+{
+    float ReducedContentsWeight = static_cast<float>(ContentsWeight);
 
     // Apply weight reduction if any
     if (BagInfo.WeightReductionPercentage > 0.0f)
     {
-        float ContentsWeight = TotalWeight - BagInfo.Weight;
-        float ReducedContentsWeight = ContentsWeight * (1.0f - (BagInfo.WeightReductionPercentage / 100.0f));
-        TotalWeight = BagInfo.Weight + ReducedContentsWeight;
+        ReducedContentsWeight *= 1.0f - (BagInfo.WeightReductionPercentage / 100.0f);
     }
 
-    return TotalWeight;
+    return BagInfo.Weight + ReducedContentsWeight;
 }
 
-void UBagComponent::InitializeBag(const FS_ItemInfo& BagItemInfo)
+bool UBagComponent::InitializeBag(const FS_ItemInfo& BagItemInfo)
 {
-    if (GetOwnerRole() == ROLE_Authority)
+    if (GetOwnerRole() != ROLE_Authority)
+        return false;
+
+    // The new info is in place while slots resize, so the weight and snapshots they update see the new bag
+    const FS_ItemInfo PreviousBagInfo = BagInfo;
+    BagInfo = BagItemInfo;
+    if (!ResizeSlots(BagItemInfo.BagSlots))
+    {
+        BagInfo = PreviousBagInfo;
+        UE_LOG(LogTemp, Warning, TEXT("Cannot change %s to %s: contents don't fit"), *GetName(), *BagItemInfo.ItemID.ToString());
+        return false;
+    }
+
+    BagItem.ItemID = BagItemInfo.ItemID;
+
+    const UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+    const int32 RegistryIndex = Registry ? Registry->FindItemIndex(BagItemInfo.ItemID) : INDEX_NONE;
+    const bool bNetIndexed = RegistryIndex != INDEX_NONE && RegistryIndex < Registry->GetNumNetIndexed();
+    UncookedBagInfo = bNetIndexed ? FS_ItemInfo() : BagItemInfo;
+    ++SnapshotRevision;
+    OnWeightChanged.Broadcast(this, GetTotalWeight());
+    return true;
+}
+
+bool UBagComponent::ResizeBag(int32 NewSlotCount)
+{
+    if (GetOwnerRole() != ROLE_Authority)
+        return false;
+
+    if (!ResizeSlots(NewSlotCount))
+        return false;
+
+    BagInfo.BagSlots = InventorySlots.Num();
+    return true;
+}
+
+int32 UBagComponent::AddItem(const FS_ItemInfo& Item, int32 Count)
+{
+    if (GetOwnerRole() != ROLE_Authority || Item.ItemID.IsNone() || Count <= 0)
+        return Count;
+
+    return AddItemToSlots(InventorySlots, Item, Count);
+}
+
+bool UBagComponent::ResizeSlots(int32 SlotCount)
+{
+    SlotCount = FMath::Max(0, SlotCount);
+    const int32 OldSlotCount = InventorySlots.Num();
+
+    if (SlotCount == OldSlotCount)
+        return true;
+
+    UInventorySlotPoolSubsystem* SlotPool = GetWorld() ? GetWorld()->GetSubsystem<UInventorySlotPoolSubsystem>() : nullptr;
+
+    if (SlotCount < OldSlotCount)
+    {
+        if (!RelocateOverflow(SlotCount))
+            return false;
+
+        for (int32 i = SlotCount; i < OldSlotCount; ++i)
+        {
+            if (SlotPool)
+            {
+                SlotPool->ReleaseSlot(InventorySlots[i]);
+            }
+            else if (InventorySlots[i])
+            {
+                InventorySlots[i]->ResetSlot();
+                InventorySlots[i]->DestroyComponent();
+            }
+        }
+        InventorySlots.SetNum(SlotCount, EAllowShrinking::No);
+        SyncStoreSize(SlotCount);
+        ++SnapshotRevision;
+        OnResized.Broadcast(this);
+        return true;
+    }
+
+    SyncStoreSize(SlotCount);
+    InventorySlots.Reserve(SlotCount);
+    for (int32 i = OldSlotCount; i < SlotCount; ++i)
     {
-        BagInfo = BagItemInfo;
-        CreateInventorySlots();
+        UInventorySlotDataComponent* NewSlot = nullptr;
+        if (SlotPool)
+        {
+            NewSlot = SlotPool->AcquireSlot(GetOwner());
+        }
+        else if ((NewSlot = NewObject<UInventorySlotDataComponent>(GetOwner())) != nullptr)
+        {
+            NewSlot->RegisterComponent();
+        }
+
+        if (NewSlot)
+        {
+            NewSlot->SetOwningBag(this, InventorySlots.Add(NewSlot));
+        }
     }
+    ++SnapshotRevision;
+    OnResized.Broadcast(this);
+    return true;
 }
 
-void UBagComponent::CreateInventorySlots()
+bool UBagComponent::RelocateOverflow(int32 FirstRemovedIndex)
 {
-    // Clear existing slots
+    // Surviving slots of this bag first, then the owner's other bags
+    TArray<UInventorySlotDataComponent*> Targets;
+    Targets.Append(InventorySlots.GetData(), FirstRemovedIndex);
+
+    TArray<UBagComponent*> OtherBags;
+    UInventoryRegistryComponent::GetBagsOf(GetOwner(), OtherBags);
+    for (UBagComponent* OtherBag : OtherBags)
+    {
+        if (OtherBag && OtherBag != this)
+        {
+            Targets.Append(OtherBag->InventorySlots);
+        }
+    }
+
+    // Dry run so a failed shrink leaves every bag untouched
+    TArray<FSimulatedSlot> Simulated;
+    Simulated.Reserve(Targets.Num());
+    for (const auto* Target : Targets)
+    {
+        Simulated.Add({ Target ? Target->GetItemData().ItemID : NAME_None, Target ? Target->GetStackCount() : 0 });
+    }
+
+    for (int32 i = FirstRemovedIndex; i < InventorySlots.Num(); ++i)
+    {
+        const auto* Slot = InventorySlots[i];
+        if (Slot && !Slot->IsEmpty() && SimulateAddItem(Simulated, Slot->GetItemData(), Slot->GetStackCount()) > 0)
+        {
+            return false;
+        }
+    }
+
+    for (int32 i = FirstRemovedIndex; i < InventorySlots.Num(); ++i)
+    {
+        auto* Slot = InventorySlots[i];
+        if (Slot && Slot->GetInstanceHandle().IsValid())
+        {
+            // Unique items keep their instance; the dry run already reserved an empty slot for them
+            auto** EmptyTarget = Targets.FindByPredicate([](const UInventorySlotDataComponent* Target) { return Target && Target->IsEmpty(); });
+            const bool bMoved = EmptyTarget && UInventorySlotDataComponent::TransferItems(*Slot, *EmptyTarget, Slot->GetStackCount());
+            ensureMsgf(bMoved, TEXT("Overflow placement diverged from its dry run"));
+        }
+        else if (Slot && !Slot->IsEmpty())
+        {
+            const int32 Leftover = AddItemToSlots(Targets, Slot->GetItemData(), Slot->GetStackCount());
+            ensureMsgf(Leftover == 0, TEXT("Overflow placement diverged from its dry run"));
+            Slot->ResetSlot();
+        }
+    }
+    return true;
+}
+
+void UBagComponent::ReleaseAllSlots()
+{
+    UInventorySlotPoolSubsystem* SlotPool = GetWorld() ? GetWorld()->GetSubsystem<UInventorySlotPoolSubsystem>() : nullptr;
+
     for (auto* Slot : InventorySlots)
     {
-        if (Slot)
+        if (SlotPool)
+        {
+            SlotPool->ReleaseSlot(Slot);
+        }
+        else if (Slot)
         {
+            Slot->ResetSlot();
             Slot->DestroyComponent();
         }
     }
-    InventorySlots.Empty();
+    InventorySlots.Reset();
+    ++SnapshotRevision;
 
-    // Create new slots based on BagInfo.BagSlots
-    for (int32 i = 0; i < BagInfo.BagSlots; ++i)
+    if (StoreSubsystem)
     {
-        UInventorySlotDataComponent* NewSlot = NewObject<UInventorySlotDataComponent>(GetOwner());
-        if (NewSlot)
+        StoreSubsystem->DestroyInventory(StoreHandle);
+    }
+    StoreHandle = FInventoryEntityHandle();
+}
+
+void UBagComponent::SyncStoreSize(int32 NumSlots)
+{
+    if (!StoreSubsystem)
+    {
+        StoreSubsystem = UInventoryStoreSubsystem::Get(this);
+        if (!StoreSubsystem)
+            return;
+    }
+
+    FInventoryStore& Store = StoreSubsystem->GetStore();
+    if (!Store.IsValid(StoreHandle))
+    {
+        StoreHandle = Store.CreateInventory(NumSlots);
+        UE_CLOG(!StoreHandle.IsValid(), LogTemp, Error, TEXT("%s: no store inventory for %d slots"), *GetName(), NumSlots);
+        return;
+    }
+
+    for (int32 i = NumSlots; i < Store.GetNumSlots(StoreHandle); ++i)
+    {
+        WriteSlot(i, FInventoryStoreSlot());
+    }
+    if (!Store.ResizeInventory(StoreHandle, NumSlots))
+    {
+        UE_LOG(LogTemp, Error, TEXT("%s: store inventory couldn't follow resize to %d slots"), *GetName(), NumSlots);
+    }
+}
+
+FInventoryContainerSnapshotRef UBagComponent::GetSnapshot() const
+{
+    const UItemInstanceSubsystem* Instances = UItemInstanceSubsystem::Get(this);
+    if (CachedSnapshot.IsValid() && CachedSnapshot->IsCurrent(SnapshotRevision, Instances))
+        return CachedSnapshot.ToSharedRef();
+
+    TSharedRef<FInventoryContainerSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FInventoryContainerSnapshot, ESPMode::ThreadSafe>();
+    Snapshot->ContainerName = GetFName();
+    Snapshot->BagItemID = BagInfo.ItemID;
+    Snapshot->Revision = SnapshotRevision;
+
+    // Straight off the store's columns
+    const FInventoryStore* Store = StoreSubsystem ? &StoreSubsystem->GetStore() : nullptr;
+    const TConstArrayView<int32> ItemIndices = Store ? Store->GetItemIndices(StoreHandle) : TConstArrayView<int32>();
+    const TConstArrayView<int32> Counts = Store ? Store->GetCounts(StoreHandle) : TConstArrayView<int32>();
+    const TConstArrayView<FItemInstanceHandle> SlotInstances = Store ? Store->GetInstances(StoreHandle) : TConstArrayView<FItemInstanceHandle>();
+    const UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+
+    Snapshot->Slots.Reserve(Counts.Num());
+    for (int32 i = 0; i < Counts.Num(); ++i)
+    {
+        const FItemRegistryEntry* Entry = Registry && Counts[i] > 0 ? Registry->GetEntry(ItemIndices[i]) : nullptr;
+        if (Entry)
         {
-            NewSlot->RegisterComponent();
-            InventorySlots.Add(NewSlot);
+            Snapshot->AddSlot(Entry->Info.ItemID, Counts[i], SlotInstances[i], Instances);
+        }
+        else
+        {
+            Snapshot->AddSlot(NAME_None, 0, FItemInstanceHandle(), Instances);
+        }
+    }
+
+    CachedSnapshot = Snapshot;
+    return Snapshot;
+}
+
+int32 UBagComponent::AddItemToSlots(TArrayView<UInventorySlotDataComponent* const> Slots, const FS_ItemInfo& Item, int32 Count)
+{
+    const int32 MaxStack = Item.GetMaxStack();
+
+    // Top up existing stacks first
+    for (auto* Slot : Slots)
+    {
+        if (Count > 0 && Slot && !Slot->IsEmpty() && Slot->GetItemData().ItemID == Item.ItemID)
+        {
+            const int32 ToAdd = FMath::Min(MaxStack - Slot->GetStackCount(), Count);
+            if (ToAdd > 0 && Slot->AddItems(Item, ToAdd))
+            {
+                Count -= ToAdd;
+            }
+        }
+    }
+
+    // Then fill empty slots
+    for (auto* Slot : Slots)
+    {
+        if (Count > 0 && Slot && Slot->IsEmpty())
+        {
+            const int32 ToAdd = FMath::Min(MaxStack, Count);
+            if (Slot->AddItems(Item, ToAdd))
+            {
+                Count -= ToAdd;
+            }
         }
     }
-}
\ No newline at end of file
+
+    return Count;
+}
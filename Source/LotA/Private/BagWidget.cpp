@@ -1,35 +1,161 @@
 #include "BagWidget.h"
-#include "Components/UniformGridPanel.h"
+#include "BagComponent.h"
+#include "InventorySlotDataComponent.h"
 #include "InventorySlotWidget.h"
+#include "InventoryWidgetPoolSubsystem.h"
+#include "Components/TextBlock.h"
+#include "Components/UniformGridPanel.h"
 
 UBagWidget::UBagWidget(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, InventoryGrid(nullptr)
+	, TitleText(nullptr)
+	, Columns(4)
+	, FilteredOutOpacity(0.35f)
 {
 }
 
-void UBagWidget::NativeConstruct()
+void UBagWidget::NativeDestruct()
 {
-	Super::NativeConstruct();
+	UnbindFromBag();
+
+	Super::NativeDestruct();
+}
+
+void UBagWidget::BindToBag(UBagComponent* Bag, int32 InColumns)
+{
+	UnbindFromBag();
+
+	Columns = FMath::Max(1, InColumns);
+	BoundBag = Bag;
+	if (!Bag)
+	{
+		return;
+	}
 
-	if (InventoryGrid)
+	if (TitleText)
 	{
-		InitializeBag(4, 4);
+		TitleText->SetText(Bag->GetBagInfo().ItemName);
 	}
+
+	Bag->OnSlotChanged.AddUObject(this, &UBagWidget::HandleSlotChanged);
+	Bag->OnResized.AddUObject(this, &UBagWidget::HandleBagResized);
+	if (UInventoryWidgetPoolSubsystem* Pool = UInventoryWidgetPoolSubsystem::Get(GetOwningPlayer()))
+	{
+		Pool->OnFilterChanged.AddUObject(this, &UBagWidget::HandleFilterChanged);
+	}
+
+	RebuildSlots();
 }
 
-void UBagWidget::InitializeBag(int32 Rows, int32 Columns)
+void UBagWidget::UnbindFromBag()
 {
-	if (InventoryGrid)
+	if (UBagComponent* Bag = BoundBag.Get())
 	{
-		InventoryGrid->ClearChildren();
-		// Add slots to the grid
-		for (int32 Row = 0; Row < Rows; ++Row)
+		Bag->OnSlotChanged.RemoveAll(this);
+		Bag->OnResized.RemoveAll(this);
+	}
+	BoundBag.Reset();
+
+	if (UInventoryWidgetPoolSubsystem* Pool = UInventoryWidgetPoolSubsystem::Get(GetOwningPlayer()))
+	{
+		Pool->OnFilterChanged.RemoveAll(this);
+	}
+
+	ReleaseSlots();
+}
+
+void UBagWidget::RebuildSlots()
+{
+	UBagComponent* Bag = BoundBag.Get();
+	UInventoryWidgetPoolSubsystem* Pool = UInventoryWidgetPoolSubsystem::Get(GetOwningPlayer());
+	if (!Bag || !Pool || !InventoryGrid)
+	{
+		return;
+	}
+
+	const int32 NumSlots = Bag->GetInventorySlots().Num();
+
+	// Hand surplus widgets back when the bag shrank; surviving ones keep their grid cell
+	while (SlotWidgets.Num() > NumSlots)
+	{
+		Pool->ReleaseSlotWidget(SlotWidgets.Pop(EAllowShrinking::No));
+	}
+
+	SlotWidgets.Reserve(NumSlots);
+	while (SlotWidgets.Num() < NumSlots)
+	{
+		const int32 SlotIndex = SlotWidgets.Num();
+		UInventorySlotWidget* SlotWidget = Pool->AcquireSlotWidget(GetOwningPlayer());
+		if (SlotWidget)
 		{
-			for (int32 Column = 0; Column < Columns; ++Column)
-			{
-				// Create and add slots
-				// Implementation similar to InventoryWidget
-			}
+			InventoryGrid->AddChildToUniformGrid(SlotWidget, SlotIndex / Columns, SlotIndex % Columns);
+
+			// Kept on the widget, so the refresh below and later item changes re-test against it
+			SlotWidget->ApplyFilter(Pool->GetActiveFilter(), FilteredOutOpacity);
 		}
+		SlotWidgets.Add(SlotWidget);
+	}
+
+	for (int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex)
+	{
+		RefreshSlot(SlotIndex);
 	}
-}
\ No newline at end of file
+}
+
+void UBagWidget::ReleaseSlots()
+{
+	if (UInventoryWidgetPoolSubsystem* Pool = UInventoryWidgetPoolSubsystem::Get(GetOwningPlayer()))
+	{
+		for (UInventorySlotWidget* SlotWidget : SlotWidgets)
+		{
+			Pool->ReleaseSlotWidget(SlotWidget);
+		}
+	}
+	else if (InventoryGrid)
+	{
+		InventoryGrid->ClearChildren();
+	}
+	SlotWidgets.Reset();
+}
+
+void UBagWidget::RefreshSlot(int32 SlotIndex)
+{
+	UInventorySlotWidget* SlotWidget = SlotWidgets.IsValidIndex(SlotIndex) ? SlotWidgets[SlotIndex] : nullptr;
+	UBagComponent* Bag = BoundBag.Get();
+	if (!SlotWidget || !Bag)
+	{
+		return;
+	}
+
+	SlotWidget->BindToBagSlot(Bag, SlotIndex);
+
+	const TArray<UInventorySlotDataComponent*>& Slots = Bag->GetInventorySlots();
+	const UInventorySlotDataComponent* SlotData = Slots.IsValidIndex(SlotIndex) ? Slots[SlotIndex] : nullptr;
+	if (SlotData && SlotData->GetStackCount() > 0 && !SlotData->GetItemData().ItemID.IsNone())
+	{
+		SlotWidget->SetItemDetails(SlotData->GetItemData(), SlotData->GetStackCount());
+	}
+	else
+	{
+		SlotWidget->ClearSlot();
+	}
+}
+
+void UBagWidget::HandleSlotChanged(UBagComponent* Bag, int32 SlotIndex)
+{
+	RefreshSlot(SlotIndex);
+}
+
+void UBagWidget::HandleBagResized(UBagComponent* Bag)
+{
+	RebuildSlots();
+}
+
+void UBagWidget::HandleFilterChanged(EItemFilterChange Change)
+{
+	if (const UInventoryWidgetPoolSubsystem* Pool = UInventoryWidgetPoolSubsystem::Get(GetOwningPlayer()))
+	{
+		Pool->ApplyFilter(SlotWidgets, Change, FilteredOutOpacity);
+	}
+}
@@ -0,0 +1,90 @@
+// CooldownWheel.cpp
+#include "CooldownWheel.h"
+
+double FCooldownWheel::Start(FName Group, float Duration, double Now)
+{
+	const double ReadyTime = Now + FMath::Max(0.0f, Duration);
+	ReadyTimes.Add(Group, ReadyTime);
+
+	// A restarted group leaves its old entry behind; Tick skips entries whose ready time moved
+	Schedule(Group, ReadyTime, Duration);
+	return ReadyTime;
+}
+
+void FCooldownWheel::Schedule(FName Group, double ReadyTime, double Delay)
+{
+	const int32 Ticks = FMath::Max(1, FMath::CeilToInt(Delay / TickInterval));
+	const int32 Bucket = (CurrentBucket + Ticks) % NumBuckets;
+
+	Buckets[Bucket].Add({ Group, ReadyTime, (Ticks - 1) / NumBuckets });
+	++NumPending;
+}
+
+bool FCooldownWheel::IsActive(FName Group, double Now) const
+{
+	const double* ReadyTime = ReadyTimes.Find(Group);
+	return ReadyTime && *ReadyTime > Now;
+}
+
+float FCooldownWheel::GetRemaining(FName Group, double Now) const
+{
+	const double* ReadyTime = ReadyTimes.Find(Group);
+	return ReadyTime ? static_cast<float>(FMath::Max(0.0, *ReadyTime - Now)) : 0.0f;
+}
+
+void FCooldownWheel::Tick(double Now, TFunctionRef<void(FName)> OnExpired)
+{
+	CurrentBucket = (CurrentBucket + 1) % NumBuckets;
+
+	// Entries are bucketed from when they started, not from where the tick interval stood, so a
+	// bucket can come up to a tick before its entries are due. Those go back in for the time left.
+	TArray<FEntry, TInlineAllocator<4>> NotYetDue;
+
+	TArray<FEntry>& Bucket = Buckets[CurrentBucket];
+	for (int32 i = Bucket.Num() - 1; i >= 0; --i)
+	{
+		FEntry& Entry = Bucket[i];
+		if (Entry.Rounds > 0)
+		{
+			--Entry.Rounds;
+			continue;
+		}
+
+		const FEntry Due = Entry;
+		Bucket.RemoveAtSwap(i, 1, EAllowShrinking::No);
+		--NumPending;
+
+		const double* ReadyTime = ReadyTimes.Find(Due.Group);
+		if (!ReadyTime || *ReadyTime != Due.ReadyTime)
+		{
+			continue;
+		}
+
+		// Allow for the tick landing a hair before the exact ready time
+		if (Due.ReadyTime <= Now + TickInterval * 0.5)
+		{
+			ReadyTimes.Remove(Due.Group);
+			OnExpired(Due.Group);
+		}
+		else
+		{
+			NotYetDue.Add(Due);
+		}
+	}
+
+	for (const FEntry& Entry : NotYetDue)
+	{
+		Schedule(Entry.Group, Entry.ReadyTime, Entry.ReadyTime - Now);
+	}
+}
+
+void FCooldownWheel::Reset()
+{
+	for (TArray<FEntry>& Bucket : Buckets)
+	{
+		Bucket.Reset();
+	}
+	ReadyTimes.Reset();
+	CurrentBucket = 0;
+	NumPending = 0;
+}
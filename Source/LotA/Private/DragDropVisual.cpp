@@ -1,5 +1,6 @@
 // DragDropVisual.cpp
 #include "DragDropVisual.h"
+#include "InventoryIconAtlasSubsystem.h"
 #include "Components/Image.h"
 #include "Components/TextBlock.h"
 
@@ -23,6 +24,13 @@ void UDragDropVisual::NativeConstruct()
 	}
 }
 
+void UDragDropVisual::NativeDestruct()
+{
+	ReleaseIconCell();
+
+	Super::NativeDestruct();
+}
+
 void UDragDropVisual::SetItemIcon(UTexture2D* Icon)
 {
 	if (ItemIcon && Icon)
@@ -33,6 +41,66 @@ void UDragDropVisual::SetItemIcon(UTexture2D* Icon)
 	}
 }
 
+void UDragDropVisual::SetIconBrush(const FSlateBrush& Brush)
+{
+	if (ItemIcon)
+	{
+		ItemIcon->SetBrush(Brush);
+		ItemIcon->SetVisibility(ESlateVisibility::Visible);
+	}
+}
+
+void UDragDropVisual::SetAtlasIcon(int32 RegistryIndex)
+{
+	ReleaseIconCell();
+
+	UInventoryIconAtlasSubsystem* Atlas = UInventoryIconAtlasSubsystem::Get();
+	if (!Atlas)
+	{
+		return;
+	}
+
+	IconAtlasCell = Atlas->AcquireIcon(RegistryIndex, FSimpleDelegate::CreateWeakLambda(this, [this]()
+	{
+		ApplyAtlasBrush();
+	}));
+	ApplyAtlasBrush();
+}
+
+void UDragDropVisual::ApplyAtlasBrush()
+{
+	if (!ItemIcon)
+	{
+		return;
+	}
+
+	FSlateBrush Brush;
+	const UInventoryIconAtlasSubsystem* Atlas = UInventoryIconAtlasSubsystem::Get();
+	if (IconAtlasCell != INDEX_NONE && Atlas && Atlas->GetCellBrush(IconAtlasCell, Brush))
+	{
+		ItemIcon->SetBrush(Brush);
+		ItemIcon->SetVisibility(ESlateVisibility::Visible);
+	}
+	else
+	{
+		ItemIcon->SetVisibility(ESlateVisibility::Hidden);
+	}
+}
+
+void UDragDropVisual::ReleaseIconCell()
+{
+	if (IconAtlasCell == INDEX_NONE)
+	{
+		return;
+	}
+
+	if (UInventoryIconAtlasSubsystem* Atlas = UInventoryIconAtlasSubsystem::Get())
+	{
+		Atlas->ReleaseIcon(IconAtlasCell);
+	}
+	IconAtlasCell = INDEX_NONE;
+}
+
 void UDragDropVisual::SetQuantityText(int32 Quantity)
 {
 	if (QuantityText)
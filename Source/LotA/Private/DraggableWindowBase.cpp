@@ -1,32 +1,142 @@
 #include "DraggableWindowBase.h"
-#include "Blueprint/WidgetBlueprintLibrary.h"
+#include "WindowLayoutSubsystem.h"
+#include "InventoryDragDropOperation.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
+#include "Components/CanvasPanelSlot.h"
 
 UDraggableWindowBase::UDraggableWindowBase(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, TitleBar(nullptr)
+	, SnapGridSize(4.0f)
+	, EdgeSnapDistance(12.0f)
+	, WindowPosition(FVector2D::ZeroVector)
+	, bIsDraggingWindow(false)
+	, DragStartWindowPosition(FVector2D::ZeroVector)
+	, DragStartCursor(FVector2D::ZeroVector)
 {
 }
 
-void UDraggableWindowBase::NativeConstruct()
+void UDraggableWindowBase::SetWindowPosition(FVector2D NewPosition)
 {
-	Super::NativeConstruct();
+	WindowPosition = NewPosition;
+
+	// Inside a canvas the slot is moved; a viewport window moves its viewport slot. Neither touches the children.
+	if (UCanvasPanelSlot* CanvasSlot = Cast<UCanvasPanelSlot>(Slot))
+	{
+		CanvasSlot->SetPosition(NewPosition);
+	}
+	else
+	{
+		SetPositionInViewport(NewPosition, false);
+	}
 }
 
 FReply UDraggableWindowBase::NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
 {
-	if (InMouseEvent.IsMouseButtonDown(EKeys::LeftMouseButton))
+	if (InMouseEvent.GetEffectingButton() != EKeys::LeftMouseButton)
+	{
+		return Super::NativeOnMouseButtonDown(InGeometry, InMouseEvent);
+	}
+
+	if (TitleBar && !TitleBar->GetCachedGeometry().IsUnderLocation(InMouseEvent.GetScreenSpacePosition()))
+	{
+		return Super::NativeOnMouseButtonDown(InGeometry, InMouseEvent);
+	}
+
+	bIsDraggingWindow = true;
+	DragStartWindowPosition = WindowPosition;
+	DragStartCursor = InMouseEvent.GetScreenSpacePosition();
+	return FReply::Handled().CaptureMouse(TakeWidget());
+}
+
+FReply UDraggableWindowBase::NativeOnMouseMove(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
+{
+	if (!bIsDraggingWindow)
+	{
+		return Super::NativeOnMouseMove(InGeometry, InMouseEvent);
+	}
+
+	const float ViewportScale = FMath::Max(UWidgetLayoutLibrary::GetViewportScale(this), KINDA_SMALL_NUMBER);
+	const FVector2D CursorDelta = (InMouseEvent.GetScreenSpacePosition() - DragStartCursor) / ViewportScale;
+	const FVector2D NewPosition = SnapAndClamp(DragStartWindowPosition + CursorDelta);
+	if (!NewPosition.Equals(WindowPosition))
+	{
+		SetWindowPosition(NewPosition);
+	}
+	return FReply::Handled();
+}
+
+FReply UDraggableWindowBase::NativeOnMouseButtonUp(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
+{
+	if (bIsDraggingWindow && InMouseEvent.GetEffectingButton() == EKeys::LeftMouseButton)
+	{
+		EndWindowDrag();
+		return FReply::Handled().ReleaseMouseCapture();
+	}
+	return Super::NativeOnMouseButtonUp(InGeometry, InMouseEvent);
+}
+
+void UDraggableWindowBase::NativeOnMouseCaptureLost(const FCaptureLostEvent& CaptureLostEvent)
+{
+	if (bIsDraggingWindow)
+	{
+		EndWindowDrag();
+	}
+	Super::NativeOnMouseCaptureLost(CaptureLostEvent);
+}
+
+bool UDraggableWindowBase::NativeOnDrop(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation)
+{
+	return Cast<UInventoryDragDropOperation>(InOperation) != nullptr || Super::NativeOnDrop(InGeometry, InDragDropEvent, InOperation);
+}
+
+void UDraggableWindowBase::EndWindowDrag()
+{
+	bIsDraggingWindow = false;
+	if (WindowPosition.Equals(DragStartWindowPosition))
+	{
+		return;
+	}
+
+	if (UWindowLayoutSubsystem* Layout = UWindowLayoutSubsystem::Get(GetOwningPlayer()))
 	{
-		// Use TakeWidget() to pass a TSharedRef<SWidget> to DetectDrag
-		return FReply::Handled().DetectDrag(TakeWidget(), EKeys::LeftMouseButton);
+		Layout->SetWindowPosition(LayoutKey, WindowPosition);
 	}
-	return Super::NativeOnMouseButtonDown(InGeometry, InMouseEvent);
+	OnWindowMoved.Broadcast(this, WindowPosition);
 }
 
-void UDraggableWindowBase::NativeOnDragDetected(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent, UDragDropOperation*& OutOperation)
+FVector2D UDraggableWindowBase::SnapAndClamp(const FVector2D& Position) const
 {
-	UDragDropOperation* DragOperation = UWidgetBlueprintLibrary::CreateDragDropOperation(UDragDropOperation::StaticClass());
-	if (DragOperation)
+	FVector2D Result = Position;
+	if (SnapGridSize > 0.0f)
 	{
-		DragOperation->DefaultDragVisual = this; // Use the current widget as the drag visual
-		OutOperation = DragOperation;
+		Result.X = FMath::GridSnap(Result.X, SnapGridSize);
+		Result.Y = FMath::GridSnap(Result.Y, SnapGridSize);
 	}
+
+	// Cached from the last paint, so no prepass is needed mid-drag
+	const FVector2D WindowSize = GetCachedGeometry().GetLocalSize();
+	const float ViewportScale = FMath::Max(UWidgetLayoutLibrary::GetViewportScale(this), KINDA_SMALL_NUMBER);
+	const FVector2D ViewportSize = UWidgetLayoutLibrary::GetViewportSize(this) / ViewportScale;
+	const FVector2D MaxPosition(FMath::Max(0.0, ViewportSize.X - WindowSize.X), FMath::Max(0.0, ViewportSize.Y - WindowSize.Y));
+
+	if (Result.X < EdgeSnapDistance)
+	{
+		Result.X = 0.0;
+	}
+	else if (Result.X > MaxPosition.X - EdgeSnapDistance)
+	{
+		Result.X = MaxPosition.X;
+	}
+
+	if (Result.Y < EdgeSnapDistance)
+	{
+		Result.Y = 0.0;
+	}
+	else if (Result.Y > MaxPosition.Y - EdgeSnapDistance)
+	{
+		Result.Y = MaxPosition.Y;
+	}
+
+	return FVector2D(FMath::Clamp(Result.X, 0.0, MaxPosition.X), FMath::Clamp(Result.Y, 0.0, MaxPosition.Y));
 }
@@ -0,0 +1,215 @@
+// EncumbranceComponent.cpp
+#include "EncumbranceComponent.h"
+#include "BagComponent.h"
+#include "InventoryRegistryComponent.h"
+#include "GameFramework/Character.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Net/UnrealNetwork.h"
+
+UEncumbranceComponent::UEncumbranceComponent()
+	: EncumbranceTier(0)
+	, CarriedWeight(0.0f)
+	, BaseMaxWalkSpeed(0.0f)
+	, BaseJumpZVelocity(0.0f)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+
+	auto AddTier = [this](float MinWeight, float WalkSpeedScale, float JumpVelocityScale, float StaminaDrainScale)
+	{
+		FEncumbranceTier& Tier = Tiers.AddDefaulted_GetRef();
+		Tier.MinWeight = MinWeight;
+		Tier.WalkSpeedScale = WalkSpeedScale;
+		Tier.JumpVelocityScale = JumpVelocityScale;
+		Tier.StaminaDrainScale = StaminaDrainScale;
+	};
+
+	AddTier(0.0f, 1.0f, 1.0f, 1.0f);
+	AddTier(50.0f, 0.85f, 0.9f, 1.25f);
+	AddTier(100.0f, 0.6f, 0.7f, 1.75f);
+	AddTier(150.0f, 0.3f, 0.4f, 2.5f);
+}
+
+void UEncumbranceComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UEncumbranceComponent, EncumbranceTier);
+}
+
+void UEncumbranceComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	Tiers.Sort([](const FEncumbranceTier& A, const FEncumbranceTier& B) { return A.MinWeight < B.MinWeight; });
+
+	if (const UCharacterMovementComponent* Movement = GetMovementComponent())
+	{
+		BaseMaxWalkSpeed = Movement->MaxWalkSpeed;
+		BaseJumpZVelocity = Movement->JumpZVelocity;
+	}
+
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		if (APawn* Pawn = Cast<APawn>(GetOwner()))
+		{
+			Pawn->ReceiveControllerChangedDelegate.AddUniqueDynamic(this, &UEncumbranceComponent::HandleControllerChanged);
+		}
+
+		// Until the pawn is possessed there's no registry; pick up the bags it spawned with directly
+		TArray<UBagComponent*> Bags;
+		UInventoryRegistryComponent::GetBagsOf(GetOwner(), Bags);
+		for (UBagComponent* Bag : Bags)
+		{
+			TrackBag(Bag);
+		}
+		BindRegistry(UInventoryRegistryComponent::FindForActor(GetOwner()));
+		UpdateTier();
+	}
+
+	ApplyMovementModifiers();
+}
+
+void UEncumbranceComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (APawn* Pawn = Cast<APawn>(GetOwner()))
+	{
+		Pawn->ReceiveControllerChangedDelegate.RemoveAll(this);
+	}
+	BindRegistry(nullptr);
+
+	for (const TPair<TWeakObjectPtr<UBagComponent>, float>& Entry : BagWeights)
+	{
+		if (UBagComponent* Bag = Entry.Key.Get())
+		{
+			Bag->OnWeightChanged.RemoveAll(this);
+		}
+	}
+	BagWeights.Empty();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UEncumbranceComponent::HandleControllerChanged(APawn* Pawn, AController* OldController, AController* NewController)
+{
+	BindRegistry(UInventoryRegistryComponent::FindForActor(NewController));
+}
+
+void UEncumbranceComponent::BindRegistry(UInventoryRegistryComponent* NewRegistry)
+{
+	if (Registry.Get() == NewRegistry)
+	{
+		return;
+	}
+
+	if (UInventoryRegistryComponent* OldRegistry = Registry.Get())
+	{
+		OldRegistry->OnContainerAdded.Remove(BagRegisteredHandle);
+		OldRegistry->OnContainerRemoved.Remove(BagUnregisteredHandle);
+	}
+
+	Registry = NewRegistry;
+	if (NewRegistry)
+	{
+		BagRegisteredHandle = NewRegistry->OnContainerAdded.AddUObject(this, &UEncumbranceComponent::HandleBagRegistered);
+		BagUnregisteredHandle = NewRegistry->OnContainerRemoved.AddUObject(this, &UEncumbranceComponent::HandleBagUnregistered);
+	}
+}
+
+void UEncumbranceComponent::HandleBagRegistered(UBagComponent* Bag)
+{
+	if (Bag && Bag->GetOwner() == GetOwner())
+	{
+		TrackBag(Bag);
+		UpdateTier();
+	}
+}
+
+void UEncumbranceComponent::HandleBagUnregistered(UBagComponent* Bag)
+{
+	float LastWeight = 0.0f;
+	if (Bag && BagWeights.RemoveAndCopyValue(Bag, LastWeight))
+	{
+		Bag->OnWeightChanged.RemoveAll(this);
+		CarriedWeight = FMath::Max(0.0f, CarriedWeight - LastWeight);
+		UpdateTier();
+	}
+}
+
+void UEncumbranceComponent::HandleBagWeightChanged(UBagComponent* Bag, float NewWeight)
+{
+	float* LastWeight = BagWeights.Find(Bag);
+	if (!LastWeight)
+	{
+		return;
+	}
+
+	CarriedWeight = FMath::Max(0.0f, CarriedWeight + NewWeight - *LastWeight);
+	*LastWeight = NewWeight;
+	UpdateTier();
+}
+
+void UEncumbranceComponent::TrackBag(UBagComponent* Bag)
+{
+	if (!Bag || BagWeights.Contains(Bag))
+	{
+		return;
+	}
+
+	const float Weight = Bag->GetTotalWeight();
+	BagWeights.Add(Bag, Weight);
+	CarriedWeight += Weight;
+	Bag->OnWeightChanged.AddUObject(this, &UEncumbranceComponent::HandleBagWeightChanged);
+}
+
+void UEncumbranceComponent::UpdateTier()
+{
+	int32 NewTier = 0;
+	for (int32 TierIndex = Tiers.Num() - 1; TierIndex > 0; --TierIndex)
+	{
+		if (CarriedWeight >= Tiers[TierIndex].MinWeight)
+		{
+			NewTier = TierIndex;
+			break;
+		}
+	}
+
+	if (NewTier != EncumbranceTier)
+	{
+		EncumbranceTier = static_cast<uint8>(FMath::Min(NewTier, 255));
+		ApplyMovementModifiers();
+		OnEncumbranceChanged.Broadcast(EncumbranceTier);
+	}
+}
+
+void UEncumbranceComponent::OnRep_EncumbranceTier()
+{
+	ApplyMovementModifiers();
+	OnEncumbranceChanged.Broadcast(EncumbranceTier);
+}
+
+void UEncumbranceComponent::ApplyMovementModifiers()
+{
+	UCharacterMovementComponent* Movement = GetMovementComponent();
+	if (!Movement || BaseMaxWalkSpeed <= 0.0f)
+	{
+		return;
+	}
+
+	const FEncumbranceTier& Tier = GetActiveTier();
+	Movement->MaxWalkSpeed = BaseMaxWalkSpeed * Tier.WalkSpeedScale;
+	Movement->JumpZVelocity = BaseJumpZVelocity * Tier.JumpVelocityScale;
+}
+
+const FEncumbranceTier& UEncumbranceComponent::GetActiveTier() const
+{
+	static const FEncumbranceTier Unencumbered;
+	return Tiers.IsValidIndex(EncumbranceTier) ? Tiers[EncumbranceTier] : Unencumbered;
+}
+
+UCharacterMovementComponent* UEncumbranceComponent::GetMovementComponent() const
+{
+	const ACharacter* Character = Cast<ACharacter>(GetOwner());
+	return Character ? Character->GetCharacterMovement() : nullptr;
+}
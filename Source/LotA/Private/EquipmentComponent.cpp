@@ -0,0 +1,335 @@
+// EquipmentComponent.cpp
+#include "EquipmentComponent.h"
+#include "BagComponent.h"
+#include "InventoryAuditSubsystem.h"
+#include "ItemInstanceSubsystem.h"
+#include "Net/UnrealNetwork.h"
+
+UEquipmentComponent::UEquipmentComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+	SnapshotRevision = 0;
+
+	EquippedItems.SetNum(NumSlots);
+	EquippedInstances.SetNum(NumSlots);
+	EquippedBags.SetNumZeroed(NumSlots);
+}
+
+void UEquipmentComponent::BeginPlay()
+{
+	Super::BeginPlay();
+}
+
+void UEquipmentComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		for (const FItemInstanceHandle& Instance : EquippedInstances)
+		{
+			ReleaseInstance(Instance);
+		}
+	}
+
+	EquippedInstances.Reset(NumSlots);
+	EquippedInstances.SetNum(NumSlots);
+	EquippedBags.SetNumZeroed(NumSlots);
+	++SnapshotRevision;
+}
+
+void UEquipmentComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME_CONDITION(UEquipmentComponent, EquippedItems, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(UEquipmentComponent, EquippedInstances, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(UEquipmentComponent, StatTotals, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(UEquipmentComponent, EquippedBags, COND_OwnerOnly);
+	DOREPLIFETIME(UEquipmentComponent, EquippedVisuals);
+}
+
+bool UEquipmentComponent::CanEquipInSlot(const FS_ItemInfo& Item, EEquipmentSlot Slot)
+{
+	if (Item.ItemID.IsNone() || Slot == EEquipmentSlot::None || Slot == EEquipmentSlot::MAX)
+	{
+		return false;
+	}
+
+	if (Item.ItemType == EItemType::Bag)
+	{
+		return IsBagSlot(Slot) && Item.BagSlots > 0;
+	}
+
+	return Item.ItemType == EItemType::Equipment && Item.EquipSlot == Slot;
+}
+
+const FS_ItemInfo& UEquipmentComponent::GetEquippedItem(EEquipmentSlot Slot) const
+{
+	static const FS_ItemInfo EmptyItem;
+	const int32 Index = static_cast<int32>(Slot);
+	return EquippedItems.IsValidIndex(Index) ? EquippedItems[Index] : EmptyItem;
+}
+
+FItemInstanceHandle UEquipmentComponent::GetEquippedInstance(EEquipmentSlot Slot) const
+{
+	const int32 Index = static_cast<int32>(Slot);
+	return EquippedInstances.IsValidIndex(Index) ? EquippedInstances[Index] : FItemInstanceHandle();
+}
+
+UBagComponent* UEquipmentComponent::GetBagInSlot(EEquipmentSlot Slot) const
+{
+	const int32 Index = static_cast<int32>(Slot);
+	return EquippedBags.IsValidIndex(Index) ? EquippedBags[Index] : nullptr;
+}
+
+bool UEquipmentComponent::EquipItem(const FS_ItemInfo& Item, EEquipmentSlot Slot, FS_ItemInfo& OutPrevious)
+{
+	OutPrevious = FS_ItemInfo();
+
+	if (GetOwnerRole() != ROLE_Authority || !CanEquipInSlot(Item, Slot))
+	{
+		return false;
+	}
+
+	// Equipping from nowhere brings a new unique item into the game
+	UItemInstanceSubsystem* Instances = UItemInstanceSubsystem::Get(this);
+	const FItemInstanceHandle Instance = Item.bUniqueInstance && Instances ? Instances->CreateInstance(Item) : FItemInstanceHandle();
+
+	FItemInstanceHandle PreviousInstance;
+	if (!EquipInstance(Item, Instance, Slot, OutPrevious, PreviousInstance))
+	{
+		ReleaseInstance(Instance);
+		return false;
+	}
+
+	ReleaseInstance(PreviousInstance);
+	return true;
+}
+
+bool UEquipmentComponent::EquipInstance(const FS_ItemInfo& Item, FItemInstanceHandle Instance, EEquipmentSlot Slot, FS_ItemInfo& OutPrevious, FItemInstanceHandle& OutPreviousInstance)
+{
+	OutPrevious = FS_ItemInfo();
+	OutPreviousInstance = FItemInstanceHandle();
+
+	if (GetOwnerRole() != ROLE_Authority || !CanEquipInSlot(Item, Slot))
+	{
+		return false;
+	}
+
+	const int32 Index = static_cast<int32>(Slot);
+
+	// Swapping bags reuses the equipped bag component and resizes it in place
+	if (UBagComponent* ExistingBag = GetBagInSlot(Slot))
+	{
+		if (!ExistingBag->InitializeBag(Item))
+		{
+			return false;
+		}
+
+		StatTotals -= GetSlotStats(Index);
+		OutPrevious = EquippedItems[Index];
+		OutPreviousInstance = EquippedInstances[Index];
+		EquippedItems[Index] = Item;
+		EquippedInstances[Index] = Instance;
+		StatTotals += GetSlotStats(Index);
+		AuditChange(Slot, OutPrevious.ItemID, -1);
+		AuditChange(Slot, Item.ItemID, 1);
+		++SnapshotRevision;
+		OnEquipmentChanged.Broadcast(this, Slot);
+		return true;
+	}
+
+	if (IsSlotOccupied(Slot) && !UnequipInstance(Slot, OutPrevious, OutPreviousInstance))
+	{
+		return false;
+	}
+
+	EquippedItems[Index] = Item;
+	EquippedInstances[Index] = Instance;
+	StatTotals += GetSlotStats(Index);
+	AuditChange(Slot, Item.ItemID, 1);
+
+	if (IsBagSlot(Slot))
+	{
+		CreateBagForSlot(Slot, Item);
+	}
+
+	SetVisual(Slot, Item.ItemID);
+	++SnapshotRevision;
+	OnEquipmentChanged.Broadcast(this, Slot);
+	return true;
+}
+
+bool UEquipmentComponent::UnequipSlot(EEquipmentSlot Slot, FS_ItemInfo& OutRemoved)
+{
+	FItemInstanceHandle Instance;
+	if (!UnequipInstance(Slot, OutRemoved, Instance))
+	{
+		return false;
+	}
+
+	// Nothing receives the item, so it leaves the game
+	ReleaseInstance(Instance);
+	return true;
+}
+
+bool UEquipmentComponent::UnequipInstance(EEquipmentSlot Slot, FS_ItemInfo& OutRemoved, FItemInstanceHandle& OutInstance)
+{
+	OutRemoved = FS_ItemInfo();
+	OutInstance = FItemInstanceHandle();
+
+	if (GetOwnerRole() != ROLE_Authority || !IsSlotOccupied(Slot))
+	{
+		return false;
+	}
+
+	if (IsBagSlot(Slot) && !DestroyBagForSlot(Slot))
+	{
+		return false;
+	}
+
+	const int32 Index = static_cast<int32>(Slot);
+	StatTotals -= GetSlotStats(Index);
+	OutRemoved = EquippedItems[Index];
+	OutInstance = EquippedInstances[Index];
+	EquippedItems[Index] = FS_ItemInfo();
+	EquippedInstances[Index] = FItemInstanceHandle();
+	AuditChange(Slot, OutRemoved.ItemID, -1);
+
+	SetVisual(Slot, NAME_None);
+	++SnapshotRevision;
+	OnEquipmentChanged.Broadcast(this, Slot);
+	return true;
+}
+
+FInventoryContainerSnapshotRef UEquipmentComponent::GetSnapshot() const
+{
+	const UItemInstanceSubsystem* Instances = UItemInstanceSubsystem::Get(this);
+	if (CachedSnapshot.IsValid() && CachedSnapshot->IsCurrent(SnapshotRevision, Instances))
+	{
+		return CachedSnapshot.ToSharedRef();
+	}
+
+	TSharedRef<FInventoryContainerSnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FInventoryContainerSnapshot, ESPMode::ThreadSafe>();
+	Snapshot->ContainerName = GetFName();
+	Snapshot->Revision = SnapshotRevision;
+	Snapshot->Slots.Reserve(NumSlots);
+	for (int32 Index = 0; Index < NumSlots; ++Index)
+	{
+		const FName ItemID = EquippedItems.IsValidIndex(Index) ? EquippedItems[Index].ItemID : NAME_None;
+		const FItemInstanceHandle Instance = EquippedInstances.IsValidIndex(Index) ? EquippedInstances[Index] : FItemInstanceHandle();
+		Snapshot->AddSlot(ItemID, ItemID.IsNone() ? 0 : 1, Instance, Instances);
+	}
+
+	CachedSnapshot = Snapshot;
+	return Snapshot;
+}
+
+void UEquipmentComponent::CreateBagForSlot(EEquipmentSlot Slot, const FS_ItemInfo& BagItem)
+{
+	UBagComponent* NewBag = NewObject<UBagComponent>(GetOwner());
+	if (NewBag)
+	{
+		NewBag->RegisterComponent();
+		NewBag->InitializeBag(BagItem);
+		EquippedBags[static_cast<int32>(Slot)] = NewBag;
+	}
+}
+
+bool UEquipmentComponent::DestroyBagForSlot(EEquipmentSlot Slot)
+{
+	const int32 Index = static_cast<int32>(Slot);
+	UBagComponent* Bag = EquippedBags[Index];
+	if (!Bag)
+	{
+		return true;
+	}
+
+	// Shrinking to nothing moves the contents into the other bags, and returns the slots to the pool
+	if (!Bag->ResizeBag(0))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Cannot unequip %s: contents don't fit in the other bags"), *Bag->GetName());
+		return false;
+	}
+
+	Bag->CloseBag();
+	Bag->DestroyComponent();
+	EquippedBags[Index] = nullptr;
+	return true;
+}
+
+FItemStats UEquipmentComponent::GetSlotStats(int32 Index) const
+{
+	FItemStats Stats = EquippedItems[Index].Stats;
+
+	// Rolls never change after creation and the instance outlives its slot, so what was added is what gets subtracted
+	const UItemInstanceSubsystem* Instances = UItemInstanceSubsystem::Get(this);
+	const FItemInstanceData* Data = Instances && EquippedInstances.IsValidIndex(Index) ? Instances->FindInstance(EquippedInstances[Index]) : nullptr;
+	if (Data)
+	{
+		Stats += Data->RolledStats;
+	}
+	return Stats;
+}
+
+void UEquipmentComponent::SetVisual(EEquipmentSlot Slot, FName ItemID)
+{
+	// Bags aren't drawn on the character
+	if (IsBagSlot(Slot))
+	{
+		return;
+	}
+
+	const int32 ExistingIndex = EquippedVisuals.IndexOfByPredicate([Slot](const FEquippedVisual& Visual) { return Visual.Slot == Slot; });
+
+	if (ItemID.IsNone())
+	{
+		if (ExistingIndex != INDEX_NONE)
+		{
+			EquippedVisuals.RemoveAt(ExistingIndex);
+		}
+	}
+	else if (ExistingIndex != INDEX_NONE)
+	{
+		EquippedVisuals[ExistingIndex].ItemID = ItemID;
+	}
+	else
+	{
+		FEquippedVisual& Visual = EquippedVisuals.AddDefaulted_GetRef();
+		Visual.Slot = Slot;
+		Visual.ItemID = ItemID;
+	}
+
+	OnEquippedVisualsChanged.Broadcast(this);
+}
+
+void UEquipmentComponent::ReleaseInstance(FItemInstanceHandle Instance)
+{
+	UItemInstanceSubsystem* Instances = Instance.IsValid() ? UItemInstanceSubsystem::Get(this) : nullptr;
+	if (Instances)
+	{
+		Instances->ReleaseInstance(Instance);
+	}
+}
+
+void UEquipmentComponent::AuditChange(EEquipmentSlot Slot, FName ItemID, int32 Delta)
+{
+	if (UInventoryAuditSubsystem* Audit = UInventoryAuditSubsystem::Get())
+	{
+		Audit->RecordChange(this, static_cast<int32>(Slot), ItemID, Delta);
+	}
+}
+
+void UEquipmentComponent::OnRep_EquippedItems()
+{
+	// The owning client only gets whole-array updates, so let listeners refresh every slot
+	++SnapshotRevision;
+	OnEquipmentChanged.Broadcast(this, EEquipmentSlot::None);
+}
+
+void UEquipmentComponent::OnRep_EquippedVisuals()
+{
+	OnEquippedVisualsChanged.Broadcast(this);
+}
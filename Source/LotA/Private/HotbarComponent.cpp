@@ -0,0 +1,188 @@
+// HotbarComponent.cpp
+#include "HotbarComponent.h"
+#include "BagComponent.h"
+#include "InventoryRegistryComponent.h"
+#include "ItemUseComponent.h"
+
+UHotbarComponent::UHotbarComponent()
+	: NumSlots(10)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+void UHotbarComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	SlotItems.SetNum(NumSlots);
+
+	if (UInventoryRegistryComponent* InRegistry = UInventoryRegistryComponent::FindForActor(GetOwner()))
+	{
+		Registry = InRegistry;
+		BagRegisteredHandle = InRegistry->OnContainerAdded.AddUObject(this, &UHotbarComponent::HandleBagRegistered);
+		BagUnregisteredHandle = InRegistry->OnContainerRemoved.AddUObject(this, &UHotbarComponent::HandleBagUnregistered);
+
+		for (UBagComponent* Bag : InRegistry->GetBags())
+		{
+			TrackBag(Bag);
+		}
+	}
+}
+
+void UHotbarComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UInventoryRegistryComponent* InRegistry = Registry.Get())
+	{
+		InRegistry->OnContainerAdded.Remove(BagRegisteredHandle);
+		InRegistry->OnContainerRemoved.Remove(BagUnregisteredHandle);
+	}
+	Registry.Reset();
+
+	UntrackAllBags();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UHotbarComponent::BindItem(int32 SlotIndex, FName ItemID)
+{
+	if (!SlotItems.IsValidIndex(SlotIndex) || SlotItems[SlotIndex] == ItemID)
+	{
+		return;
+	}
+
+	const FName PreviousItemID = SlotItems[SlotIndex];
+	SlotItems[SlotIndex] = ItemID;
+
+	// Drop the total once nothing shows the old item
+	if (!PreviousItemID.IsNone() && !SlotItems.Contains(PreviousItemID))
+	{
+		BoundTotals.Remove(PreviousItemID);
+	}
+
+	// A newly bound item is summed once; after that only deltas are applied
+	if (!ItemID.IsNone() && !BoundTotals.Contains(ItemID))
+	{
+		int32 Total = 0;
+		for (const TWeakObjectPtr<UBagComponent>& Bag : TrackedBags)
+		{
+			if (Bag.IsValid())
+			{
+				Total += Bag->GetItemCount(ItemID);
+			}
+		}
+		BoundTotals.Add(ItemID, Total);
+	}
+
+	OnSlotChanged.Broadcast(SlotIndex);
+}
+
+void UHotbarComponent::ActivateSlot(int32 SlotIndex)
+{
+	const FName ItemID = GetSlotItemID(SlotIndex);
+	if (ItemID.IsNone() || GetSlotCount(SlotIndex) <= 0)
+	{
+		return;
+	}
+
+	if (UItemUseComponent* ItemUse = GetOwner()->FindComponentByClass<UItemUseComponent>())
+	{
+		ItemUse->UseItemByID(ItemID);
+	}
+}
+
+int32 UHotbarComponent::GetSlotCount(int32 SlotIndex) const
+{
+	const int32* Total = BoundTotals.Find(GetSlotItemID(SlotIndex));
+	return Total ? *Total : 0;
+}
+
+void UHotbarComponent::HandleBagRegistered(UBagComponent* Bag)
+{
+	TrackBag(Bag);
+}
+
+void UHotbarComponent::HandleBagUnregistered(UBagComponent* Bag)
+{
+	UntrackBag(Bag);
+}
+
+void UHotbarComponent::HandleItemCountChanged(UBagComponent* Bag, FName ItemID, int32 Delta)
+{
+	ApplyDelta(ItemID, Delta);
+}
+
+void UHotbarComponent::TrackBag(UBagComponent* Bag)
+{
+	if (!Bag || TrackedBags.Contains(Bag))
+	{
+		return;
+	}
+
+	TrackedBags.Add(Bag);
+	Bag->OnItemCountChanged.AddUObject(this, &UHotbarComponent::HandleItemCountChanged);
+
+	// Fold in whatever the bag already holds
+	TArray<FName, TInlineAllocator<16>> BoundItems;
+	BoundTotals.GetKeys(BoundItems);
+	for (const FName ItemID : BoundItems)
+	{
+		ApplyDelta(ItemID, Bag->GetItemCount(ItemID));
+	}
+}
+
+void UHotbarComponent::UntrackBag(UBagComponent* Bag)
+{
+	if (!Bag || TrackedBags.Remove(Bag) == 0)
+	{
+		return;
+	}
+
+	Bag->OnItemCountChanged.RemoveAll(this);
+
+	TArray<FName, TInlineAllocator<16>> BoundItems;
+	BoundTotals.GetKeys(BoundItems);
+	for (const FName ItemID : BoundItems)
+	{
+		ApplyDelta(ItemID, -Bag->GetItemCount(ItemID));
+	}
+}
+
+void UHotbarComponent::UntrackAllBags()
+{
+	while (TrackedBags.Num() > 0)
+	{
+		const TWeakObjectPtr<UBagComponent> Bag = TrackedBags.Last();
+		if (Bag.IsValid())
+		{
+			UntrackBag(Bag.Get());
+		}
+		else
+		{
+			TrackedBags.Pop();
+		}
+	}
+
+	for (TPair<FName, int32>& Total : BoundTotals)
+	{
+		Total.Value = 0;
+	}
+}
+
+void UHotbarComponent::ApplyDelta(FName ItemID, int32 Delta)
+{
+	int32* Total = BoundTotals.Find(ItemID);
+	if (!Total || Delta == 0)
+	{
+		return;
+	}
+
+	*Total = FMath::Max(0, *Total + Delta);
+
+	for (int32 SlotIndex = 0; SlotIndex < SlotItems.Num(); ++SlotIndex)
+	{
+		if (SlotItems[SlotIndex] == ItemID)
+		{
+			OnSlotChanged.Broadcast(SlotIndex);
+		}
+	}
+}
@@ -0,0 +1,80 @@
+// HotbarWidget.cpp
+#include "HotbarWidget.h"
+#include "HotbarComponent.h"
+#include "InventorySlotWidget.h"
+#include "ItemRegistrySubsystem.h"
+#include "Components/PanelWidget.h"
+
+UHotbarWidget::UHotbarWidget(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+void UHotbarWidget::InitializeHotbar(UHotbarComponent* InHotbar)
+{
+	if (Hotbar.IsValid())
+	{
+		Hotbar->OnSlotChanged.RemoveAll(this);
+	}
+
+	Hotbar = InHotbar;
+	if (!InHotbar || !ButtonContainer)
+	{
+		return;
+	}
+
+	// Same visuals as the bag slots
+	const FSoftClassPath WidgetClassPath(TEXT("/Game/Inventory/Widgets/WBP_InventorySlot.WBP_InventorySlot_C"));
+	UClass* SlotWidgetClass = WidgetClassPath.TryLoadClass<UInventorySlotWidget>();
+	if (!SlotWidgetClass)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to load WBP_InventorySlot class for hotbar"));
+		return;
+	}
+
+	ButtonContainer->ClearChildren();
+	Buttons.Reset(InHotbar->GetNumSlots());
+
+	for (int32 SlotIndex = 0; SlotIndex < InHotbar->GetNumSlots(); ++SlotIndex)
+	{
+		UInventorySlotWidget* Button = CreateWidget<UInventorySlotWidget>(this, SlotWidgetClass);
+		if (Button)
+		{
+			ButtonContainer->AddChild(Button);
+		}
+		Buttons.Add(Button);
+		RefreshButton(SlotIndex);
+	}
+
+	InHotbar->OnSlotChanged.AddUObject(this, &UHotbarWidget::RefreshButton);
+}
+
+void UHotbarWidget::NativeDestruct()
+{
+	if (Hotbar.IsValid())
+	{
+		Hotbar->OnSlotChanged.RemoveAll(this);
+	}
+
+	Super::NativeDestruct();
+}
+
+void UHotbarWidget::RefreshButton(int32 SlotIndex)
+{
+	UInventorySlotWidget* Button = Buttons.IsValidIndex(SlotIndex) ? Buttons[SlotIndex] : nullptr;
+	if (!Button || !Hotbar.IsValid())
+	{
+		return;
+	}
+
+	UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+	const FItemRegistryEntry* Entry = Registry ? Registry->FindEntry(Hotbar->GetSlotItemID(SlotIndex)) : nullptr;
+	if (Entry)
+	{
+		Button->SetItemDetails(Entry->Info, Hotbar->GetSlotCount(SlotIndex));
+	}
+	else
+	{
+		Button->ClearSlot();
+	}
+}
@@ -0,0 +1,72 @@
+// InventoryAudit.cpp
+#include "InventoryAudit.h"
+#include "Hash/CityHash.h"
+
+namespace
+{
+	thread_local EInventoryAuditOp CurrentAuditOp = EInventoryAuditOp::Unknown;
+}
+
+void FInventoryAuditRecord::SetItemID(FName InItemID)
+{
+	// Item IDs are ASCII identifiers, so a narrowing copy avoids building an FString per record
+	TStringBuilder<64> Builder;
+	if (!InItemID.IsNone())
+	{
+		InItemID.AppendString(Builder);
+	}
+
+	const int32 Length = FMath::Min(Builder.Len(), static_cast<int32>(UE_ARRAY_COUNT(ItemID)) - 1);
+	for (int32 Index = 0; Index < Length; ++Index)
+	{
+		const TCHAR Char = Builder.GetData()[Index];
+		ItemID[Index] = Char < 128 ? static_cast<char>(Char) : '?';
+	}
+	ItemID[Length] = '\0';
+}
+
+uint64 InventoryAudit::HashPlayerId(FStringView UniqueNetId)
+{
+	const FTCHARToUTF8 Utf8(UniqueNetId.GetData(), UniqueNetId.Len());
+	return CityHash64(Utf8.Get(), Utf8.Length());
+}
+
+uint32 InventoryAudit::HashContainerName(FStringView ContainerPath)
+{
+	const FTCHARToUTF8 Utf8(ContainerPath.GetData(), ContainerPath.Len());
+	return CityHash32(Utf8.Get(), Utf8.Length());
+}
+
+const TCHAR* InventoryAudit::OpToString(EInventoryAuditOp Op)
+{
+	switch (Op)
+	{
+	case EInventoryAuditOp::Create:    return TEXT("Create");
+	case EInventoryAuditOp::Destroy:   return TEXT("Destroy");
+	case EInventoryAuditOp::Transfer:  return TEXT("Transfer");
+	case EInventoryAuditOp::Consume:   return TEXT("Consume");
+	case EInventoryAuditOp::Equip:     return TEXT("Equip");
+	case EInventoryAuditOp::Unequip:   return TEXT("Unequip");
+	case EInventoryAuditOp::WorldDrop: return TEXT("WorldDrop");
+	case EInventoryAuditOp::Trade:     return TEXT("Trade");
+	case EInventoryAuditOp::Pickup:    return TEXT("Pickup");
+	case EInventoryAuditOp::Gap:       return TEXT("Gap");
+	default:                           return TEXT("Unknown");
+	}
+}
+
+EInventoryAuditOp InventoryAudit::GetCurrentOp()
+{
+	return CurrentAuditOp;
+}
+
+FInventoryAuditScope::FInventoryAuditScope(EInventoryAuditOp Op)
+	: PreviousOp(CurrentAuditOp)
+{
+	CurrentAuditOp = Op;
+}
+
+FInventoryAuditScope::~FInventoryAuditScope()
+{
+	CurrentAuditOp = PreviousOp;
+}
@@ -0,0 +1,127 @@
+// InventoryAuditQueryCommandlet.cpp
+#include "InventoryAuditQueryCommandlet.h"
+#include "InventoryAudit.h"
+#include "InventoryAuditSubsystem.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UInventoryAuditQueryCommandlet::UInventoryAuditQueryCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UInventoryAuditQueryCommandlet::Main(const FString& Params)
+{
+	FString Directory = UInventoryAuditSubsystem::GetAuditDirectory();
+	FParse::Value(*Params, TEXT("Dir="), Directory);
+
+	uint64 PlayerHash = 0;
+	FString PlayerFilter;
+	FString PlayerHashString;
+	if (FParse::Value(*Params, TEXT("Player="), PlayerFilter))
+	{
+		PlayerHash = InventoryAudit::HashPlayerId(PlayerFilter);
+	}
+	else if (FParse::Value(*Params, TEXT("PlayerHash="), PlayerHashString))
+	{
+		PlayerHash = FCString::Strtoui64(*PlayerHashString, nullptr, 16);
+	}
+
+	FString ItemFilter;
+	FParse::Value(*Params, TEXT("Item="), ItemFilter);
+	FInventoryAuditRecord ItemFilterRecord;
+	ItemFilterRecord.SetItemID(ItemFilter.IsEmpty() ? NAME_None : FName(*ItemFilter));
+
+	FString OutPath;
+	FParse::Value(*Params, TEXT("Out="), OutPath);
+
+	TArray<FString> Files;
+	IFileManager::Get().FindFiles(Files, *FPaths::Combine(Directory, TEXT("InventoryAudit_*.bin")), true, false);
+	Files.Sort();
+
+	// File names embed their creation time, so name order is time order
+	FString Csv = TEXT("Timestamp,PlayerHash,Op,ItemID,Count,ContainerHash,Slot\n");
+	TMap<FString, int64> NetCounts;
+	int64 Matched = 0;
+	int64 Gaps = 0;
+
+	TArray<FInventoryAuditRecord> Chunk;
+	Chunk.SetNumUninitialized(16384);
+
+	for (const FString& FileName : Files)
+	{
+		TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*FPaths::Combine(Directory, FileName)));
+		if (!Reader)
+		{
+			continue;
+		}
+
+		FInventoryAuditFileHeader Header;
+		Reader->Serialize(&Header, sizeof(Header));
+		if (Header.Magic != FInventoryAuditFileHeader::ExpectedMagic || Header.RecordSize != sizeof(FInventoryAuditRecord))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Skipping %s: not an audit file of this version"), *FileName);
+			continue;
+		}
+
+		while (!Reader->AtEnd())
+		{
+			// A file cut short by a crash ends in a partial record, which is ignored
+			const int64 Remaining = (Reader->TotalSize() - Reader->Tell()) / sizeof(FInventoryAuditRecord);
+			const int32 ToRead = static_cast<int32>(FMath::Min<int64>(Remaining, Chunk.Num()));
+			if (ToRead <= 0)
+			{
+				break;
+			}
+			Reader->Serialize(Chunk.GetData(), ToRead * sizeof(FInventoryAuditRecord));
+
+			for (int32 Index = 0; Index < ToRead; ++Index)
+			{
+				const FInventoryAuditRecord& Record = Chunk[Index];
+				if (Record.Op == static_cast<uint8>(EInventoryAuditOp::Gap))
+				{
+					Gaps += Record.Count;
+					continue;
+				}
+
+				if ((PlayerHash != 0 && Record.PlayerHash != PlayerHash) ||
+					(!ItemFilter.IsEmpty() && FCStringAnsi::Strcmp(Record.ItemID, ItemFilterRecord.ItemID) != 0))
+				{
+					continue;
+				}
+
+				++Matched;
+				const FString ItemID = Record.GetItemID();
+				NetCounts.FindOrAdd(ItemID) += Record.Count;
+				Csv += FString::Printf(TEXT("%s,%016llx,%s,%s,%d,%08x,%d\n"),
+					*FDateTime(Record.Timestamp).ToIso8601(), Record.PlayerHash, InventoryAudit::OpToString(static_cast<EInventoryAuditOp>(Record.Op)),
+					*ItemID, Record.Count, Record.ContainerHash, Record.SlotIndex);
+			}
+		}
+	}
+
+	if (OutPath.IsEmpty())
+	{
+		UE_LOG(LogTemp, Display, TEXT("%s"), *Csv);
+	}
+	else if (!FFileHelper::SaveStringToFile(Csv, *OutPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not write %s"), *OutPath);
+		return 1;
+	}
+
+	for (const TPair<FString, int64>& Net : NetCounts)
+	{
+		UE_LOG(LogTemp, Display, TEXT("Net %s: %lld"), *Net.Key, Net.Value);
+	}
+	UE_LOG(LogTemp, Display, TEXT("%lld matching records in %d files"), Matched, Files.Num());
+	if (Gaps > 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%lld records were lost to a full buffer while these files were written"), Gaps);
+	}
+	return 0;
+}
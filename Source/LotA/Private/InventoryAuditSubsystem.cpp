@@ -0,0 +1,331 @@
+// InventoryAuditSubsystem.cpp
+#include "InventoryAuditSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/FileManager.h"
+#include "HAL/Event.h"
+#include "HAL/Runnable.h"
+#include "HAL/RunnableThread.h"
+#include "Misc/Paths.h"
+
+// Drains the ring buffer to disk on its own thread so the game thread never touches a file
+class FInventoryAuditWriter : public FRunnable
+{
+public:
+	FInventoryAuditWriter(TAuditRingBuffer<FInventoryAuditRecord>& InBuffer, std::atomic<uint32>& InDroppedRecords, int64 InMaxFileBytes)
+		: Buffer(InBuffer)
+		, DroppedRecords(InDroppedRecords)
+		, MaxFileBytes(InMaxFileBytes)
+		, WakeEvent(FPlatformProcess::GetSynchEventFromPool(false))
+		, bStopping(false)
+	{
+		Batch.Reserve(BatchSize);
+		Thread = FRunnableThread::Create(this, TEXT("InventoryAuditWriter"), 0, TPri_BelowNormal);
+	}
+
+	virtual ~FInventoryAuditWriter() override
+	{
+		if (Thread)
+		{
+			Thread->Kill(true);
+			delete Thread;
+		}
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	}
+
+	void Wake()
+	{
+		WakeEvent->Trigger();
+	}
+
+	virtual uint32 Run() override
+	{
+		while (!bStopping.load(std::memory_order_relaxed))
+		{
+			WakeEvent->Wait(FlushIntervalMs);
+			Drain();
+		}
+
+		// Whatever was queued before shutdown still goes out
+		Drain();
+		File.Reset();
+		return 0;
+	}
+
+	virtual void Stop() override
+	{
+		bStopping.store(true, std::memory_order_relaxed);
+		WakeEvent->Trigger();
+	}
+
+private:
+	static constexpr uint32 FlushIntervalMs = 1000;
+	static constexpr int32 BatchSize = 4096;
+
+	TAuditRingBuffer<FInventoryAuditRecord>& Buffer;
+	std::atomic<uint32>& DroppedRecords;
+	const int64 MaxFileBytes;
+
+	FEvent* WakeEvent;
+	FRunnableThread* Thread = nullptr;
+	std::atomic<bool> bStopping;
+
+	TArray<FInventoryAuditRecord> Batch;
+	TUniquePtr<FArchive> File;
+	int32 FileDay = -1;
+	bool bReportedOpenFailure = false;
+
+	void Drain()
+	{
+		for (;;)
+		{
+			Batch.Reset();
+
+			const uint32 Dropped = DroppedRecords.exchange(0, std::memory_order_relaxed);
+			if (Dropped > 0)
+			{
+				FInventoryAuditRecord& GapRecord = Batch.AddDefaulted_GetRef();
+				GapRecord.Timestamp = FDateTime::UtcNow().GetTicks();
+				GapRecord.Op = static_cast<uint8>(EInventoryAuditOp::Gap);
+				GapRecord.Count = static_cast<int32>(FMath::Min<uint32>(Dropped, MAX_int32));
+			}
+
+			FInventoryAuditRecord Record;
+			while (Batch.Num() < BatchSize && Buffer.Pop(Record))
+			{
+				Batch.Add(Record);
+			}
+
+			if (Batch.Num() == 0)
+			{
+				return;
+			}
+
+			// Without a file, try again on the next wake rather than spinning on the open
+			if (!WriteBatch() || Batch.Num() < BatchSize)
+			{
+				if (File)
+				{
+					File->Flush();
+				}
+				return;
+			}
+		}
+	}
+
+	bool WriteBatch()
+	{
+		const FDateTime Now = FDateTime::UtcNow();
+		if (!File || File->TotalSize() >= MaxFileBytes || Now.GetDay() != FileDay)
+		{
+			OpenNewFile(Now);
+		}
+
+		if (!File)
+		{
+			// Carried into the next file's gap record, like records lost to a full buffer
+			uint32 Lost = 0;
+			for (const FInventoryAuditRecord& Record : Batch)
+			{
+				Lost += Record.Op == static_cast<uint8>(EInventoryAuditOp::Gap) ? static_cast<uint32>(Record.Count) : 1;
+			}
+			DroppedRecords.fetch_add(Lost, std::memory_order_relaxed);
+			return false;
+		}
+
+		File->Serialize(Batch.GetData(), Batch.Num() * sizeof(FInventoryAuditRecord));
+		return true;
+	}
+
+	void OpenNewFile(const FDateTime& Now)
+	{
+		File.Reset();
+		FileDay = Now.GetDay();
+
+		const FString FileName = FString::Printf(TEXT("InventoryAudit_%s.bin"), *Now.ToString(TEXT("%Y%m%d_%H%M%S_%s")));
+		File.Reset(IFileManager::Get().CreateFileWriter(*FPaths::Combine(UInventoryAuditSubsystem::GetAuditDirectory(), FileName), FILEWRITE_AllowRead));
+		if (!File)
+		{
+			UE_CLOG(!bReportedOpenFailure, LogTemp, Error, TEXT("Inventory audit could not open %s; records are being counted as lost"), *FileName);
+			bReportedOpenFailure = true;
+			return;
+		}
+		bReportedOpenFailure = false;
+
+		FInventoryAuditFileHeader Header;
+		File->Serialize(&Header, sizeof(Header));
+	}
+};
+
+UInventoryAuditSubsystem::UInventoryAuditSubsystem()
+	: bEnabled(true)
+	, BufferCapacity(65536)
+	, MaxFileSizeMB(64)
+	, DroppedRecords(0)
+{
+}
+
+UInventoryAuditSubsystem::~UInventoryAuditSubsystem() = default;
+
+UInventoryAuditSubsystem* UInventoryAuditSubsystem::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<UInventoryAuditSubsystem>() : nullptr;
+}
+
+bool UInventoryAuditSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Commandlets (the fuzzer in particular) would flood the log with synthetic items, and client-only
+	// builds never have an authoritative inventory to audit
+	return !IsRunningCommandlet() && !IsRunningClientOnly() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UInventoryAuditSubsystem::StartWriter()
+{
+	bStartAttempted = true;
+	if (!bEnabled || !FPlatformProcess::SupportsMultithreading())
+	{
+		return;
+	}
+
+	IFileManager::Get().MakeDirectory(*GetAuditDirectory(), true);
+
+	Buffer = MakeUnique<TAuditRingBuffer<FInventoryAuditRecord>>(FMath::RoundUpToPowerOfTwo(FMath::Max(1024, BufferCapacity)));
+	Writer = MakeUnique<FInventoryAuditWriter>(*Buffer, DroppedRecords, static_cast<int64>(FMath::Max(1, MaxFileSizeMB)) * 1024 * 1024);
+}
+
+void UInventoryAuditSubsystem::Deinitialize()
+{
+	// The writer drains the buffer before its thread exits
+	Writer.Reset();
+	Buffer.Reset();
+	bStartAttempted = false;
+	PlayerHashes.Empty();
+	ContainerHashes.Empty();
+
+	Super::Deinitialize();
+}
+
+void UInventoryAuditSubsystem::RecordChange(const UActorComponent* Container, int32 SlotIndex, FName ItemID, int32 Delta)
+{
+	if (!Container || ItemID.IsNone() || Delta == 0)
+	{
+		return;
+	}
+
+	// A client only sees replicated copies of changes the server has already audited
+	const UWorld* World = Container->GetWorld();
+	if (!World || World->GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	// Started on the first authoritative change, so a game process that only ever joins servers writes no files
+	if (!bStartAttempted)
+	{
+		StartWriter();
+	}
+	if (!Buffer)
+	{
+		return;
+	}
+
+	FInventoryAuditRecord NewRecord;
+	NewRecord.Timestamp = FDateTime::UtcNow().GetTicks();
+	NewRecord.PlayerHash = GetPlayerHash(Container);
+	NewRecord.ContainerHash = GetContainerHash(Container);
+	NewRecord.Count = Delta;
+	NewRecord.SlotIndex = static_cast<int16>(FMath::Clamp(SlotIndex, -1, static_cast<int32>(MAX_int16)));
+	NewRecord.Op = static_cast<uint8>(InventoryAudit::GetCurrentOp());
+	NewRecord.SetItemID(ItemID);
+	Record(NewRecord);
+}
+
+void UInventoryAuditSubsystem::Record(const FInventoryAuditRecord& InRecord)
+{
+	if (!Buffer)
+	{
+		return;
+	}
+
+	if (!Buffer->Push(InRecord))
+	{
+		DroppedRecords.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	if (Buffer->ApproximateNum() >= Buffer->Capacity() / 2)
+	{
+		Writer->Wake();
+	}
+}
+
+FString UInventoryAuditSubsystem::GetAuditDirectory()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Audit"));
+}
+
+uint64 UInventoryAuditSubsystem::GetPlayerHash(const UActorComponent* Container)
+{
+	const AActor* Owner = Container->GetOwner();
+	const APlayerState* PlayerState = nullptr;
+	if (const APawn* Pawn = Cast<APawn>(Owner))
+	{
+		PlayerState = Pawn->GetPlayerState();
+	}
+	else if (const AController* Controller = Cast<AController>(Owner))
+	{
+		PlayerState = Controller->PlayerState;
+	}
+	else
+	{
+		PlayerState = Cast<APlayerState>(Owner);
+	}
+
+	if (!PlayerState)
+	{
+		return 0;
+	}
+
+	if (const uint64* Cached = PlayerHashes.Find(PlayerState))
+	{
+		return *Cached;
+	}
+
+	// Unique net IDs can arrive after the player state; don't cache a hash of the display name
+	const FUniqueNetIdRepl& UniqueId = PlayerState->GetUniqueId();
+	if (!UniqueId.IsValid())
+	{
+		return InventoryAudit::HashPlayerId(PlayerState->GetPlayerName());
+	}
+
+	const uint64 Hash = InventoryAudit::HashPlayerId(UniqueId.ToString());
+	PlayerHashes.Add(PlayerState, Hash);
+	return Hash;
+}
+
+uint32 UInventoryAuditSubsystem::GetContainerHash(const UActorComponent* Container)
+{
+	if (const uint32* Cached = ContainerHashes.Find(Container))
+	{
+		return *Cached;
+	}
+
+	// Bags come and go with equipment swaps; drop the ones that are gone before the map grows
+	if (ContainerHashes.Num() >= 4096)
+	{
+		for (auto It = ContainerHashes.CreateIterator(); It; ++It)
+		{
+			if (!It.Key().IsValid())
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	// The component name alone is the same in every player's bag; its path includes the owning actor
+	const uint32 Hash = InventoryAudit::HashContainerName(Container->GetPathName());
+	ContainerHashes.Add(Container, Hash);
+	return Hash;
+}
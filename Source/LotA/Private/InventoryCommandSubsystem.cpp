@@ -0,0 +1,247 @@
+// InventoryCommandSubsystem.cpp
+#include "InventoryCommandSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Tasks/Task.h"
+
+UInventoryCommandSubsystem* UInventoryCommandSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UInventoryCommandSubsystem>() : nullptr;
+}
+
+void UInventoryCommandSubsystem::Deinitialize()
+{
+	Queues.Empty();
+
+	Super::Deinitialize();
+}
+
+TStatId UInventoryCommandSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UInventoryCommandSubsystem, STATGROUP_Tickables);
+}
+
+UInventoryCommandSubsystem::FPlayerQueue& UInventoryCommandSubsystem::FindOrAddQueue(APlayerController* Player)
+{
+	TUniquePtr<FPlayerQueue>& Queue = Queues.FindOrAdd(GetPlayerKey(Player));
+	if (!Queue)
+	{
+		Queue = MakeUnique<FPlayerQueue>();
+		Queue->Player = Player;
+	}
+	return *Queue;
+}
+
+void UInventoryCommandSubsystem::Enqueue(APlayerController* Player, TUniquePtr<FInventoryCommand> Command)
+{
+	Enqueue(MakeArrayView(&Player, 1), MoveTemp(Command));
+}
+
+void UInventoryCommandSubsystem::Enqueue(TConstArrayView<APlayerController*> Players, TUniquePtr<FInventoryCommand> Command)
+{
+	if (!Command || Players.Num() == 0 || Players.Contains(nullptr))
+	{
+		return;
+	}
+
+	TSharedPtr<FQueuedCommand> Queued = MakeShared<FQueuedCommand>();
+	Queued->Command = MoveTemp(Command);
+	Queued->Sequence = NextSequence++;
+	for (APlayerController* Player : Players)
+	{
+		Queued->Players.AddUnique(GetPlayerKey(Player));
+		FindOrAddQueue(Player).Pending.AddUnique(Queued);
+	}
+	Queued->Players.Sort();
+}
+
+void UInventoryCommandSubsystem::EnqueueApply(APlayerController* Player, TFunction<void()>&& Apply)
+{
+	Enqueue(Player, MakeUnique<FInventoryApplyCommand>(MoveTemp(Apply)));
+}
+
+void UInventoryCommandSubsystem::DiscardQueue(const APlayerController* Player)
+{
+	RemoveQueue(GetPlayerKey(Player));
+}
+
+int32 UInventoryCommandSubsystem::GetNumQueued(const APlayerController* Player) const
+{
+	const TUniquePtr<FPlayerQueue>* Queue = Queues.Find(GetPlayerKey(Player));
+	return Queue ? (*Queue)->Pending.Num() : 0;
+}
+
+void UInventoryCommandSubsystem::RemoveQueue(FPlayerKey Key)
+{
+	TUniquePtr<FPlayerQueue> Queue;
+	if (!Queues.RemoveAndCopyValue(Key, Queue))
+	{
+		return;
+	}
+
+	// A shared command can't run without all of its players
+	for (const TSharedPtr<FQueuedCommand>& Queued : Queue->Pending)
+	{
+		for (const FPlayerKey OtherKey : Queued->Players)
+		{
+			if (const TUniquePtr<FPlayerQueue>* Other = Queues.Find(OtherKey))
+			{
+				(*Other)->Pending.Remove(Queued);
+			}
+		}
+	}
+
+	// After the queues are consistent again, since a discard may queue something new
+	for (const TSharedPtr<FQueuedCommand>& Queued : Queue->Pending)
+	{
+		Queued->Command->Discard();
+	}
+}
+
+bool UInventoryCommandSubsystem::IsAtFrontOfAll(const FQueuedCommand& Queued) const
+{
+	for (const FPlayerKey Key : Queued.Players)
+	{
+		const TUniquePtr<FPlayerQueue>* Queue = Queues.Find(Key);
+		if (!Queue || (*Queue)->Pending.Num() == 0 || (*Queue)->Pending[0].Get() != &Queued)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void UInventoryCommandSubsystem::GatherWork(TArray<FWorkUnit>& OutUnits)
+{
+	int32 CommitBudget = MaxCommitsPerTick;
+	for (const TPair<FPlayerKey, TUniquePtr<FPlayerQueue>>& Entry : Queues)
+	{
+		FPlayerQueue& Queue = *Entry.Value;
+		FWorkUnit Unit;
+		Unit.Queues.Add(&Queue);
+
+		for (const TSharedPtr<FQueuedCommand>& Queued : Queue.Pending)
+		{
+			if (Unit.Commands.Num() >= MaxCommandsPerPlayerPerTick)
+			{
+				break;
+			}
+
+			if (Queued->Players.Num() > 1)
+			{
+				// Shared commands are a barrier; the player with the lowest key dispatches each one
+				if (Unit.Commands.Num() == 0 && CommitBudget > 0 && Queued->Players[0] == Entry.Key && IsAtFrontOfAll(*Queued))
+				{
+					--CommitBudget;
+					FWorkUnit& SharedUnit = OutUnits.AddDefaulted_GetRef();
+					for (const FPlayerKey Key : Queued->Players)
+					{
+						SharedUnit.Queues.Add(Queues[Key].Get());
+					}
+					SharedUnit.Commands.Add(Queued.Get());
+				}
+				break;
+			}
+
+			if (Unit.Commands.Num() > 0 && Queued->Command->ReadsInventory())
+			{
+				break;
+			}
+			Unit.Commands.Add(Queued.Get());
+		}
+
+		if (Unit.Commands.Num() > 0)
+		{
+			OutUnits.Add(MoveTemp(Unit));
+		}
+	}
+}
+
+void UInventoryCommandSubsystem::ExecuteUnit(FWorkUnit& Unit)
+{
+	// Queues are in ascending key order, which is the lock order
+	for (FPlayerQueue* Queue : Unit.Queues)
+	{
+		Queue->Lock.Lock();
+	}
+
+	for (FQueuedCommand* Queued : Unit.Commands)
+	{
+		Queued->Command->Execute();
+	}
+
+	for (int32 Index = Unit.Queues.Num() - 1; Index >= 0; --Index)
+	{
+		Unit.Queues[Index]->Lock.Unlock();
+	}
+}
+
+void UInventoryCommandSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	TArray<FPlayerKey, TInlineAllocator<8>> StaleKeys;
+	for (const TPair<FPlayerKey, TUniquePtr<FPlayerQueue>>& Entry : Queues)
+	{
+		if (!Entry.Value->Player.IsValid() || Entry.Value->Pending.Num() == 0)
+		{
+			StaleKeys.Add(Entry.Key);
+		}
+	}
+	for (const FPlayerKey Key : StaleKeys)
+	{
+		RemoveQueue(Key);
+	}
+
+	TArray<FWorkUnit> Units;
+	GatherWork(Units);
+	if (Units.Num() == 0)
+	{
+		return;
+	}
+
+	// Take the dispatched commands off their queues; anything queued while applying goes behind them
+	TArray<TSharedPtr<FQueuedCommand>> Ready;
+	for (const FWorkUnit& Unit : Units)
+	{
+		for (FPlayerQueue* Queue : Unit.Queues)
+		{
+			Ready.Append(Queue->Pending.GetData(), Unit.Commands.Num());
+			Queue->Pending.RemoveAt(0, Unit.Commands.Num(), EAllowShrinking::No);
+		}
+	}
+	Ready.Sort([](const TSharedPtr<FQueuedCommand>& A, const TSharedPtr<FQueuedCommand>& B) { return A->Sequence < B->Sequence; });
+
+	for (int32 Index = 0; Index < Ready.Num(); ++Index)
+	{
+		// Shared commands were collected once per player
+		if (Index == 0 || Ready[Index] != Ready[Index - 1])
+		{
+			Ready[Index]->Command->Capture();
+		}
+	}
+
+	if (Units.Num() == 1)
+	{
+		ExecuteUnit(Units[0]);
+	}
+	else
+	{
+		TArray<UE::Tasks::FTask> Tasks;
+		Tasks.Reserve(Units.Num());
+		for (FWorkUnit& Unit : Units)
+		{
+			Tasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [&Unit]() { ExecuteUnit(Unit); }));
+		}
+		UE::Tasks::Wait(Tasks);
+	}
+
+	for (int32 Index = 0; Index < Ready.Num(); ++Index)
+	{
+		if (Index == 0 || Ready[Index] != Ready[Index - 1])
+		{
+			Ready[Index]->Command->Apply();
+		}
+	}
+}
@@ -0,0 +1,675 @@
+// InventoryFuzzCommandlet.cpp
+#include "InventoryFuzzCommandlet.h"
+#include "BagComponent.h"
+#include "EquipmentComponent.h"
+#include "InventoryRegistryComponent.h"
+#include "InventoryRouterComponent.h"
+#include "InventorySlotDataComponent.h"
+#include "ItemBase.h"
+#include "ItemInstanceSubsystem.h"
+#include "S_ItemInfo.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+namespace InventoryFuzz
+{
+	enum class EOp : uint8
+	{
+		Add,
+		Remove,
+		Split,
+		Merge,
+		Move,
+		Swap,
+		Resize,
+		Equip,
+		Unequip,
+		DropToWorld,
+		DropEquippedToWorld,
+		Destroy,
+		Count
+	};
+
+	const TCHAR* OpName(EOp Op)
+	{
+		switch (Op)
+		{
+		case EOp::Add:                 return TEXT("Add");
+		case EOp::Remove:              return TEXT("Remove");
+		case EOp::Split:               return TEXT("Split");
+		case EOp::Merge:               return TEXT("Merge");
+		case EOp::Move:                return TEXT("Move");
+		case EOp::Swap:                return TEXT("Swap");
+		case EOp::Resize:              return TEXT("Resize");
+		case EOp::Equip:               return TEXT("Equip");
+		case EOp::Unequip:             return TEXT("Unequip");
+		case EOp::DropToWorld:         return TEXT("DropToWorld");
+		case EOp::DropEquippedToWorld: return TEXT("DropEquippedToWorld");
+		case EOp::Destroy:             return TEXT("Destroy");
+		default:                       return TEXT("?");
+		}
+	}
+
+	// One fully resolved step, so a sequence replays identically without the random stream. Bags are
+	// indices into the registry's bag list at the time the step runs; for equipment, the slot is the
+	// EEquipmentSlot value.
+	struct FStep
+	{
+		EOp Op = EOp::Add;
+		int32 BagA = 0;
+		int32 SlotA = 0;
+		int32 BagB = 0;
+		int32 SlotB = 0;
+		int32 Item = 0;
+		int32 Count = 0;
+
+		FString ToString() const
+		{
+			return FString::Printf(TEXT("%s bag%d[%d] -> bag%d[%d] item=%d count=%d"), OpName(Op), BagA, SlotA, BagB, SlotB, Item, Count);
+		}
+	};
+
+	struct FCase
+	{
+		TArray<int32> BagSizes;
+		TArray<FStep> Steps;
+	};
+
+	// Live state of one run: a possessed pawn with bags and equipment, and the router of its controller
+	struct FState
+	{
+		APlayerController* Controller = nullptr;
+		APawn* Pawn = nullptr;
+		UInventoryRegistryComponent* Registry = nullptr;
+		UInventoryRouterComponent* Router = nullptr;
+		UEquipmentComponent* Equipment = nullptr;
+		TMap<FName, int64> Expected;
+
+		// Live instances before the run, so leaks from earlier runs don't count against this one
+		int32 BaselineInstances = 0;
+
+		const TArray<UBagComponent*>& GetBags() const { return Registry->GetBags(); }
+	};
+
+	class FFuzzer
+	{
+	public:
+		explicit FFuzzer(UWorld* InWorld)
+			: World(InWorld)
+		{
+			auto AddItem = [this](const TCHAR* ID, int32 MaxStack, float Weight) -> FS_ItemInfo&
+			{
+				FS_ItemInfo& Item = Items.AddDefaulted_GetRef();
+				Item.ItemID = FName(ID);
+				Item.MaxStackSize = MaxStack;
+				Item.Weight = Weight;
+				return Item;
+			};
+
+			AddItem(TEXT("Fuzz_Sword"), 1, 5.0f);
+			AddItem(TEXT("Fuzz_Gem"), 5, 0.1f);
+			AddItem(TEXT("Fuzz_Potion"), 20, 0.5f);
+			AddItem(TEXT("Fuzz_Arrow"), 99, 0.05f);
+
+			FS_ItemInfo& Helm = AddItem(TEXT("Fuzz_Helm"), 1, 2.0f);
+			Helm.ItemType = EItemType::Equipment;
+			Helm.EquipSlot = EEquipmentSlot::Head;
+			Helm.bUniqueInstance = true;
+
+			FS_ItemInfo& Blade = AddItem(TEXT("Fuzz_Blade"), 1, 3.0f);
+			Blade.ItemType = EItemType::Equipment;
+			Blade.EquipSlot = EEquipmentSlot::MainHand;
+
+			FS_ItemInfo& Pouch = AddItem(TEXT("Fuzz_Pouch"), 1, 0.5f);
+			Pouch.ItemType = EItemType::Bag;
+			Pouch.BagSlots = 4;
+		}
+
+		// Run Case until an invariant breaks and return the failing step, or INDEX_NONE.
+		// With a stream, steps are generated from the live state and appended to Case as they run.
+		int32 Run(FCase& Case, FRandomStream* Stream, int32 NumSteps, FString& OutFailure)
+		{
+			FState State;
+			if (!Setup(Case, State))
+			{
+				OutFailure = TEXT("Setup failed");
+				Teardown(State);
+				return 0;
+			}
+
+			int32 FailedStep = INDEX_NONE;
+			const int32 TotalSteps = Stream ? NumSteps : Case.Steps.Num();
+			for (int32 StepIndex = 0; StepIndex < TotalSteps; ++StepIndex)
+			{
+				if (Stream)
+				{
+					Case.Steps.Add(Generate(State, *Stream));
+				}
+
+				Apply(State, Case.Steps[StepIndex]);
+				if (!CheckInvariants(State, OutFailure))
+				{
+					FailedStep = StepIndex;
+					break;
+				}
+			}
+
+			Teardown(State);
+			return FailedStep;
+		}
+
+		// Shrink a failing case by removing ever smaller chunks of steps while it keeps failing
+		FCase Minimize(FCase Failing)
+		{
+			int32 ChunkSize = FMath::Max(1, Failing.Steps.Num() / 2);
+			while (ChunkSize >= 1)
+			{
+				bool bRemovedAny = false;
+				for (int32 Start = 0; Start < Failing.Steps.Num();)
+				{
+					FCase Candidate = Failing;
+					Candidate.Steps.RemoveAt(Start, FMath::Min(ChunkSize, Candidate.Steps.Num() - Start));
+
+					FString Failure;
+					if (Candidate.Steps.Num() > 0 && Run(Candidate, nullptr, 0, Failure) != INDEX_NONE)
+					{
+						Failing = MoveTemp(Candidate);
+						bRemovedAny = true;
+					}
+					else
+					{
+						Start += ChunkSize;
+					}
+				}
+
+				if (!bRemovedAny)
+				{
+					ChunkSize /= 2;
+				}
+			}
+			return Failing;
+		}
+
+	private:
+		UWorld* World;
+		TArray<FS_ItemInfo> Items;
+
+		bool Setup(const FCase& Case, FState& State)
+		{
+			const UItemInstanceSubsystem* Instances = UItemInstanceSubsystem::Get(World);
+			State.BaselineInstances = Instances ? Instances->GetNumInstances() : 0;
+
+			State.Controller = World->SpawnActor<APlayerController>();
+			State.Pawn = World->SpawnActor<APawn>();
+			if (!State.Controller || !State.Pawn)
+			{
+				return false;
+			}
+			State.Controller->Possess(State.Pawn);
+
+			// Registry first, so the bags and equipped bags below register with it like a player's do
+			State.Registry = NewObject<UInventoryRegistryComponent>(State.Controller);
+			State.Registry->RegisterComponent();
+			State.Router = NewObject<UInventoryRouterComponent>(State.Controller);
+			State.Router->RegisterComponent();
+			State.Equipment = NewObject<UEquipmentComponent>(State.Pawn);
+			State.Equipment->RegisterComponent();
+
+			for (int32 BagIndex = 0; BagIndex < Case.BagSizes.Num(); ++BagIndex)
+			{
+				UBagComponent* Bag = NewObject<UBagComponent>(State.Pawn);
+				Bag->RegisterComponent();
+
+				FS_ItemInfo BagItem;
+				BagItem.ItemID = *FString::Printf(TEXT("Fuzz_Bag%d"), BagIndex);
+				BagItem.ItemType = EItemType::Bag;
+				BagItem.BagSlots = Case.BagSizes[BagIndex];
+				if (!Bag->InitializeBag(BagItem))
+				{
+					return false;
+				}
+			}
+			return State.GetBags().Num() == Case.BagSizes.Num();
+		}
+
+		void Teardown(FState& State)
+		{
+			for (TActorIterator<AItemBase> It(World); It; ++It)
+			{
+				It->Destroy();
+			}
+			if (State.Pawn)
+			{
+				State.Pawn->Destroy();
+			}
+			if (State.Controller)
+			{
+				State.Controller->Destroy();
+			}
+		}
+
+		UBagComponent* GetBag(const FState& State, int32 BagIndex) const
+		{
+			return State.GetBags().IsValidIndex(BagIndex) ? State.GetBags()[BagIndex] : nullptr;
+		}
+
+		UInventorySlotDataComponent* GetSlot(const FState& State, int32 BagIndex, int32 SlotIndex) const
+		{
+			const UBagComponent* Bag = GetBag(State, BagIndex);
+			if (!Bag)
+			{
+				return nullptr;
+			}
+
+			const TArray<UInventorySlotDataComponent*>& Slots = Bag->GetInventorySlots();
+			return Slots.IsValidIndex(SlotIndex) ? Slots[SlotIndex] : nullptr;
+		}
+
+		int32 RandomSlot(const FState& State, int32 BagIndex, FRandomStream& Stream) const
+		{
+			const UBagComponent* Bag = GetBag(State, BagIndex);
+			return Stream.RandRange(0, Bag ? FMath::Max(0, Bag->GetInventorySlots().Num() - 1) : 0);
+		}
+
+		static int32 RandomEquipmentSlot(FRandomStream& Stream)
+		{
+			return Stream.RandRange(static_cast<int32>(EEquipmentSlot::None) + 1, static_cast<int32>(EEquipmentSlot::MAX) - 1);
+		}
+
+		// Picks operands that make each operation likely to do something, biased towards the edge cases
+		// that have bitten us: partial merges into nearly full stacks, swaps of mixed items, shrinking full
+		// bags, equipping into the right slot, and unequipping bags that still hold things.
+		FStep Generate(const FState& State, FRandomStream& Stream) const
+		{
+			const int32 NumBags = FMath::Max(1, State.GetBags().Num());
+
+			FStep Step;
+			Step.Op = static_cast<EOp>(Stream.RandRange(0, static_cast<int32>(EOp::Count) - 1));
+			Step.BagA = Stream.RandRange(0, NumBags - 1);
+			Step.BagB = Stream.RandRange(0, NumBags - 1);
+			Step.SlotA = RandomSlot(State, Step.BagA, Stream);
+			Step.SlotB = RandomSlot(State, Step.BagB, Stream);
+			Step.Item = Stream.RandRange(0, Items.Num() - 1);
+
+			const UInventorySlotDataComponent* Source = GetSlot(State, Step.BagA, Step.SlotA);
+			const int32 SourceCount = Source ? Source->GetStackCount() : 0;
+
+			switch (Step.Op)
+			{
+			case EOp::Add:
+				Step.Count = Stream.RandRange(1, Items[Step.Item].GetMaxStack() * 3);
+				break;
+			case EOp::Remove:
+			case EOp::DropToWorld:
+			case EOp::Destroy:
+				Step.Count = Stream.RandRange(1, FMath::Max(1, SourceCount + 1));
+				break;
+			case EOp::Split:
+				Step.Count = FMath::Max(1, SourceCount / 2);
+				break;
+			case EOp::Merge:
+			case EOp::Move:
+			case EOp::Swap:
+				Step.Count = FMath::Max(1, SourceCount);
+				break;
+			case EOp::Resize:
+				Step.Count = Stream.RandRange(0, 16);
+				break;
+			case EOp::Equip:
+			{
+				// Mostly the slot the item belongs in, sometimes anywhere to exercise rejection
+				const bool bRightSlot = Source && !Source->IsEmpty() && Stream.FRand() < 0.8f;
+				if (bRightSlot && Source->GetItemData().ItemType == EItemType::Bag)
+				{
+					Step.SlotB = Stream.RandRange(static_cast<int32>(EEquipmentSlot::Bag1), static_cast<int32>(EEquipmentSlot::Bag4));
+				}
+				else if (bRightSlot && Source->GetItemData().ItemType == EItemType::Equipment)
+				{
+					Step.SlotB = static_cast<int32>(Source->GetItemData().EquipSlot);
+				}
+				else
+				{
+					Step.SlotB = RandomEquipmentSlot(Stream);
+				}
+				Step.Count = 1;
+				break;
+			}
+			case EOp::Unequip:
+			case EOp::DropEquippedToWorld:
+				Step.SlotA = RandomEquipmentSlot(Stream);
+				Step.Count = 1;
+				break;
+			default:
+				break;
+			}
+
+			// Merges look for a slot already holding the same item
+			if (Step.Op == EOp::Merge && Source && !Source->IsEmpty())
+			{
+				for (int32 BagIndex = 0; BagIndex < State.GetBags().Num(); ++BagIndex)
+				{
+					const TArray<UInventorySlotDataComponent*>& Slots = State.GetBags()[BagIndex]->GetInventorySlots();
+					for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+					{
+						if (Slots[SlotIndex] != Source && Slots[SlotIndex]->GetItemData().ItemID == Source->GetItemData().ItemID)
+						{
+							Step.BagB = BagIndex;
+							Step.SlotB = SlotIndex;
+						}
+					}
+				}
+			}
+
+			return Step;
+		}
+
+		// Payload for moving Count out of a bag slot, naming whatever the slot holds right now
+		FInventoryDragPayload BagPayload(const FState& State, int32 BagIndex, int32 SlotIndex, int32 Count) const
+		{
+			const UInventorySlotDataComponent* Slot = GetSlot(State, BagIndex, SlotIndex);
+
+			FInventoryDragPayload Payload;
+			Payload.Source = FInventoryContainerHandle::ForBag(GetBag(State, BagIndex));
+			Payload.SlotIndex = SlotIndex;
+			Payload.ItemID = Slot ? Slot->GetItemData().ItemID : NAME_None;
+			Payload.Count = Count;
+			return Payload;
+		}
+
+		FInventoryDragPayload EquipmentPayload(const FState& State, int32 EquipmentSlot) const
+		{
+			FInventoryDragPayload Payload;
+			Payload.Source = FInventoryContainerHandle::ForEquipment(State.Equipment);
+			Payload.SlotIndex = EquipmentSlot;
+			Payload.ItemID = State.Equipment->GetEquippedItem(static_cast<EEquipmentSlot>(EquipmentSlot)).ItemID;
+			Payload.Count = 1;
+			return Payload;
+		}
+
+		void Apply(FState& State, const FStep& Step) const
+		{
+			UInventoryRouterComponent& Router = *State.Router;
+
+			switch (Step.Op)
+			{
+			case EOp::Add:
+			{
+				UBagComponent* Bag = GetBag(State, Step.BagA);
+				if (Bag && Items.IsValidIndex(Step.Item))
+				{
+					const FS_ItemInfo& Item = Items[Step.Item];
+					const int32 Leftover = Bag->AddItem(Item, Step.Count);
+					State.Expected.FindOrAdd(Item.ItemID) += Step.Count - Leftover;
+				}
+				break;
+			}
+
+			case EOp::Remove:
+			{
+				UInventorySlotDataComponent* Slot = GetSlot(State, Step.BagA, Step.SlotA);
+				const FName ItemID = Slot ? Slot->GetItemData().ItemID : NAME_None;
+				if (Slot && Slot->RemoveItems(Step.Count))
+				{
+					State.Expected.FindOrAdd(ItemID) -= Step.Count;
+				}
+				break;
+			}
+
+			case EOp::Split:
+			case EOp::Merge:
+			case EOp::Move:
+			case EOp::Swap:
+				Router.ExecuteTransfer(BagPayload(State, Step.BagA, Step.SlotA, Step.Count), FInventoryContainerHandle::ForBag(GetBag(State, Step.BagB)), Step.SlotB);
+				break;
+
+			case EOp::Resize:
+				if (UBagComponent* Bag = GetBag(State, Step.BagA))
+				{
+					Bag->ResizeBag(Step.Count);
+				}
+				break;
+
+			case EOp::Equip:
+				Router.ExecuteTransfer(BagPayload(State, Step.BagA, Step.SlotA, Step.Count), FInventoryContainerHandle::ForEquipment(State.Equipment), Step.SlotB);
+				break;
+
+			case EOp::Unequip:
+				Router.ExecuteTransfer(EquipmentPayload(State, Step.SlotA), FInventoryContainerHandle::ForBag(GetBag(State, Step.BagB)), Step.SlotB);
+				break;
+
+			case EOp::DropToWorld:
+				Router.ExecuteTransfer(BagPayload(State, Step.BagA, Step.SlotA, Step.Count), FInventoryContainerHandle::ForKind(EInventoryContainerKind::World), INDEX_NONE);
+				break;
+
+			case EOp::DropEquippedToWorld:
+				Router.ExecuteTransfer(EquipmentPayload(State, Step.SlotA), FInventoryContainerHandle::ForKind(EInventoryContainerKind::World), INDEX_NONE);
+				break;
+
+			case EOp::Destroy:
+			{
+				const FInventoryDragPayload Payload = BagPayload(State, Step.BagA, Step.SlotA, Step.Count);
+				if (Router.ExecuteTransfer(Payload, FInventoryContainerHandle::ForKind(EInventoryContainerKind::Destroy), INDEX_NONE))
+				{
+					State.Expected.FindOrAdd(Payload.ItemID) -= Payload.Count;
+				}
+				break;
+			}
+
+			default:
+				break;
+			}
+		}
+
+		bool CheckInvariants(const FState& State, FString& OutFailure) const
+		{
+			TMap<FName, int64> Actual;
+			TSet<FItemInstanceHandle> HeldInstances;
+			int32 UniqueItemsHeld = 0;
+
+			// Every unique item must hold exactly one live instance nobody else holds
+			auto TrackInstance = [this, &HeldInstances, &UniqueItemsHeld, &OutFailure](const FS_ItemInfo& Item, FItemInstanceHandle Instance, const FString& Where)
+			{
+				if (!Item.bUniqueInstance)
+				{
+					return true;
+				}
+
+				++UniqueItemsHeld;
+				const UItemInstanceSubsystem* Instances = UItemInstanceSubsystem::Get(World);
+				if (!Instance.IsValid() || !Instances || !Instances->FindInstance(Instance))
+				{
+					OutFailure = FString::Printf(TEXT("%s holds unique %s without a live instance"), *Where, *Item.ItemID.ToString());
+					return false;
+				}
+
+				bool bAlreadyHeld = false;
+				HeldInstances.Add(Instance, &bAlreadyHeld);
+				if (bAlreadyHeld)
+				{
+					OutFailure = FString::Printf(TEXT("%s holds instance %d of %s, which is also held elsewhere"), *Where, Instance.Index, *Item.ItemID.ToString());
+					return false;
+				}
+				return true;
+			};
+
+			const TArray<UBagComponent*>& Bags = State.GetBags();
+			for (int32 BagIndex = 0; BagIndex < Bags.Num(); ++BagIndex)
+			{
+				const UBagComponent* Bag = Bags[BagIndex];
+				TMap<FName, int32> BagTotals;
+
+				const TArray<UInventorySlotDataComponent*>& Slots = Bag->GetInventorySlots();
+				for (int32 SlotIndex = 0; SlotIndex < Slots.Num(); ++SlotIndex)
+				{
+					const UInventorySlotDataComponent* Slot = Slots[SlotIndex];
+					if (!Slot)
+					{
+						OutFailure = FString::Printf(TEXT("bag%d[%d] is null"), BagIndex, SlotIndex);
+						return false;
+					}
+
+					if (Slot->GetStackCount() < 0 || Slot->GetStackCount() > Slot->GetItemData().GetMaxStack())
+					{
+						OutFailure = FString::Printf(TEXT("bag%d[%d] holds %d of %s (max %d)"), BagIndex, SlotIndex, Slot->GetStackCount(), *Slot->GetItemData().ItemID.ToString(), Slot->GetItemData().GetMaxStack());
+						return false;
+					}
+
+					if (Slot->IsEmpty() != Slot->GetItemData().ItemID.IsNone())
+					{
+						OutFailure = FString::Printf(TEXT("bag%d[%d] has item %s with count %d"), BagIndex, SlotIndex, *Slot->GetItemData().ItemID.ToString(), Slot->GetStackCount());
+						return false;
+					}
+
+					if (!Slot->IsEmpty())
+					{
+						BagTotals.FindOrAdd(Slot->GetItemData().ItemID) += Slot->GetStackCount();
+						if (!TrackInstance(Slot->GetItemData(), Slot->GetInstanceHandle(), FString::Printf(TEXT("bag%d[%d]"), BagIndex, SlotIndex)))
+						{
+							return false;
+						}
+					}
+				}
+
+				// The bag's incremental counts must agree with its slots
+				for (const FS_ItemInfo& Item : Items)
+				{
+					const int32 SlotTotal = BagTotals.FindRef(Item.ItemID);
+					if (Bag->GetItemCount(Item.ItemID) != SlotTotal)
+					{
+						OutFailure = FString::Printf(TEXT("bag%d counts %d of %s but its slots hold %d"), BagIndex, Bag->GetItemCount(Item.ItemID), *Item.ItemID.ToString(), SlotTotal);
+						return false;
+					}
+					Actual.FindOrAdd(Item.ItemID) += SlotTotal;
+				}
+			}
+
+			for (int32 SlotValue = static_cast<int32>(EEquipmentSlot::None) + 1; SlotValue < static_cast<int32>(EEquipmentSlot::MAX); ++SlotValue)
+			{
+				const EEquipmentSlot Slot = static_cast<EEquipmentSlot>(SlotValue);
+				const FS_ItemInfo& Equipped = State.Equipment->GetEquippedItem(Slot);
+				if (Equipped.ItemID.IsNone())
+				{
+					continue;
+				}
+
+				Actual.FindOrAdd(Equipped.ItemID) += 1;
+				if (!TrackInstance(Equipped, State.Equipment->GetEquippedInstance(Slot), FString::Printf(TEXT("equipment[%d]"), SlotValue)))
+				{
+					return false;
+				}
+			}
+
+			for (TActorIterator<AItemBase> It(World); It; ++It)
+			{
+				Actual.FindOrAdd(It->ItemDetails.ItemID) += It->StackCount;
+				if (!TrackInstance(It->ItemDetails, It->InstanceHandle, It->GetName()))
+				{
+					return false;
+				}
+			}
+
+			for (const FS_ItemInfo& Item : Items)
+			{
+				const int64 ExpectedCount = State.Expected.FindRef(Item.ItemID);
+				const int64 ActualCount = Actual.FindRef(Item.ItemID);
+				if (ExpectedCount != ActualCount)
+				{
+					OutFailure = FString::Printf(TEXT("%s: expected %lld, found %lld across bags, equipment and pickups (%s)"), *Item.ItemID.ToString(), ExpectedCount, ActualCount, ActualCount > ExpectedCount ? TEXT("duplicated") : TEXT("lost"));
+					return false;
+				}
+			}
+
+			// Instances of items that left the game must have been released
+			const UItemInstanceSubsystem* Instances = UItemInstanceSubsystem::Get(World);
+			const int32 LiveInstances = Instances ? Instances->GetNumInstances() - State.BaselineInstances : 0;
+			if (LiveInstances != UniqueItemsHeld)
+			{
+				OutFailure = FString::Printf(TEXT("%d instances live for %d unique items held (%s)"), LiveInstances, UniqueItemsHeld, LiveInstances > UniqueItemsHeld ? TEXT("leaked") : TEXT("released early"));
+				return false;
+			}
+			return true;
+		}
+	};
+}
+
+UInventoryFuzzCommandlet::UInventoryFuzzCommandlet()
+{
+	IsClient = false;
+	IsServer = true;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UInventoryFuzzCommandlet::Main(const FString& Params)
+{
+	using namespace InventoryFuzz;
+
+	int32 Seed = 1;
+	int32 Runs = 1000;
+	int32 Steps = 200;
+	int32 NumBags = 3;
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	FParse::Value(*Params, TEXT("Runs="), Runs);
+	FParse::Value(*Params, TEXT("Steps="), Steps);
+	FParse::Value(*Params, TEXT("Bags="), NumBags);
+	NumBags = FMath::Max(1, NumBags);
+
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("InventoryFuzz"));
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+	World->InitializeActorsForPlay(FURL());
+	World->BeginPlay();
+
+	FFuzzer Fuzzer(World);
+	int32 Failures = 0;
+
+	for (int32 Run = 0; Run < Runs; ++Run)
+	{
+		// Every run has its own seed so any failure can be rerun alone with -Seed=<run seed> -Runs=1
+		const int32 RunSeed = Seed + Run;
+		FRandomStream Stream(RunSeed);
+
+		FCase Case;
+		for (int32 BagIndex = 0; BagIndex < NumBags; ++BagIndex)
+		{
+			Case.BagSizes.Add(Stream.RandRange(1, 16));
+		}
+
+		// Each run leaves a destroyed pawn, controller and pickups behind
+		if (Run % 100 == 99)
+		{
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+
+		FString Failure;
+		const int32 FailedStep = Fuzzer.Run(Case, &Stream, Steps, Failure);
+		if (FailedStep == INDEX_NONE)
+		{
+			continue;
+		}
+
+		++Failures;
+		Case.Steps.SetNum(FailedStep + 1);
+		FCase Minimal = Fuzzer.Minimize(Case);
+
+		FString MinimalFailure;
+		Fuzzer.Run(Minimal, nullptr, 0, MinimalFailure);
+
+		UE_LOG(LogTemp, Error, TEXT("Seed %d failed at step %d: %s"), RunSeed, FailedStep, *Failure);
+		UE_LOG(LogTemp, Error, TEXT("Minimal reproduction (%d steps, bags %s): %s"), Minimal.Steps.Num(),
+			*FString::JoinBy(Minimal.BagSizes, TEXT(","), [](int32 Size) { return FString::FromInt(Size); }), *MinimalFailure);
+		for (const FStep& Step : Minimal.Steps)
+		{
+			UE_LOG(LogTemp, Error, TEXT("  %s"), *Step.ToString());
+		}
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	UE_LOG(LogTemp, Display, TEXT("Inventory fuzz: %d runs of %d steps from seed %d, %d failed"), Runs, Steps, Seed, Failures);
+	return Failures > 0 ? 1 : 0;
+}
@@ -0,0 +1,366 @@
+// InventoryIconAtlasSubsystem.cpp
+#include "InventoryIconAtlasSubsystem.h"
+#include "ItemRegistrySubsystem.h"
+#include "CanvasItem.h"
+#include "CanvasTypes.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Engine.h"
+#include "Engine/Texture2D.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Styling/SlateBrush.h"
+
+UInventoryIconAtlasSubsystem::UInventoryIconAtlasSubsystem()
+	: PageSize(1024)
+	, CellSize(64)
+	, MemoryBudgetMB(16)
+	, FreeHead(INDEX_NONE)
+	, FreeTail(INDEX_NONE)
+	, CellsPerRow(0)
+	, CellsPerPage(0)
+	, MaxPages(0)
+{
+}
+
+UInventoryIconAtlasSubsystem* UInventoryIconAtlasSubsystem::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<UInventoryIconAtlasSubsystem>() : nullptr;
+}
+
+bool UInventoryIconAtlasSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Nothing draws icons without a renderer
+	return !IsRunningDedicatedServer() && !IsRunningCommandlet() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UInventoryIconAtlasSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PageSize = FMath::Max(PageSize, 64);
+	CellSize = FMath::Clamp(CellSize, 8, PageSize);
+	CellsPerRow = PageSize / CellSize;
+	CellsPerPage = CellsPerRow * CellsPerRow;
+
+	// RGBA8, no mips
+	const int64 PageBytes = int64(PageSize) * PageSize * 4;
+	MaxPages = FMath::Max(1, int32((int64(MemoryBudgetMB) * 1024 * 1024) / PageBytes));
+
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UInventoryIconAtlasSubsystem::Tick));
+}
+
+void UInventoryIconAtlasSubsystem::Deinitialize()
+{
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+
+	for (FIconCell& IconCell : Cells)
+	{
+		if (IconCell.IconLoad)
+		{
+			IconCell.IconLoad->CancelHandle();
+		}
+	}
+	PendingDraws.Empty();
+	Pages.Empty();
+	Cells.Empty();
+	CellByRegistryIndex.Empty();
+	FreeHead = INDEX_NONE;
+	FreeTail = INDEX_NONE;
+
+	Super::Deinitialize();
+}
+
+int32 UInventoryIconAtlasSubsystem::AcquireIcon(int32 RegistryIndex, FSimpleDelegate OnDrawn)
+{
+	if (const int32* Existing = CellByRegistryIndex.Find(RegistryIndex))
+	{
+		const int32 Cell = *Existing;
+		FIconCell& IconCell = Cells[Cell];
+		if (IconCell.PinCount++ == 0)
+		{
+			Unlink(Cell);
+		}
+		if (!IconCell.bDrawn && OnDrawn.IsBound())
+		{
+			IconCell.OnDrawn.Add(MoveTemp(OnDrawn));
+		}
+		return Cell;
+	}
+
+	UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+	const FItemRegistryEntry* Entry = Registry ? Registry->GetEntry(RegistryIndex) : nullptr;
+	if (!Entry || (!Entry->Info.ItemIcon && !Entry->IconPath.IsValid()))
+	{
+		return INDEX_NONE;
+	}
+
+	// Grow before evicting: an empty cell sits at the head of the free list if there is one
+	const bool bHasEmptyCell = FreeHead != INDEX_NONE && Cells[FreeHead].RegistryIndex == INDEX_NONE;
+	if (!bHasEmptyCell && Pages.Num() < MaxPages)
+	{
+		AddPage();
+	}
+
+	const int32 Cell = FreeHead;
+	if (Cell == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	Unlink(Cell);
+	FIconCell& IconCell = Cells[Cell];
+	if (IconCell.RegistryIndex != INDEX_NONE)
+	{
+		CellByRegistryIndex.Remove(IconCell.RegistryIndex);
+	}
+	if (IconCell.IconLoad)
+	{
+		IconCell.IconLoad->CancelHandle();
+		IconCell.IconLoad.Reset();
+	}
+	IconCell.RegistryIndex = RegistryIndex;
+	IconCell.PinCount = 1;
+	IconCell.bDrawn = false;
+	IconCell.OnDrawn.Reset();
+	if (OnDrawn.IsBound())
+	{
+		IconCell.OnDrawn.Add(MoveTemp(OnDrawn));
+	}
+	CellByRegistryIndex.Add(RegistryIndex, Cell);
+
+	// Cooked entries only carry the path; the texture is streamed in and dropped again once it's in the atlas
+	if (Entry->Info.ItemIcon)
+	{
+		QueueDraw(Cell, RegistryIndex, Entry->Info.ItemIcon);
+	}
+	else
+	{
+		TSharedPtr<FStreamableHandle> IconLoad = UAssetManager::GetStreamableManager().RequestAsyncLoad(Entry->IconPath,
+			FStreamableDelegate::CreateUObject(this, &UInventoryIconAtlasSubsystem::HandleIconLoaded, Cell, RegistryIndex));
+		Cells[Cell].IconLoad = IconLoad;
+	}
+	return Cell;
+}
+
+bool UInventoryIconAtlasSubsystem::GetCellBrush(int32 Cell, FSlateBrush& OutBrush) const
+{
+	if (!Cells.IsValidIndex(Cell) || !Cells[Cell].bDrawn)
+	{
+		return false;
+	}
+
+	FillBrush(Cell, OutBrush);
+	return true;
+}
+
+void UInventoryIconAtlasSubsystem::HandleIconLoaded(int32 Cell, int32 RegistryIndex)
+{
+	// Evicted and handed to another item while loading
+	if (!Cells.IsValidIndex(Cell) || Cells[Cell].RegistryIndex != RegistryIndex)
+	{
+		return;
+	}
+
+	const UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+	const FItemRegistryEntry* Entry = Registry ? Registry->GetEntry(RegistryIndex) : nullptr;
+	UTexture2D* Icon = Entry ? Cast<UTexture2D>(Entry->IconPath.ResolveObject()) : nullptr;
+	if (!Icon)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Icon atlas: failed to load icon for registry entry %d"), RegistryIndex);
+		return;
+	}
+	QueueDraw(Cell, RegistryIndex, Icon);
+}
+
+void UInventoryIconAtlasSubsystem::QueueDraw(int32 Cell, int32 RegistryIndex, UTexture2D* Icon)
+{
+	Icon->SetForceMipLevelsToBeResident(30.0f);
+	FInventoryIconDraw& Draw = PendingDraws.AddDefaulted_GetRef();
+	Draw.Icon = Icon;
+	Draw.Cell = Cell;
+	Draw.RegistryIndex = RegistryIndex;
+}
+
+void UInventoryIconAtlasSubsystem::ReleaseIcon(int32 Cell)
+{
+	if (Cells.IsValidIndex(Cell) && Cells[Cell].PinCount > 0 && --Cells[Cell].PinCount == 0)
+	{
+		LinkTail(Cell);
+	}
+}
+
+bool UInventoryIconAtlasSubsystem::Tick(float DeltaTime)
+{
+	FlushPendingDraws();
+	return true;
+}
+
+void UInventoryIconAtlasSubsystem::FlushPendingDraws()
+{
+	if (PendingDraws.Num() == 0)
+	{
+		return;
+	}
+
+	PendingDraws.Sort([](const FInventoryIconDraw& A, const FInventoryIconDraw& B) { return A.Cell < B.Cell; });
+
+	TArray<FInventoryIconDraw> StillStreaming;
+	TArray<int32> DrawnCells;
+	int32 DrawIndex = 0;
+	while (DrawIndex < PendingDraws.Num())
+	{
+		const int32 PageIndex = PendingDraws[DrawIndex].Cell / CellsPerPage;
+		int32 PageEnd = DrawIndex;
+		while (PageEnd < PendingDraws.Num() && PendingDraws[PageEnd].Cell / CellsPerPage == PageIndex)
+		{
+			++PageEnd;
+		}
+
+		FTextureRenderTargetResource* Target = Pages.IsValidIndex(PageIndex) && Pages[PageIndex] ? Pages[PageIndex]->GameThread_GetRenderTargetResource() : nullptr;
+		if (Target)
+		{
+			FCanvas Canvas(Target, nullptr, nullptr, GMaxRHIFeatureLevel);
+			for (; DrawIndex < PageEnd; ++DrawIndex)
+			{
+				const FInventoryIconDraw& Draw = PendingDraws[DrawIndex];
+
+				// Evicted and handed to another item before it was ever drawn
+				if (!Draw.Icon || Cells[Draw.Cell].RegistryIndex != Draw.RegistryIndex)
+				{
+					continue;
+				}
+
+				if (!Draw.Icon->IsFullyStreamedIn() || !Draw.Icon->GetResource())
+				{
+					StillStreaming.Add(Draw);
+					continue;
+				}
+
+				// Opaque so the icon's alpha replaces whatever the cell held before
+				FCanvasTileItem Tile(GetCellOrigin(Draw.Cell), Draw.Icon->GetResource(), FVector2D(CellSize, CellSize), FLinearColor::White);
+				Tile.BlendMode = SE_BLEND_Opaque;
+				Canvas.DrawItem(Tile);
+				DrawnCells.Add(Draw.Cell);
+			}
+			Canvas.Flush_GameThread();
+		}
+		DrawIndex = PageEnd;
+	}
+
+	PendingDraws = MoveTemp(StillStreaming);
+
+	// Callbacks last, since they may acquire or release cells
+	TArray<FSimpleDelegate> Callbacks;
+	for (const int32 Cell : DrawnCells)
+	{
+		FIconCell& IconCell = Cells[Cell];
+		IconCell.bDrawn = true;
+		IconCell.IconLoad.Reset();
+		Callbacks.Append(MoveTemp(IconCell.OnDrawn));
+		IconCell.OnDrawn.Reset();
+	}
+	for (const FSimpleDelegate& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound();
+	}
+}
+
+bool UInventoryIconAtlasSubsystem::AddPage()
+{
+	UTextureRenderTarget2D* Page = NewObject<UTextureRenderTarget2D>(this);
+	if (!Page)
+	{
+		return false;
+	}
+
+	Page->RenderTargetFormat = RTF_RGBA8_SRGB;
+	Page->ClearColor = FLinearColor::Transparent;
+	Page->bAutoGenerateMips = false;
+	Page->InitAutoFormat(PageSize, PageSize);
+	Page->UpdateResourceImmediate(true);
+	Pages.Add(Page);
+
+	// New cells are empty, so they go ahead of any cached icon
+	const int32 FirstCell = Cells.Num();
+	Cells.AddDefaulted(CellsPerPage);
+	for (int32 Cell = FirstCell + CellsPerPage - 1; Cell >= FirstCell; --Cell)
+	{
+		LinkHead(Cell);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Icon atlas: page %d of %d added (%dx%d, %d cells)"), Pages.Num(), MaxPages, PageSize, PageSize, CellsPerPage);
+	return true;
+}
+
+void UInventoryIconAtlasSubsystem::FillBrush(int32 Cell, FSlateBrush& OutBrush) const
+{
+	const FVector2D Origin = GetCellOrigin(Cell);
+	const float InvPageSize = 1.0f / PageSize;
+
+	OutBrush = FSlateBrush();
+	OutBrush.SetResourceObject(Pages[Cell / CellsPerPage]);
+	OutBrush.ImageSize = FVector2D(CellSize, CellSize);
+	OutBrush.SetUVRegion(FBox2f(FVector2f(Origin) * InvPageSize, FVector2f(Origin + FVector2D(CellSize, CellSize)) * InvPageSize));
+}
+
+FVector2D UInventoryIconAtlasSubsystem::GetCellOrigin(int32 Cell) const
+{
+	const int32 PageCell = Cell % CellsPerPage;
+	return FVector2D((PageCell % CellsPerRow) * CellSize, (PageCell / CellsPerRow) * CellSize);
+}
+
+void UInventoryIconAtlasSubsystem::LinkHead(int32 Cell)
+{
+	FIconCell& IconCell = Cells[Cell];
+	IconCell.Prev = INDEX_NONE;
+	IconCell.Next = FreeHead;
+	if (FreeHead != INDEX_NONE)
+	{
+		Cells[FreeHead].Prev = Cell;
+	}
+	else
+	{
+		FreeTail = Cell;
+	}
+	FreeHead = Cell;
+}
+
+void UInventoryIconAtlasSubsystem::LinkTail(int32 Cell)
+{
+	FIconCell& IconCell = Cells[Cell];
+	IconCell.Next = INDEX_NONE;
+	IconCell.Prev = FreeTail;
+	if (FreeTail != INDEX_NONE)
+	{
+		Cells[FreeTail].Next = Cell;
+	}
+	else
+	{
+		FreeHead = Cell;
+	}
+	FreeTail = Cell;
+}
+
+void UInventoryIconAtlasSubsystem::Unlink(int32 Cell)
+{
+	FIconCell& IconCell = Cells[Cell];
+	if (IconCell.Prev != INDEX_NONE)
+	{
+		Cells[IconCell.Prev].Next = IconCell.Next;
+	}
+	else
+	{
+		FreeHead = IconCell.Next;
+	}
+
+	if (IconCell.Next != INDEX_NONE)
+	{
+		Cells[IconCell.Next].Prev = IconCell.Prev;
+	}
+	else
+	{
+		FreeTail = IconCell.Prev;
+	}
+
+	IconCell.Prev = INDEX_NONE;
+	IconCell.Next = INDEX_NONE;
+}
@@ -0,0 +1,193 @@
+// InventoryNetLoadCommandlet.cpp
+#include "InventoryNetLoadCommandlet.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace InventoryNetLoad
+{
+	struct FProcess
+	{
+		FString Name;
+		FString TracePath;
+		FString CsvPath;
+		FProcHandle Handle;
+		int32 ReturnCode = -1;
+		bool bFinished = false;
+	};
+
+	bool Launch(FProcess& Process, const FString& Args)
+	{
+		const FString Executable = FPlatformProcess::ExecutablePath();
+		const FString Project = FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath());
+		const FString CommandLine = FString::Printf(TEXT("\"%s\" %s -unattended -nosplash -nosound -log -trace=default,net -NetTrace=1 -tracefile=\"%s\" -InventoryNetProfileCsv=\"%s\""),
+			*Project, *Args, *Process.TracePath, *Process.CsvPath);
+
+		UE_LOG(LogTemp, Display, TEXT("%s: %s %s"), *Process.Name, *Executable, *CommandLine);
+		Process.Handle = FPlatformProcess::CreateProc(*Executable, *CommandLine, true, false, false, nullptr, 0, nullptr, nullptr);
+		return Process.Handle.IsValid();
+	}
+
+	// Appends a process's rows to Merged with its name in front, summing bandwidth per connection
+	bool Merge(const FProcess& Process, TArray<FString>& Merged, TMap<FString, FVector2D>& BytesSums, TMap<FString, int32>& Samples)
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *Process.CsvPath) || Lines.Num() == 0)
+		{
+			return false;
+		}
+
+		for (int32 Index = 1; Index < Lines.Num(); ++Index)
+		{
+			TArray<FString> Columns;
+			if (Lines[Index].ParseIntoArray(Columns, TEXT(","), false) != 4)
+			{
+				continue;
+			}
+			Merged.Add(Process.Name + TEXT(",") + Lines[Index]);
+
+			const FString Key = Process.Name + TEXT(" ") + Columns[1];
+			if (Columns[2] == TEXT("InBytesPerSecond"))
+			{
+				BytesSums.FindOrAdd(Key).X += FCString::Atod(*Columns[3]);
+				++Samples.FindOrAdd(Key);
+			}
+			else if (Columns[2] == TEXT("OutBytesPerSecond"))
+			{
+				BytesSums.FindOrAdd(Key).Y += FCString::Atod(*Columns[3]);
+			}
+		}
+		return true;
+	}
+}
+
+UInventoryNetLoadCommandlet::UInventoryNetLoadCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UInventoryNetLoadCommandlet::Main(const FString& Params)
+{
+	using namespace InventoryNetLoad;
+
+	FString Map;
+	int32 Clients = 4;
+	float Seconds = 60.0f;
+	float Churn = 20.0f;
+	int32 Port = 7777;
+	float Warmup = 15.0f;
+	FString OutDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Profiling"), FString::Printf(TEXT("InventoryNetLoad_%s"), *FDateTime::Now().ToString()));
+	FParse::Value(*Params, TEXT("Map="), Map);
+	FParse::Value(*Params, TEXT("Clients="), Clients);
+	FParse::Value(*Params, TEXT("Seconds="), Seconds);
+	FParse::Value(*Params, TEXT("Churn="), Churn);
+	FParse::Value(*Params, TEXT("Port="), Port);
+	FParse::Value(*Params, TEXT("Warmup="), Warmup);
+	FParse::Value(*Params, TEXT("Out="), OutDir);
+	Clients = FMath::Max(1, Clients);
+	OutDir = FPaths::ConvertRelativePathToFull(OutDir);
+
+	if (Map.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("InventoryNetLoad needs -Map=<map to host>"));
+		return 1;
+	}
+	IFileManager::Get().MakeDirectory(*OutDir, true);
+
+	// The server's window spans the clients joining, so their whole run sees churn
+	TArray<FProcess> Processes;
+	FProcess& Server = Processes.AddDefaulted_GetRef();
+	Server.Name = TEXT("Server");
+	Server.TracePath = FPaths::Combine(OutDir, TEXT("Server.utrace"));
+	Server.CsvPath = FPaths::Combine(OutDir, TEXT("Server.csv"));
+	const FString ServerArgs = FString::Printf(TEXT("%s -server -port=%d -InventoryNetProfile=%.0f -InventoryChurn=%.1f -InventoryNetProfileQuit"),
+		*Map, Port, Warmup + Seconds + Warmup, Churn);
+	if (!Launch(Server, ServerArgs))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not launch the server"));
+		return 1;
+	}
+
+	FPlatformProcess::Sleep(Warmup);
+
+	for (int32 Index = 0; Index < Clients; ++Index)
+	{
+		FProcess& Client = Processes.AddDefaulted_GetRef();
+		Client.Name = FString::Printf(TEXT("Client%d"), Index);
+		Client.TracePath = FPaths::Combine(OutDir, Client.Name + TEXT(".utrace"));
+		Client.CsvPath = FPaths::Combine(OutDir, Client.Name + TEXT(".csv"));
+		const FString ClientArgs = FString::Printf(TEXT("127.0.0.1:%d -game -nullrhi -InventoryNetProfile=%.0f -InventoryNetProfileQuit"), Port, Seconds);
+		if (!Launch(Client, ClientArgs))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Could not launch %s"), *Client.Name);
+			Processes.Pop();
+		}
+	}
+
+	// Anything still running well past its window has hung; a client that never connected never starts recording
+	const double Deadline = FPlatformTime::Seconds() + Warmup + Seconds + 120.0;
+	bool bAllFinished = false;
+	while (!bAllFinished)
+	{
+		bAllFinished = true;
+		for (FProcess& Process : Processes)
+		{
+			if (Process.bFinished)
+			{
+				continue;
+			}
+
+			if (!FPlatformProcess::IsProcRunning(Process.Handle))
+			{
+				FPlatformProcess::GetProcReturnCode(Process.Handle, &Process.ReturnCode);
+				Process.bFinished = true;
+			}
+			else if (FPlatformTime::Seconds() > Deadline)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("%s did not finish in time; terminating it"), *Process.Name);
+				FPlatformProcess::TerminateProc(Process.Handle, true);
+				Process.bFinished = true;
+			}
+			else
+			{
+				bAllFinished = false;
+			}
+		}
+		FPlatformProcess::Sleep(0.5f);
+	}
+
+	int32 Failures = Clients + 1 - Processes.Num();
+	TArray<FString> Merged = { TEXT("Process,Time,Connection,Stat,Value") };
+	TMap<FString, FVector2D> BytesSums;
+	TMap<FString, int32> Samples;
+	for (FProcess& Process : Processes)
+	{
+		FPlatformProcess::CloseProc(Process.Handle);
+		const bool bTraced = IFileManager::Get().FileExists(*Process.TracePath);
+		const bool bMerged = Merge(Process, Merged, BytesSums, Samples);
+		UE_LOG(LogTemp, Display, TEXT("%s exited with %d, CSV %s, trace %s"), *Process.Name, Process.ReturnCode,
+			bMerged ? *Process.CsvPath : TEXT("missing"), bTraced ? *Process.TracePath : TEXT("missing"));
+		Failures += Process.ReturnCode != 0 || !bMerged || !bTraced ? 1 : 0;
+	}
+
+	const FString MergedPath = FPaths::Combine(OutDir, TEXT("InventoryNetLoad.csv"));
+	if (!FFileHelper::SaveStringArrayToFile(Merged, *MergedPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not write %s"), *MergedPath);
+		++Failures;
+	}
+
+	for (const TPair<FString, int32>& Sample : Samples)
+	{
+		const FVector2D Average = BytesSums[Sample.Key] / Sample.Value;
+		UE_LOG(LogTemp, Display, TEXT("%s: %.0f B/s in, %.0f B/s out"), *Sample.Key, Average.X, Average.Y);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Inventory net load: %d clients for %.0fs at %.1f ops/s per player, %d process(es) failed"), Clients, Seconds, Churn, Failures);
+	return Failures == 0 ? 0 : 1;
+}
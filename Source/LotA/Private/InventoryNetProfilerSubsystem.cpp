@@ -0,0 +1,548 @@
+// InventoryNetProfilerSubsystem.cpp
+#include "InventoryNetProfilerSubsystem.h"
+#include "BagComponent.h"
+#include "EquipmentComponent.h"
+#include "InventoryRegistryComponent.h"
+#include "InventoryRouterComponent.h"
+#include "InventorySlotDataComponent.h"
+#include "ItemBase.h"
+#include "LootSubsystem.h"
+#include "LootTable.h"
+#include "EngineUtils.h"
+#include "Engine/NetConnection.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Paths.h"
+#include "Net/Core/Trace/NetTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "ProfilingDebugging/TraceAuxiliary.h"
+
+namespace
+{
+	FString MakeDefaultPath(const UWorld& World, const TCHAR* Extension)
+	{
+		const TCHAR* Role = World.GetNetMode() == NM_Client ? TEXT("Client") : TEXT("Server");
+		const FString FileName = FString::Printf(TEXT("InventoryNet_%s_%d_%s.%s"), Role, FPlatformProcess::GetCurrentProcessId(), *FDateTime::Now().ToString(), Extension);
+		return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Profiling"), FileName);
+	}
+
+	bool IsModuleClass(const UClass* Class)
+	{
+		static const UPackage* ModulePackage = UBagComponent::StaticClass()->GetOutermost();
+		return Class && Class->GetOutermost() == ModulePackage;
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs NetProfileCommand(
+		TEXT("LotA.NetProfile"),
+		TEXT("Record inventory network traffic to CSV and a trace. Args: <Seconds> [ChurnOpsPerSecond]. 0 seconds stops."),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UInventoryNetProfilerSubsystem* Profiler = UInventoryNetProfilerSubsystem::Get(World);
+			if (!Profiler)
+			{
+				return;
+			}
+
+			const float Seconds = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 60.0f;
+			const float Churn = Args.Num() > 1 ? FCString::Atof(*Args[1]) : 0.0f;
+			if (Seconds <= 0.0f)
+			{
+				Profiler->StopRecording();
+			}
+			else
+			{
+				Profiler->StartRecording(Seconds, Churn, MakeDefaultPath(*World, TEXT("csv")), MakeDefaultPath(*World, TEXT("utrace")));
+			}
+		}));
+}
+
+UInventoryNetProfilerSubsystem* UInventoryNetProfilerSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UInventoryNetProfilerSubsystem>() : nullptr;
+}
+
+TStatId UInventoryNetProfilerSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UInventoryNetProfilerSubsystem, STATGROUP_Tickables);
+}
+
+void UInventoryNetProfilerSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	float Seconds = 0.0f;
+	if (InWorld.IsGameWorld() && FParse::Value(FCommandLine::Get(), TEXT("InventoryNetProfile="), Seconds) && Seconds > 0.0f)
+	{
+		float Churn = 0.0f;
+		FParse::Value(FCommandLine::Get(), TEXT("InventoryChurn="), Churn);
+		bQuitWhenDone = FParse::Param(FCommandLine::Get(), TEXT("InventoryNetProfileQuit"));
+		FString CsvPath = MakeDefaultPath(InWorld, TEXT("csv"));
+		FParse::Value(FCommandLine::Get(), TEXT("InventoryNetProfileCsv="), CsvPath);
+		StartRecording(Seconds, Churn, CsvPath, MakeDefaultPath(InWorld, TEXT("utrace")));
+	}
+}
+
+void UInventoryNetProfilerSubsystem::Deinitialize()
+{
+	// A world change cuts the window short; that isn't the end of a launched run
+	bQuitWhenDone = false;
+	StopRecording();
+
+	Super::Deinitialize();
+}
+
+void UInventoryNetProfilerSubsystem::StartRecording(float Seconds, float ChurnOpsPerSecond, const FString& CsvPath, const FString& TracePath)
+{
+	StopRecording();
+
+	CsvFile.Reset(IFileManager::Get().CreateFileWriter(*CsvPath, FILEWRITE_AllowRead));
+	if (!CsvFile)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not open %s for inventory net profiling"), *CsvPath);
+		return;
+	}
+	CsvFilePath = CsvPath;
+	const FTCHARToUTF8 Header(TEXT("Time,Connection,Stat,Value\n"));
+	CsvFile->Serialize(const_cast<ANSICHAR*>(Header.Get()), Header.Length());
+
+#if UE_TRACE_ENABLED
+	// Launched runs trace from process start with -trace; otherwise trace just this window
+	if (!FTraceAuxiliary::IsConnected())
+	{
+		bOwnsTrace = FTraceAuxiliary::Start(FTraceAuxiliary::EConnectionType::File, *TracePath, TEXT("default,net"));
+		UE_CLOG(!bOwnsTrace, LogTemp, Warning, TEXT("Could not start a trace to %s; recording the CSV only"), *TracePath);
+	}
+#endif
+
+#if UE_NET_TRACE_ENABLED
+	// The trace only breaks bits down per property and RPC with net tracing on, which -NetTrace does at startup
+	if (FNetTrace::GetNetTraceVerbosity() == 0)
+	{
+		FNetTrace::SetTraceVerbosity(1);
+	}
+#endif
+
+	bRecording = true;
+	RecordingStartTime = GetWorld()->GetRealTimeSeconds();
+	RecordingEndTime = RecordingStartTime + Seconds;
+	NextSampleTime = RecordingStartTime + 1.0;
+	Counts.Reset();
+	HookRPCs();
+	TRACE_BOOKMARK(TEXT("InventoryNetProfile start"));
+
+	// Churn only makes sense where the inventory is authoritative
+	ChurnRate = GetWorld()->GetNetMode() == NM_Client ? 0.0f : FMath::Max(0.0f, ChurnOpsPerSecond);
+	ChurnBudget = 0.0f;
+	ChurnStream.Initialize(0x4C6F7441);
+
+	LoadedChurnTable = ChurnRate > 0.0f ? ChurnLootTable.LoadSynchronous() : nullptr;
+	UE_CLOG(ChurnRate > 0.0f && !LoadedChurnTable, LogTemp, Warning, TEXT("No ChurnLootTable configured; inventory churn won't grant loot"));
+
+	UE_LOG(LogTemp, Log, TEXT("Inventory net profiling for %.0fs (churn %.1f ops/s per player) into %s"), Seconds, ChurnRate, *CsvPath);
+}
+
+void UInventoryNetProfilerSubsystem::StopRecording()
+{
+	if (!bRecording)
+	{
+		return;
+	}
+
+	bRecording = false;
+	ChurnRate = 0.0f;
+	LoadedChurnTable = nullptr;
+	TRACE_BOOKMARK(TEXT("InventoryNetProfile end"));
+
+	UnhookRPCs();
+	for (TPair<TObjectKey<UActorComponent>, FPropertyShadow>& Shadow : Shadows)
+	{
+		FreeShadow(Shadow.Value);
+	}
+	Shadows.Reset();
+	Counts.Reset();
+
+	CsvFile->Close();
+	CsvFile.Reset();
+
+#if UE_TRACE_ENABLED
+	if (bOwnsTrace)
+	{
+		FTraceAuxiliary::Stop();
+		bOwnsTrace = false;
+	}
+#endif
+
+	UE_LOG(LogTemp, Log, TEXT("Inventory net profile written to %s; the trace has the per-bit breakdown for Networking Insights"), *CsvFilePath);
+
+	if (bQuitWhenDone)
+	{
+		RequestEngineExit(TEXT("Inventory net profile finished"));
+	}
+}
+
+void UInventoryNetProfilerSubsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (!IsRecording())
+	{
+		return;
+	}
+
+	// Clients only get their driver once connected
+	HookRPCs();
+	RunChurn(DeltaTime);
+	CountPropertyChanges();
+
+	const double Now = GetWorld()->GetRealTimeSeconds();
+	if (Now >= NextSampleTime)
+	{
+		WriteSample(Now);
+		NextSampleTime += 1.0;
+	}
+
+	if (Now >= RecordingEndTime)
+	{
+		StopRecording();
+	}
+}
+
+void UInventoryNetProfilerSubsystem::WriteSample(double Now)
+{
+	const double Time = Now - RecordingStartTime;
+
+	if (const UNetDriver* Driver = GetWorld()->GetNetDriver())
+	{
+		TArray<const UNetConnection*, TInlineAllocator<16>> Connections;
+		if (Driver->ServerConnection)
+		{
+			Connections.Add(Driver->ServerConnection);
+		}
+		for (const UNetConnection* Connection : Driver->ClientConnections)
+		{
+			Connections.Add(Connection);
+		}
+
+		// The connection refreshes these once per stat period, a second by default
+		for (const UNetConnection* Connection : Connections)
+		{
+			const FString Name = DescribeConnection(Connection);
+			WriteRow(Time, Name, TEXT("InBytesPerSecond"), Connection->InBytesPerSecond);
+			WriteRow(Time, Name, TEXT("OutBytesPerSecond"), Connection->OutBytesPerSecond);
+			WriteRow(Time, Name, TEXT("InPacketsPerSecond"), Connection->InPacketsPerSecond);
+			WriteRow(Time, Name, TEXT("OutPacketsPerSecond"), Connection->OutPacketsPerSecond);
+		}
+	}
+
+	for (const TPair<FString, TMap<FString, int32>>& Connection : Counts)
+	{
+		for (const TPair<FString, int32>& Count : Connection.Value)
+		{
+			WriteRow(Time, Connection.Key, Count.Key, Count.Value);
+		}
+	}
+	Counts.Reset();
+
+	CsvFile->Flush();
+}
+
+void UInventoryNetProfilerSubsystem::WriteRow(double Time, const FString& Connection, const FString& Stat, double Value)
+{
+	const FString Line = FString::Printf(TEXT("%.2f,%s,%s,%.0f\n"), Time, *Connection, *Stat, Value);
+	const FTCHARToUTF8 Utf8(*Line);
+	CsvFile->Serialize(const_cast<ANSICHAR*>(Utf8.Get()), Utf8.Length());
+}
+
+void UInventoryNetProfilerSubsystem::CountPropertyChanges()
+{
+	// Only replication writes these on clients and only game code on the server, so a change between
+	// ticks is an update received on a client and one to be sent on the server
+	TSet<TObjectKey<UActorComponent>> Seen;
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		AActor* Actor = *It;
+		if (!Actor->GetIsReplicated())
+		{
+			continue;
+		}
+
+		for (UActorComponent* Component : Actor->GetReplicatedComponents())
+		{
+			if (!IsTracked(Component))
+			{
+				continue;
+			}
+			Seen.Add(Component);
+
+			UClass* Class = Component->GetClass();
+			FPropertyShadow* Shadow = Shadows.Find(Component);
+			const bool bFirstSeen = Shadow == nullptr;
+			if (bFirstSeen)
+			{
+				if (!Class->HasAnyClassFlags(CLASS_ReplicationDataIsSetUp))
+				{
+					Class->SetUpRuntimeReplicationData();
+				}
+
+				Shadow = &Shadows.Add(Component);
+				Shadow->Class = Class;
+				Shadow->Values = static_cast<uint8*>(FMemory::Malloc(Class->GetPropertiesSize(), Class->GetMinAlignment()));
+				for (const FRepRecord& Rep : Class->ClassReps)
+				{
+					if (Rep.Index == 0 && IsModuleClass(Rep.Property->GetOwnerClass()))
+					{
+						Rep.Property->InitializeValue_InContainer(Shadow->Values);
+					}
+				}
+			}
+
+			FString Connection;
+			for (const FRepRecord& Rep : Class->ClassReps)
+			{
+				if (!IsModuleClass(Rep.Property->GetOwnerClass()))
+				{
+					continue;
+				}
+
+				void* Previous = Rep.Property->ContainerPtrToValuePtr<void>(Shadow->Values, Rep.Index);
+				const void* Current = Rep.Property->ContainerPtrToValuePtr<void>(Component, Rep.Index);
+				if (Rep.Property->Identical(Previous, Current))
+				{
+					continue;
+				}
+
+				// What a component starts out with isn't a change
+				if (!bFirstSeen)
+				{
+					if (Connection.IsEmpty())
+					{
+						Connection = DescribeConnection(Actor);
+					}
+					++Counts.FindOrAdd(Connection).FindOrAdd(FString::Printf(TEXT("Property:%s.%s"), *Class->GetName(), *Rep.Property->GetName()));
+				}
+				Rep.Property->CopySingleValue(Previous, Current);
+			}
+		}
+	}
+
+	for (auto It = Shadows.CreateIterator(); It; ++It)
+	{
+		if (!Seen.Contains(It.Key()))
+		{
+			FreeShadow(It.Value());
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UInventoryNetProfilerSubsystem::FreeShadow(FPropertyShadow& Shadow)
+{
+	if (!Shadow.Values)
+	{
+		return;
+	}
+
+	for (const FRepRecord& Rep : Shadow.Class->ClassReps)
+	{
+		if (Rep.Index == 0 && IsModuleClass(Rep.Property->GetOwnerClass()))
+		{
+			Rep.Property->DestroyValue_InContainer(Shadow.Values);
+		}
+	}
+	FMemory::Free(Shadow.Values);
+	Shadow.Values = nullptr;
+}
+
+void UInventoryNetProfilerSubsystem::HookRPCs()
+{
+#if !UE_BUILD_SHIPPING
+	UNetDriver* Driver = GetWorld()->GetNetDriver();
+	if (!Driver || HookedDriver.Get() == Driver)
+	{
+		return;
+	}
+
+	UnhookRPCs();
+	HookedDriver = Driver;
+
+	// The hook takes one listener; leave it to whoever had it first
+	if (Driver->SendRPCDel.IsBound())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("The net driver's RPC hook is taken; inventory RPCs won't be counted"));
+		return;
+	}
+	Driver->SendRPCDel.BindUObject(this, &UInventoryNetProfilerSubsystem::HandleSendRPC);
+#endif
+}
+
+void UInventoryNetProfilerSubsystem::UnhookRPCs()
+{
+#if !UE_BUILD_SHIPPING
+	UNetDriver* Driver = HookedDriver.Get();
+	if (Driver && Driver->SendRPCDel.IsBoundToObject(this))
+	{
+		Driver->SendRPCDel.Unbind();
+	}
+#endif
+	HookedDriver.Reset();
+}
+
+void UInventoryNetProfilerSubsystem::HandleSendRPC(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject, bool& bBlockSendRPC)
+{
+	const UObject* Caller = SubObject ? SubObject : Actor;
+	if (Function && IsTracked(Caller))
+	{
+		++Counts.FindOrAdd(DescribeConnection(Actor)).FindOrAdd(FString::Printf(TEXT("RPC:%s.%s"), *Caller->GetClass()->GetName(), *Function->GetName()));
+	}
+}
+
+bool UInventoryNetProfilerSubsystem::IsTracked(const UObject* Object)
+{
+	// Blueprint subclasses count through their native parent
+	for (const UClass* Class = Object ? Object->GetClass() : nullptr; Class; Class = Class->GetSuperClass())
+	{
+		if (Class->HasAnyClassFlags(CLASS_Native))
+		{
+			return IsModuleClass(Class);
+		}
+	}
+	return false;
+}
+
+FString UInventoryNetProfilerSubsystem::DescribeConnection(const AActor* Actor) const
+{
+	// A client only hears from the server; on the server, unowned actors go to every relevant client
+	const UNetConnection* Connection = Actor ? Actor->GetNetConnection() : nullptr;
+	if (!Connection && GetWorld()->GetNetMode() == NM_Client)
+	{
+		const UNetDriver* Driver = GetWorld()->GetNetDriver();
+		Connection = Driver ? Driver->ServerConnection : nullptr;
+	}
+	return Connection ? DescribeConnection(Connection) : FString(TEXT("Broadcast"));
+}
+
+FString UInventoryNetProfilerSubsystem::DescribeConnection(const UNetConnection* Connection) const
+{
+	const UNetDriver* Driver = GetWorld()->GetNetDriver();
+	if (Driver && Connection == Driver->ServerConnection)
+	{
+		return TEXT("Server");
+	}
+
+	const APlayerController* PlayerController = Connection->PlayerController;
+	const FString PlayerName = PlayerController && PlayerController->PlayerState ? PlayerController->PlayerState->GetPlayerName() : FString();
+	const FString Address = Connection->LowLevelGetRemoteAddress(true);
+
+	// Commas would break the CSV columns
+	return (PlayerName.IsEmpty() ? Address : FString::Printf(TEXT("%s (%s)"), *PlayerName, *Address)).Replace(TEXT(","), TEXT(" "));
+}
+
+void UInventoryNetProfilerSubsystem::RunChurn(float DeltaTime)
+{
+	if (ChurnRate <= 0.0f)
+	{
+		return;
+	}
+
+	ChurnBudget += ChurnRate * DeltaTime;
+	const int32 NumOps = FMath::FloorToInt(ChurnBudget);
+	if (NumOps <= 0)
+	{
+		return;
+	}
+	ChurnBudget -= NumOps;
+
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (APlayerController* PlayerController = It->Get())
+		{
+			for (int32 Op = 0; Op < NumOps; ++Op)
+			{
+				ChurnPlayer(PlayerController);
+			}
+		}
+	}
+}
+
+void UInventoryNetProfilerSubsystem::ChurnPlayer(APlayerController* Player)
+{
+	UInventoryRouterComponent* Router = Player->FindComponentByClass<UInventoryRouterComponent>();
+	if (!Router)
+	{
+		return;
+	}
+
+	TArray<UBagComponent*> Bags;
+	UInventoryRegistryComponent::GetBagsOf(Player, Bags);
+	Bags.RemoveAll([](const UBagComponent* Bag) { return Bag->GetInventorySlots().Num() == 0; });
+	if (Bags.Num() == 0)
+	{
+		return;
+	}
+
+	auto RandomSlot = [this, &Bags]() -> UInventorySlotDataComponent*
+	{
+		const TArray<UInventorySlotDataComponent*>& Slots = Bags[ChurnStream.RandHelper(Bags.Num())]->GetInventorySlots();
+		return Slots[ChurnStream.RandHelper(Slots.Num())];
+	};
+
+	auto SlotPayload = [](const UInventorySlotDataComponent* Slot, int32 Count)
+	{
+		FInventoryDragPayload Payload;
+		Payload.Source = FInventoryContainerHandle::ForBag(Slot->GetOwningBag());
+		Payload.SlotIndex = Slot->GetSlotIndex();
+		Payload.ItemID = Slot->GetItemData().ItemID;
+		Payload.Count = Count;
+		return Payload;
+	};
+
+	// Roughly the mix of a looting session: mostly pickups and shuffling, some destroying, a rare bag swap
+	const int32 Roll = ChurnStream.RandHelper(100);
+	if (Roll < 40)
+	{
+		// Loot, rolled and granted the way a kill grants it
+		ULootSubsystem* Loot = ULootSubsystem::Get(this);
+		if (Loot && LoadedChurnTable)
+		{
+			Loot->QueueGrant(Player, LoadedChurnTable, 1, Bags[ChurnStream.RandHelper(Bags.Num())], AItemBase::StaticClass());
+		}
+	}
+	else if (Roll < 75)
+	{
+		// Move, through the same router path a client drag takes
+		UInventorySlotDataComponent* Source = RandomSlot();
+		UInventorySlotDataComponent* Target = RandomSlot();
+		if (Source && Target && Source != Target && !Source->IsEmpty())
+		{
+			Router->RouteDrop(SlotPayload(Source, Source->GetStackCount()), FInventoryContainerHandle::ForBag(Target->GetOwningBag()), Target->GetSlotIndex());
+		}
+	}
+	else if (Roll < 95)
+	{
+		// Destroy, so bags don't just fill up and stop changing
+		UInventorySlotDataComponent* Slot = RandomSlot();
+		if (Slot && !Slot->IsEmpty())
+		{
+			Router->RouteDrop(SlotPayload(Slot, ChurnStream.RandRange(1, Slot->GetStackCount())), FInventoryContainerHandle::ForKind(EInventoryContainerKind::Destroy), INDEX_NONE);
+		}
+	}
+	else
+	{
+		// Bag swap, with a looted bag
+		UInventorySlotDataComponent* Slot = RandomSlot();
+		const APawn* Pawn = Player->GetPawn();
+		UEquipmentComponent* Equipment = Pawn ? Pawn->FindComponentByClass<UEquipmentComponent>() : nullptr;
+		if (Slot && Equipment && !Slot->IsEmpty() && Slot->GetItemData().ItemType == EItemType::Bag)
+		{
+			const int32 BagSlot = static_cast<int32>(EEquipmentSlot::Bag1) + ChurnStream.RandHelper(4);
+			Router->RouteDrop(SlotPayload(Slot, 1), FInventoryContainerHandle::ForEquipment(Equipment), BagSlot);
+		}
+	}
+}
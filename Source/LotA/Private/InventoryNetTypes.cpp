@@ -0,0 +1,108 @@
+// InventoryNetTypes.cpp
+#include "InventoryNetTypes.h"
+#include "ItemRegistrySubsystem.h"
+#include "UObject/CoreNet.h"
+
+int32 FItemNetReference::SerializeItemID(FArchive& Ar, FName& ItemID)
+{
+	UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+	const int32 NumIndexed = Registry ? Registry->GetNumNetIndexed() : 0;
+
+	uint32 Index = 0;
+	uint8 bIndexed = 0;
+	if (Ar.IsSaving())
+	{
+		const int32 FoundIndex = Registry ? Registry->FindItemIndex(ItemID) : INDEX_NONE;
+		bIndexed = FoundIndex != INDEX_NONE && FoundIndex < NumIndexed;
+		Index = bIndexed ? static_cast<uint32>(FoundIndex) : 0;
+	}
+
+	Ar.SerializeBits(&bIndexed, 1);
+	if (!bIndexed)
+	{
+		UPackageMap::StaticSerializeName(Ar, ItemID);
+		return INDEX_NONE;
+	}
+
+	// Both ends run the same build, so they agree on the table size and on what each index means
+	Ar.SerializeInt(Index, static_cast<uint32>(FMath::Max(NumIndexed, 2)));
+	if (Ar.IsLoading())
+	{
+		const FItemRegistryEntry* Entry = Registry ? Registry->GetEntry(Index) : nullptr;
+		ItemID = Entry ? Entry->Info.ItemID : NAME_None;
+		if (!Entry)
+		{
+			Ar.SetError();
+		}
+	}
+	return static_cast<int32>(Index);
+}
+
+bool FItemNetReference::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	SerializeItemID(Ar, ItemID);
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
+
+bool FInventorySlotNetData::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	uint8 bOccupied = Count > 0 && !ItemID.IsNone();
+	Ar.SerializeBits(&bOccupied, 1);
+	if (!bOccupied)
+	{
+		if (Ar.IsLoading())
+		{
+			*this = FInventorySlotNetData();
+		}
+		bOutSuccess = true;
+		return true;
+	}
+
+	const int32 RegistryIndex = FItemNetReference::SerializeItemID(Ar, ItemID);
+
+	// Counts of cooked items are bounded by their stack size, which both ends look up the same way
+	const UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+	const FItemRegistryEntry* Entry = Registry ? Registry->GetEntry(RegistryIndex) : nullptr;
+	const int32 MaxStack = Entry ? Entry->Info.GetMaxStack() : 0;
+
+	uint8 bBounded = MaxStack > 0 && Count >= 1 && Count <= MaxStack;
+	Ar.SerializeBits(&bBounded, 1);
+	if (bBounded)
+	{
+		// A stack of unstackables is always one and costs nothing
+		uint32 CountMinusOne = static_cast<uint32>(Count - 1);
+		if (MaxStack > 1)
+		{
+			Ar.SerializeInt(CountMinusOne, static_cast<uint32>(MaxStack));
+		}
+		else
+		{
+			CountMinusOne = 0;
+		}
+		Count = static_cast<int32>(CountMinusOne) + 1;
+	}
+	else
+	{
+		uint32 PackedCount = static_cast<uint32>(FMath::Max(Count, 0));
+		Ar.SerializeIntPacked(PackedCount);
+		Count = static_cast<int32>(PackedCount);
+	}
+
+	uint8 bHasInstance = Instance.IsValid();
+	Ar.SerializeBits(&bHasInstance, 1);
+	if (bHasInstance)
+	{
+		uint32 InstanceIndex = static_cast<uint32>(Instance.Index);
+		Ar.SerializeIntPacked(InstanceIndex);
+		Ar.SerializeIntPacked(Instance.Serial);
+		Instance.Index = static_cast<int32>(InstanceIndex);
+	}
+	else if (Ar.IsLoading())
+	{
+		Instance = FItemInstanceHandle();
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return true;
+}
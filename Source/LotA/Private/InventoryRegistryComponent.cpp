@@ -0,0 +1,230 @@
+// InventoryRegistryComponent.cpp
+#include "InventoryRegistryComponent.h"
+#include "LotAPlayerController.h"
+#include "GameFramework/Pawn.h"
+#include "Net/UnrealNetwork.h"
+
+UInventoryRegistryComponent::UInventoryRegistryComponent()
+	: NextHandle(0)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void UInventoryRegistryComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UInventoryRegistryComponent, Containers);
+}
+
+UInventoryRegistryComponent* UInventoryRegistryComponent::FindForActor(const AActor* Actor)
+{
+	const AController* Controller = Cast<AController>(Actor);
+	if (!Controller)
+	{
+		const APawn* Pawn = Cast<APawn>(Actor);
+		Controller = Pawn ? Pawn->GetController() : nullptr;
+	}
+
+	if (const ALotAPlayerController* LotAController = Cast<ALotAPlayerController>(Controller))
+	{
+		return LotAController->InventoryRegistry;
+	}
+	return Controller ? Controller->FindComponentByClass<UInventoryRegistryComponent>() : nullptr;
+}
+
+void UInventoryRegistryComponent::GetBagsOf(const AActor* Actor, TArray<UBagComponent*>& OutBags)
+{
+	OutBags.Reset();
+
+	const UInventoryRegistryComponent* Registry = FindForActor(Actor);
+	if (Registry && Registry->ListsBagsOf(Actor))
+	{
+		OutBags.Append(Registry->Bags);
+	}
+	else if (Actor)
+	{
+		Actor->GetComponents<UBagComponent>(OutBags);
+	}
+}
+
+void UInventoryRegistryComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	// Clients take the list from the server
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		return;
+	}
+
+	if (AController* Controller = Cast<AController>(GetOwner()))
+	{
+		if (APlayerController* PlayerController = Cast<APlayerController>(Controller))
+		{
+			NewPawnHandle = PlayerController->GetOnNewPawnNotifier().AddUObject(this, &UInventoryRegistryComponent::HandleNewPawn);
+		}
+		HandleNewPawn(Controller->GetPawn());
+	}
+}
+
+void UInventoryRegistryComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (APlayerController* PlayerController = Cast<APlayerController>(GetOwner()))
+	{
+		PlayerController->GetOnNewPawnNotifier().Remove(NewPawnHandle);
+	}
+
+	RemoveAllContainers();
+	TrackedPawn.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+bool UInventoryRegistryComponent::ListsBagsOf(const AActor* Actor) const
+{
+	if (Actor == GetOwner())
+	{
+		return true;
+	}
+
+	// Between a pawn's possession and the controller's SetPawn the server still lists the previous pawn
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		return Actor && TrackedPawn.Get() == Actor;
+	}
+
+	const AController* Controller = Cast<AController>(GetOwner());
+	return Actor && Controller && Controller->GetPawn() == Actor;
+}
+
+int32 UInventoryRegistryComponent::GetContainerHandle(const UBagComponent* Bag) const
+{
+	const int32* Handle = HandleByBag.Find(Bag);
+	return Handle ? *Handle : INDEX_NONE;
+}
+
+UBagComponent* UInventoryRegistryComponent::GetBagByHandle(int32 Handle) const
+{
+	const int32* Index = IndexByHandle.Find(Handle);
+	return Index ? Containers[*Index].Bag.Get() : nullptr;
+}
+
+void UInventoryRegistryComponent::RegisterContainer(UBagComponent* Bag)
+{
+	if (!Bag || GetOwnerRole() != ROLE_Authority || !TrackedPawn.IsValid() || Bag->GetOwner() != TrackedPawn.Get() || HandleByBag.Contains(Bag))
+	{
+		return;
+	}
+
+	FInventoryContainerEntry& Entry = Containers.AddDefaulted_GetRef();
+	Entry.Handle = NextHandle++;
+	Entry.Bag = Bag;
+	RebuildLookups();
+
+	OnContainerAdded.Broadcast(Bag);
+}
+
+void UInventoryRegistryComponent::UnregisterContainer(UBagComponent* Bag)
+{
+	if (!Bag || GetOwnerRole() != ROLE_Authority)
+	{
+		return;
+	}
+
+	const int32* Handle = HandleByBag.Find(Bag);
+	if (!Handle)
+	{
+		return;
+	}
+
+	// Keep registration order; a swap-remove would reorder the bags
+	Containers.RemoveAt(IndexByHandle.FindChecked(*Handle));
+	RebuildLookups();
+
+	OnContainerRemoved.Broadcast(Bag);
+}
+
+void UInventoryRegistryComponent::HandleNewPawn(APawn* NewPawn)
+{
+	if (TrackedPawn.Get() == NewPawn)
+	{
+		return;
+	}
+
+	RemoveAllContainers();
+	TrackedPawn = NewPawn;
+
+	// Bags that registered before the pawn was possessed are picked up once here; later ones register themselves
+	if (NewPawn)
+	{
+		TArray<UBagComponent*> PawnBags;
+		NewPawn->GetComponents<UBagComponent>(PawnBags);
+		for (UBagComponent* Bag : PawnBags)
+		{
+			if (Bag->IsRegistered())
+			{
+				RegisterContainer(Bag);
+			}
+		}
+	}
+}
+
+void UInventoryRegistryComponent::RemoveAllContainers()
+{
+	const TArray<UBagComponent*> RemovedBags = MoveTemp(Bags);
+	Containers.Reset();
+	RebuildLookups();
+
+	for (UBagComponent* Bag : RemovedBags)
+	{
+		if (Bag)
+		{
+			OnContainerRemoved.Broadcast(Bag);
+		}
+	}
+}
+
+void UInventoryRegistryComponent::OnRep_Containers()
+{
+	// Entries whose bag hasn't resolved yet come through again once it has
+	const TArray<UBagComponent*> PreviousBags = Bags;
+	RebuildLookups();
+
+	for (UBagComponent* Bag : PreviousBags)
+	{
+		if (Bag && !Bags.Contains(Bag))
+		{
+			OnContainerRemoved.Broadcast(Bag);
+		}
+	}
+
+	for (UBagComponent* Bag : Bags)
+	{
+		if (!PreviousBags.Contains(Bag))
+		{
+			OnContainerAdded.Broadcast(Bag);
+		}
+	}
+}
+
+void UInventoryRegistryComponent::RebuildLookups()
+{
+	Bags.Reset(Containers.Num());
+	IndexByHandle.Reset();
+	HandleByBag.Reset();
+
+	for (int32 Index = 0; Index < Containers.Num(); ++Index)
+	{
+		const FInventoryContainerEntry& Entry = Containers[Index];
+		IndexByHandle.Add(Entry.Handle, Index);
+
+		// Unresolved on a client until the bag itself replicates
+		if (Entry.Bag)
+		{
+			Bags.Add(Entry.Bag);
+			HandleByBag.Add(Entry.Bag, Entry.Handle);
+		}
+	}
+}
@@ -0,0 +1,473 @@
+// InventoryRouterComponent.cpp
+#include "InventoryRouterComponent.h"
+#include "BagComponent.h"
+#include "InventoryRegistryComponent.h"
+#include "EquipmentComponent.h"
+#include "InventorySlotDataComponent.h"
+#include "InventoryAudit.h"
+#include "InventoryCommandSubsystem.h"
+#include "ItemBase.h"
+#include "ItemInstanceSubsystem.h"
+#include "TradeSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/Pawn.h"
+
+namespace
+{
+	UInventorySlotDataComponent* GetBagSlot(const UBagComponent* Bag, int32 SlotIndex)
+	{
+		if (!Bag)
+		{
+			return nullptr;
+		}
+
+		const TArray<UInventorySlotDataComponent*>& Slots = Bag->GetInventorySlots();
+		return Slots.IsValidIndex(SlotIndex) ? Slots[SlotIndex] : nullptr;
+	}
+
+	// What a transfer is recorded as in the audit log
+	EInventoryAuditOp AuditOpFor(EInventoryContainerKind Source, EInventoryContainerKind Destination)
+	{
+		switch (Destination)
+		{
+		case EInventoryContainerKind::World:     return EInventoryAuditOp::WorldDrop;
+		case EInventoryContainerKind::Destroy:   return EInventoryAuditOp::Destroy;
+		case EInventoryContainerKind::Equipment: return EInventoryAuditOp::Equip;
+		default:
+			return Source == EInventoryContainerKind::Equipment ? EInventoryAuditOp::Unequip : EInventoryAuditOp::Transfer;
+		}
+	}
+
+	bool ToEquipmentSlot(int32 Index, EEquipmentSlot& OutSlot)
+	{
+		if (Index <= static_cast<int32>(EEquipmentSlot::None) || Index >= static_cast<int32>(EEquipmentSlot::MAX))
+		{
+			return false;
+		}
+
+		OutSlot = static_cast<EEquipmentSlot>(Index);
+		return true;
+	}
+}
+
+UInventoryRouterComponent::UInventoryRouterComponent()
+	: WorldDropDistance(100.0f)
+	, PickupRange(300.0f)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+
+	WorldDropClass = AItemBase::StaticClass();
+}
+
+void UInventoryRouterComponent::RouteDrop(const FInventoryDragPayload& Payload, const FInventoryContainerHandle& Destination, int32 DestinationIndex)
+{
+	// Cheap rejections stay local; everything else is decided by the server
+	if (Payload.Count <= 0 || !Payload.Source.IsValid() || !Destination.IsValid())
+	{
+		return;
+	}
+
+	if (Payload.Source == Destination && Payload.SlotIndex == DestinationIndex)
+	{
+		return;
+	}
+
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		QueueTransfer(Payload, Destination, DestinationIndex);
+	}
+	else
+	{
+		ServerRouteDrop(Payload, Destination, DestinationIndex);
+	}
+}
+
+void UInventoryRouterComponent::ServerRouteDrop_Implementation(const FInventoryDragPayload& Payload, const FInventoryContainerHandle& Destination, int32 DestinationIndex)
+{
+	QueueTransfer(Payload, Destination, DestinationIndex);
+}
+
+void UInventoryRouterComponent::PickUp(AItemBase* Pickup)
+{
+	if (!Pickup)
+	{
+		return;
+	}
+
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		ExecutePickUp(Pickup);
+	}
+	else
+	{
+		ServerPickUp(Pickup);
+	}
+}
+
+void UInventoryRouterComponent::ServerPickUp_Implementation(AItemBase* Pickup)
+{
+	// Queued like drops, so it lands in order with the player's other inventory changes
+	UInventoryCommandSubsystem* Commands = UInventoryCommandSubsystem::Get(this);
+	APlayerController* PlayerController = Cast<APlayerController>(GetOwner());
+	if (!Commands || !PlayerController)
+	{
+		ExecutePickUp(Pickup);
+		return;
+	}
+
+	TWeakObjectPtr<UInventoryRouterComponent> WeakThis(this);
+	TWeakObjectPtr<AItemBase> WeakPickup(Pickup);
+	Commands->EnqueueApply(PlayerController, [WeakThis, WeakPickup]()
+	{
+		if (UInventoryRouterComponent* Router = WeakThis.Get())
+		{
+			Router->ExecutePickUp(WeakPickup.Get());
+		}
+	});
+}
+
+bool UInventoryRouterComponent::ExecutePickUp(AItemBase* Pickup)
+{
+	const APawn* Pawn = GetControlledPawn();
+	if (!IsValid(Pickup) || !Pawn || Pickup->StackCount <= 0 || Pickup->ItemDetails.ItemID.IsNone())
+	{
+		return false;
+	}
+
+	if (FVector::DistSquared(Pawn->GetActorLocation(), Pickup->GetActorLocation()) > FMath::Square(PickupRange))
+	{
+		return false;
+	}
+
+	TArray<UBagComponent*> Bags;
+	UInventoryRegistryComponent::GetBagsOf(Pawn, Bags);
+	FInventoryAuditScope AuditScope(EInventoryAuditOp::Pickup);
+
+	// The instance moves into the slot as is, so the item keeps its GUID, durability and rolls
+	if (Pickup->InstanceHandle.IsValid())
+	{
+		for (UBagComponent* Bag : Bags)
+		{
+			for (UInventorySlotDataComponent* Slot : Bag->GetInventorySlots())
+			{
+				if (Slot && Slot->PutItems(Pickup->ItemDetails, 1, Pickup->InstanceHandle))
+				{
+					Pickup->TakeInstance();
+					Pickup->Destroy();
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	int32 Remaining = Pickup->StackCount;
+	for (UBagComponent* Bag : Bags)
+	{
+		if (Remaining > 0)
+		{
+			Remaining = Bag->AddItem(Pickup->ItemDetails, Remaining);
+		}
+	}
+
+	if (Remaining == Pickup->StackCount)
+	{
+		return false;
+	}
+
+	if (Remaining > 0)
+	{
+		Pickup->StackCount = Remaining;
+	}
+	else
+	{
+		Pickup->Destroy();
+	}
+	return true;
+}
+
+void UInventoryRouterComponent::QueueTransfer(const FInventoryDragPayload& Payload, const FInventoryContainerHandle& Destination, int32 DestinationIndex)
+{
+	UInventoryCommandSubsystem* Commands = UInventoryCommandSubsystem::Get(this);
+	APlayerController* PlayerController = Cast<APlayerController>(GetOwner());
+	if (!Commands || !PlayerController)
+	{
+		ExecuteTransfer(Payload, Destination, DestinationIndex);
+		return;
+	}
+
+	// Containers are held weakly while queued; one destroyed in the meantime fails validation
+	TWeakObjectPtr<UInventoryRouterComponent> WeakThis(this);
+	TWeakObjectPtr<UActorComponent> SourceContainer(Payload.Source.Container);
+	TWeakObjectPtr<UActorComponent> DestinationContainer(Destination.Container);
+	Commands->EnqueueApply(PlayerController, [WeakThis, Payload, Destination, DestinationIndex, SourceContainer, DestinationContainer]() mutable
+	{
+		if (UInventoryRouterComponent* Router = WeakThis.Get())
+		{
+			Payload.Source.Container = SourceContainer.Get();
+			Destination.Container = DestinationContainer.Get();
+			Router->ExecuteTransfer(Payload, Destination, DestinationIndex);
+		}
+	});
+}
+
+bool UInventoryRouterComponent::ExecuteTransfer(const FInventoryDragPayload& Payload, const FInventoryContainerHandle& Destination, int32 DestinationIndex)
+{
+	if (Payload.Count <= 0 || !IsOwnedContainer(Payload.Source) || !IsOwnedContainer(Destination))
+	{
+		return false;
+	}
+
+	if (Payload.Source == Destination && Payload.SlotIndex == DestinationIndex)
+	{
+		return false;
+	}
+
+	FInventoryAuditScope AuditScope(AuditOpFor(Payload.Source.Kind, Destination.Kind));
+	switch (Payload.Source.Kind)
+	{
+	case EInventoryContainerKind::Bag:
+		return TransferFromBag(Payload, Destination, DestinationIndex);
+	case EInventoryContainerKind::Equipment:
+		return TransferFromEquipment(Payload, Destination, DestinationIndex);
+	default:
+		return false;
+	}
+}
+
+bool UInventoryRouterComponent::TransferFromBag(const FInventoryDragPayload& Payload, const FInventoryContainerHandle& Destination, int32 DestinationIndex)
+{
+	UInventorySlotDataComponent* SourceSlot = GetBagSlot(Payload.Source.GetBag(), Payload.SlotIndex);
+	if (!SourceSlot || SourceSlot->IsEmpty() || SourceSlot->GetItemData().ItemID != Payload.ItemID || SourceSlot->GetStackCount() < Payload.Count)
+	{
+		return false;
+	}
+
+	switch (Destination.Kind)
+	{
+	case EInventoryContainerKind::Bag:
+		return UInventorySlotDataComponent::TransferItems(*SourceSlot, GetBagSlot(Destination.GetBag(), DestinationIndex), Payload.Count);
+
+	case EInventoryContainerKind::Equipment:
+		return EquipFromSlot(*SourceSlot, Destination.GetEquipment(), DestinationIndex);
+
+	case EInventoryContainerKind::World:
+	{
+		const FS_ItemInfo Item = SourceSlot->GetItemData();
+		FItemInstanceHandle Instance;
+		if (!SourceSlot->TakeItems(Payload.Count, Instance))
+		{
+			return false;
+		}
+		SpawnWorldDrop(Item, Payload.Count, Instance);
+		return true;
+	}
+
+	case EInventoryContainerKind::Destroy:
+		return SourceSlot->RemoveItems(Payload.Count);
+
+	// Dropping on the trade window offers the items; they stay in the bag until the trade completes
+	case EInventoryContainerKind::Trade:
+	{
+		UTradeSubsystem* Trades = UTradeSubsystem::Get(this);
+		return Trades && Trades->StageItem(Cast<APlayerController>(GetOwner()), Payload.Source.GetBag(), Payload.SlotIndex, Payload.Count);
+	}
+
+	default:
+		return false;
+	}
+}
+
+bool UInventoryRouterComponent::TransferFromEquipment(const FInventoryDragPayload& Payload, const FInventoryContainerHandle& Destination, int32 DestinationIndex)
+{
+	UEquipmentComponent* Equipment = Payload.Source.GetEquipment();
+	EEquipmentSlot EquipmentSlot;
+	if (!Equipment || !ToEquipmentSlot(Payload.SlotIndex, EquipmentSlot) || Equipment->GetEquippedItem(EquipmentSlot).ItemID != Payload.ItemID)
+	{
+		return false;
+	}
+
+	FS_ItemInfo Removed;
+	FItemInstanceHandle Instance;
+	switch (Destination.Kind)
+	{
+	case EInventoryContainerKind::Bag:
+	{
+		UBagComponent* TargetBag = Destination.GetBag();
+		UInventorySlotDataComponent* TargetSlot = GetBagSlot(TargetBag, DestinationIndex);
+		if (!TargetSlot || TargetBag == Equipment->GetBagInSlot(EquipmentSlot))
+		{
+			return false;
+		}
+
+		// Dropping onto an occupied slot is a swap, which is just equipping what's there
+		if (!TargetSlot->IsEmpty())
+		{
+			return EquipFromSlot(*TargetSlot, Equipment, Payload.SlotIndex);
+		}
+
+		if (!Equipment->UnequipInstance(EquipmentSlot, Removed, Instance))
+		{
+			return false;
+		}
+
+		// Unequipping a bag spills its contents into the other bags, which may have taken the target slot
+		StoreItem(Removed, 1, TargetSlot, Instance);
+		return true;
+	}
+
+	case EInventoryContainerKind::World:
+		if (!Equipment->UnequipInstance(EquipmentSlot, Removed, Instance))
+		{
+			return false;
+		}
+		SpawnWorldDrop(Removed, 1, Instance);
+		return true;
+
+	case EInventoryContainerKind::Destroy:
+		return Equipment->UnequipSlot(EquipmentSlot, Removed);
+
+	default:
+		return false;
+	}
+}
+
+bool UInventoryRouterComponent::EquipFromSlot(UInventorySlotDataComponent& Source, UEquipmentComponent* Equipment, int32 EquipmentSlotIndex)
+{
+	EEquipmentSlot EquipmentSlot;
+	if (!Equipment || !ToEquipmentSlot(EquipmentSlotIndex, EquipmentSlot))
+	{
+		return false;
+	}
+
+	const FS_ItemInfo Item = Source.GetItemData();
+	if (!Equipment->CanEquipInSlot(Item, EquipmentSlot))
+	{
+		return false;
+	}
+
+	// A bag can't be replaced by an item that is stored inside it
+	if (Source.GetOwningBag() && Source.GetOwningBag() == Equipment->GetBagInSlot(EquipmentSlot))
+	{
+		return false;
+	}
+
+	FItemInstanceHandle Instance;
+	if (!Source.TakeItems(1, Instance))
+	{
+		return false;
+	}
+
+	FS_ItemInfo Previous;
+	FItemInstanceHandle PreviousInstance;
+	if (!Equipment->EquipInstance(Item, Instance, EquipmentSlot, Previous, PreviousInstance))
+	{
+		Source.PutItems(Item, 1, Instance);
+		return false;
+	}
+
+	if (!Previous.ItemID.IsNone())
+	{
+		StoreItem(Previous, 1, &Source, PreviousInstance);
+	}
+	return true;
+}
+
+void UInventoryRouterComponent::StoreItem(const FS_ItemInfo& Item, int32 Count, UInventorySlotDataComponent* PreferredSlot, FItemInstanceHandle Instance)
+{
+	if (PreferredSlot && PreferredSlot->PutItems(Item, Count, Instance))
+	{
+		return;
+	}
+
+	int32 Remaining = Count;
+	if (const UInventoryRegistryComponent* Registry = UInventoryRegistryComponent::FindForActor(GetOwner()))
+	{
+		for (UBagComponent* Bag : Registry->GetBags())
+		{
+			if (Remaining <= 0)
+			{
+				break;
+			}
+
+			// A unique item needs an empty slot that can adopt its instance
+			if (Instance.IsValid())
+			{
+				for (UInventorySlotDataComponent* Slot : Bag->GetInventorySlots())
+				{
+					if (Slot && Slot->PutItems(Item, Count, Instance))
+					{
+						return;
+					}
+				}
+				continue;
+			}
+			Remaining = Bag->AddItem(Item, Remaining);
+		}
+	}
+
+	if (Remaining > 0)
+	{
+		SpawnWorldDrop(Item, Remaining, Instance);
+	}
+}
+
+void UInventoryRouterComponent::SpawnWorldDrop(const FS_ItemInfo& Item, int32 Count, FItemInstanceHandle Instance)
+{
+	const APawn* Pawn = GetControlledPawn();
+	UWorld* World = GetWorld();
+	if (!Pawn || !World || !WorldDropClass)
+	{
+		// The item is gone either way; don't leave its instance behind
+		if (UItemInstanceSubsystem* Instances = Instance.IsValid() ? UItemInstanceSubsystem::Get(this) : nullptr)
+		{
+			Instances->ReleaseInstance(Instance);
+		}
+		return;
+	}
+
+	const FTransform DropTransform(Pawn->GetActorRotation(), Pawn->GetActorLocation() + Pawn->GetActorForwardVector() * WorldDropDistance);
+	AItemBase* Drop = World->SpawnActorDeferred<AItemBase>(WorldDropClass, DropTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+	if (Drop)
+	{
+		Drop->ItemDetails = Item;
+		Drop->StackCount = Count;
+		Drop->InstanceHandle = Instance;
+		Drop->FinishSpawning(DropTransform);
+	}
+}
+
+bool UInventoryRouterComponent::IsOwnedContainer(const FInventoryContainerHandle& Handle) const
+{
+	switch (Handle.Kind)
+	{
+	case EInventoryContainerKind::Bag:
+	case EInventoryContainerKind::Equipment:
+	{
+		const APawn* Pawn = GetControlledPawn();
+		return Pawn && Handle.Container && Handle.Container->GetOwner() == Pawn;
+	}
+
+	case EInventoryContainerKind::World:
+	case EInventoryContainerKind::Destroy:
+		return true;
+
+	case EInventoryContainerKind::Trade:
+	{
+		const UTradeSubsystem* Trades = UTradeSubsystem::Get(this);
+		return Trades && Trades->IsTrading(Cast<APlayerController>(GetOwner()));
+	}
+
+	default:
+		return false;
+	}
+}
+
+APawn* UInventoryRouterComponent::GetControlledPawn() const
+{
+	const AController* Controller = Cast<AController>(GetOwner());
+	return Controller ? Controller->GetPawn() : nullptr;
+}
@@ -1,9 +1,15 @@
 #include "InventorySlotDataComponent.h"
+#include "BagComponent.h"
+#include "InventoryStore.h"
+#include "ItemInstanceSubsystem.h"
+#include "ItemRegistrySubsystem.h"
+#include "Net/UnrealNetwork.h"
 
 UInventorySlotDataComponent::UInventorySlotDataComponent()
 {
 	PrimaryComponentTick.bCanEverTick = false;
-	StackCount = 0;
+	SlotIndex = INDEX_NONE;
+	SetIsReplicatedByDefault(true);
 }
 
 void UInventorySlotDataComponent::BeginPlay()
@@ -11,32 +17,300 @@ void UInventorySlotDataComponent::BeginPlay()
 	Super::BeginPlay();
 }
 
+void UInventorySlotDataComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	// Only the owning player ever looks inside their bags
+	DOREPLIFETIME_CONDITION(UInventorySlotDataComponent, NetContents, COND_OwnerOnly);
+	DOREPLIFETIME_CONDITION(UInventorySlotDataComponent, UncookedItemData, COND_OwnerOnly);
+}
+
+UBagComponent* UInventorySlotDataComponent::GetViewedBag() const
+{
+	// A slot dropped from a bag's array keeps its index until it is pooled; it mustn't see its successor
+	UBagComponent* Bag = OwningBag.Get();
+	const TArray<UInventorySlotDataComponent*>* Slots = Bag ? &Bag->GetInventorySlots() : nullptr;
+	return Slots && Slots->IsValidIndex(SlotIndex) && (*Slots)[SlotIndex] == this ? Bag : nullptr;
+}
+
+FInventoryStoreSlot UInventorySlotDataComponent::ReadContents() const
+{
+	const UBagComponent* Bag = GetViewedBag();
+	return Bag ? Bag->ReadSlot(SlotIndex) : FInventoryStoreSlot();
+}
+
+const FS_ItemInfo& UInventorySlotDataComponent::GetItemData() const
+{
+	static const FS_ItemInfo EmptyItem;
+
+	const FInventoryStoreSlot Contents = ReadContents();
+	const UItemRegistrySubsystem* Registry = Contents.IsEmpty() ? nullptr : UItemRegistrySubsystem::Get();
+	const FItemRegistryEntry* Entry = Registry ? Registry->GetEntry(Contents.ItemIndex) : nullptr;
+	return Entry ? Entry->Info : EmptyItem;
+}
+
+int32 UInventorySlotDataComponent::GetStackCount() const
+{
+	return ReadContents().Count;
+}
+
+FItemInstanceHandle UInventorySlotDataComponent::GetInstanceHandle() const
+{
+	return ReadContents().Instance;
+}
+
 bool UInventorySlotDataComponent::IsEmpty() const
 {
-	return StackCount == 0;
+	return ReadContents().IsEmpty();
 }
 
 bool UInventorySlotDataComponent::AddItems(const FS_ItemInfo& NewItem, int32 Count)
 {
-	if (IsEmpty() || (ItemData.ItemID == NewItem.ItemID && StackCount + Count <= ItemData.MaxStackSize))
+	// A non-positive count would turn an add into a removal, and an empty slot still has a stack limit
+	UBagComponent* Bag = GetViewedBag();
+	if (!Bag || Count <= 0 || NewItem.ItemID.IsNone())
 	{
-		ItemData = NewItem;
-		StackCount += Count;
-		return true;
+		return false;
 	}
-	return false;
+
+	FInventoryStoreSlot Contents = Bag->ReadSlot(SlotIndex);
+	if (Contents.IsEmpty())
+	{
+		UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+		Contents.ItemIndex = Count <= NewItem.GetMaxStack() && Registry ? Registry->RegisterItem(NewItem) : INDEX_NONE;
+		if (Contents.ItemIndex == INDEX_NONE)
+		{
+			return false;
+		}
+
+		// A unique item entering the game gets its own instance; clients wait for the replicated handle
+		if (NewItem.bUniqueInstance && GetOwnerRole() == ROLE_Authority)
+		{
+			if (UItemInstanceSubsystem* Instances = UItemInstanceSubsystem::Get(this))
+			{
+				Contents.Instance = Instances->CreateInstance(NewItem);
+			}
+		}
+	}
+	else
+	{
+		const FS_ItemInfo& Current = GetItemData();
+		if (Current.ItemID != NewItem.ItemID || Contents.Count + Count > Current.GetMaxStack())
+		{
+			return false;
+		}
+	}
+
+	Contents.Count += Count;
+	Bag->WriteSlot(SlotIndex, Contents);
+	return true;
 }
 
 bool UInventorySlotDataComponent::RemoveItems(int32 Count)
 {
-	if (Count <= StackCount)
+	FItemInstanceHandle Removed;
+	if (!TakeItems(Count, Removed))
+	{
+		return false;
+	}
+
+	if (UItemInstanceSubsystem* Instances = Removed.IsValid() ? UItemInstanceSubsystem::Get(this) : nullptr)
 	{
-		StackCount -= Count;
-		if (StackCount == 0)
+		Instances->ReleaseInstance(Removed);
+	}
+	return true;
+}
+
+bool UInventorySlotDataComponent::TakeItems(int32 Count, FItemInstanceHandle& OutInstance)
+{
+	OutInstance = FItemInstanceHandle();
+	UBagComponent* Bag = GetViewedBag();
+	if (!Bag)
+	{
+		return false;
+	}
+
+	FInventoryStoreSlot Contents = Bag->ReadSlot(SlotIndex);
+	if (Count <= 0 || Count > Contents.Count)
+	{
+		return false;
+	}
+
+	Contents.Count -= Count;
+	if (Contents.Count == 0)
+	{
+		OutInstance = Contents.Instance;
+		Contents = FInventoryStoreSlot(); // Reset the slot
+	}
+	Bag->WriteSlot(SlotIndex, Contents);
+	return true;
+}
+
+bool UInventorySlotDataComponent::PutItems(const FS_ItemInfo& NewItem, int32 Count, FItemInstanceHandle Instance)
+{
+	if (!Instance.IsValid())
+	{
+		return AddItems(NewItem, Count);
+	}
+
+	// An instance is one unique item, so it only ever goes into an empty slot
+	UBagComponent* Bag = GetViewedBag();
+	if (!Bag || !IsEmpty() || Count != 1 || NewItem.ItemID.IsNone())
+	{
+		return false;
+	}
+
+	UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+	FInventoryStoreSlot Contents;
+	Contents.ItemIndex = Registry ? Registry->RegisterItem(NewItem) : INDEX_NONE;
+	Contents.Count = 1;
+	Contents.Instance = Instance;
+	if (Contents.ItemIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	Bag->WriteSlot(SlotIndex, Contents);
+	return true;
+}
+
+bool UInventorySlotDataComponent::TransferItems(UInventorySlotDataComponent& Source, UInventorySlotDataComponent* Target, int32 Count)
+{
+	const int32 SourceCount = Source.GetStackCount();
+	if (!Target || Target == &Source || SourceCount == 0 || Count <= 0 || Count > SourceCount)
+	{
+		return false;
+	}
+
+	const FS_ItemInfo SourceItem = Source.GetItemData();
+	const int32 TargetCount = Target->GetStackCount();
+	if (TargetCount == 0 || Target->GetItemData().ItemID == SourceItem.ItemID)
+	{
+		const int32 Space = SourceItem.GetMaxStack() - TargetCount;
+		const int32 Moved = FMath::Min(Count, Space);
+		if (Moved <= 0)
+		{
+			return false;
+		}
+
+		FItemInstanceHandle Instance;
+		const bool bRemoved = Source.TakeItems(Moved, Instance);
+		const bool bAdded = bRemoved && Target->PutItems(SourceItem, Moved, Instance);
+		ensureMsgf(bRemoved == bAdded, TEXT("Slot transfer removed items it could not add"));
+		return bAdded;
+	}
+
+	// Different items only trade places as whole stacks
+	if (Count != SourceCount)
+	{
+		return false;
+	}
+
+	const FS_ItemInfo TargetItem = Target->GetItemData();
+
+	// Instances travel with their items instead of being destroyed and rolled again
+	FItemInstanceHandle SourceInstance;
+	FItemInstanceHandle TargetInstance;
+	Source.TakeItems(SourceCount, SourceInstance);
+	Target->TakeItems(TargetCount, TargetInstance);
+	Source.PutItems(TargetItem, TargetCount, TargetInstance);
+	Target->PutItems(SourceItem, SourceCount, SourceInstance);
+	return true;
+}
+
+void UInventorySlotDataComponent::ResetSlot()
+{
+	UBagComponent* Bag = GetViewedBag();
+	if (!Bag)
+	{
+		return;
+	}
+
+	const FInventoryStoreSlot Contents = Bag->ReadSlot(SlotIndex);
+	if (Contents.Instance.IsValid() && GetOwnerRole() == ROLE_Authority)
+	{
+		if (UItemInstanceSubsystem* Instances = UItemInstanceSubsystem::Get(this))
+		{
+			Instances->ReleaseInstance(Contents.Instance);
+		}
+	}
+	Bag->WriteSlot(SlotIndex, FInventoryStoreSlot());
+}
+
+void UInventorySlotDataComponent::SetOwningBag(UBagComponent* InBag, int32 InSlotIndex)
+{
+	OwningBag = InBag;
+	SlotIndex = InBag ? InSlotIndex : INDEX_NONE;
+
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		UpdateNetContents();
+	}
+	else
+	{
+		// Contents may have replicated before the bag knew about this slot
+		ApplyNetContents();
+	}
+}
+
+void UInventorySlotDataComponent::OnRep_SlotContents()
+{
+	ApplyNetContents();
+}
+
+void UInventorySlotDataComponent::ApplyNetContents()
+{
+	UBagComponent* Bag = GetViewedBag();
+	if (!Bag)
+	{
+		return;
+	}
+
+	FInventoryStoreSlot Contents;
+	UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+	if (NetContents.Count > 0 && Registry)
+	{
+		// Only the ID came over the wire; the definition is local, or sent alongside when it isn't
+		Contents.ItemIndex = Registry->FindItemIndex(NetContents.ItemID);
+		if (Contents.ItemIndex == INDEX_NONE)
+		{
+			FS_ItemInfo Definition = UncookedItemData.ItemID == NetContents.ItemID ? UncookedItemData : FS_ItemInfo();
+			Definition.ItemID = NetContents.ItemID;
+			Contents.ItemIndex = Registry->RegisterItem(Definition);
+		}
+		Contents.Count = NetContents.Count;
+		Contents.Instance = NetContents.Instance;
+	}
+	Bag->WriteSlot(SlotIndex, Contents);
+}
+
+void UInventorySlotDataComponent::UpdateNetContents()
+{
+	const FInventoryStoreSlot Contents = ReadContents();
+	const FS_ItemInfo& Item = GetItemData();
+
+	FInventorySlotNetData NewContents;
+	if (!Contents.IsEmpty())
+	{
+		NewContents.ItemID = Item.ItemID;
+		NewContents.Count = Contents.Count;
+		NewContents.Instance = Contents.Instance;
+	}
+	NetContents = NewContents;
+
+	// Left at its default for cooked items, so it costs nothing once the slot has been sent
+	const UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+	const bool bNetIndexed = Registry && Contents.ItemIndex != INDEX_NONE && Contents.ItemIndex < Registry->GetNumNetIndexed();
+	if (!Contents.IsEmpty() && !bNetIndexed)
+	{
+		if (UncookedItemData.ItemID != Item.ItemID)
 		{
-			ItemData = FS_ItemInfo(); // Reset the slot
+			UncookedItemData = Item;
 		}
-		return true;
 	}
-	return false;
+	else if (!UncookedItemData.ItemID.IsNone())
+	{
+		UncookedItemData = FS_ItemInfo();
+	}
 }
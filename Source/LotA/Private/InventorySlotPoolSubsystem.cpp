@@ -0,0 +1,77 @@
+// InventorySlotPoolSubsystem.cpp
+#include "InventorySlotPoolSubsystem.h"
+#include "InventorySlotDataComponent.h"
+#include "GameFramework/Actor.h"
+
+UInventorySlotDataComponent* UInventorySlotPoolSubsystem::AcquireSlot(AActor* Owner)
+{
+	if (!Owner)
+	{
+		return nullptr;
+	}
+
+	if (FInventorySlotFreeList* FreeList = FreeLists.Find(Owner))
+	{
+		while (FreeList->Slots.Num() > 0)
+		{
+			UInventorySlotDataComponent* PooledSlot = FreeList->Slots.Pop(EAllowShrinking::No);
+			if (IsValid(PooledSlot))
+			{
+				return PooledSlot;
+			}
+		}
+	}
+
+	UInventorySlotDataComponent* NewSlot = NewObject<UInventorySlotDataComponent>(Owner);
+	if (NewSlot)
+	{
+		NewSlot->RegisterComponent();
+	}
+	return NewSlot;
+}
+
+void UInventorySlotPoolSubsystem::ReleaseSlot(UInventorySlotDataComponent* Slot)
+{
+	if (!IsValid(Slot))
+	{
+		return;
+	}
+
+	// Before anything else: a destroyed slot would otherwise take its unique item's instance with it
+	Slot->ResetSlot();
+
+	AActor* Owner = Slot->GetOwner();
+	if (!IsValid(Owner) || Owner->IsActorBeingDestroyed())
+	{
+		Slot->DestroyComponent();
+		return;
+	}
+
+	FInventorySlotFreeList* FreeList = FreeLists.Find(Owner);
+	if (!FreeList)
+	{
+		FreeList = &FreeLists.Add(Owner);
+		Owner->OnEndPlay.AddUniqueDynamic(this, &UInventorySlotPoolSubsystem::HandleOwnerEndPlay);
+	}
+
+	if (FreeList->Slots.Num() >= MaxPooledSlotsPerOwner)
+	{
+		Slot->DestroyComponent();
+		return;
+	}
+
+	Slot->SetOwningBag(nullptr, INDEX_NONE);
+	FreeList->Slots.Add(Slot);
+}
+
+void UInventorySlotPoolSubsystem::HandleOwnerEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason)
+{
+	FreeLists.Remove(Actor);
+}
+
+void UInventorySlotPoolSubsystem::Deinitialize()
+{
+	FreeLists.Empty();
+
+	Super::Deinitialize();
+}
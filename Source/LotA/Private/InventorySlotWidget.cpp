@@ -5,11 +5,25 @@
 #include "DragDropVisual.h"
 #include "Blueprint/WidgetBlueprintLibrary.h"
 #include "InventoryDragDropOperation.h"
+#include "ItemFilter.h"
+#include "InventoryIconAtlasSubsystem.h"
+#include "ItemRegistrySubsystem.h"
+#include "ItemTooltipSubsystem.h"
+#include "ItemTooltipWidget.h"
+#include "ItemUseComponent.h"
+#include "InventoryRouterComponent.h"
+#include "BagComponent.h"
+#include "GameFramework/PlayerController.h"
 
 UInventorySlotWidget::UInventorySlotWidget(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
     , ItemQuantity(0)
-    , bIsInDragOperation(false)
+    , BoundSlotIndex(INDEX_NONE)
+    , RegistryIndex(INDEX_NONE)
+    , IconAtlasCell(INDEX_NONE)
+    , ActiveFilter(nullptr)
+    , FilteredOutOpacity(1.0f)
+    , bMatchesFilter(true)
 {
 }
 
@@ -19,21 +33,36 @@ void UInventorySlotWidget::NativeConstruct()
     ClearSlot();
 }
 
+void UInventorySlotWidget::NativeDestruct()
+{
+    ReleaseIconCell();
+    Super::NativeDestruct();
+}
+
 void UInventorySlotWidget::SetItemDetails(const FS_ItemInfo& InItemInfo, int32 Quantity)
 {
-    if (bIsInDragOperation)
+    if (CurrentItemInfo.ItemID != InItemInfo.ItemID)
     {
-        UE_LOG(LogTemp, Warning, TEXT("Attempting to clear slot during drag operation - ignoring"));
-        return;
+        ReleaseIconCell();
+
+        UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+        RegistryIndex = Registry ? Registry->RegisterItem(InItemInfo) : INDEX_NONE;
     }
 
     CurrentItemInfo = InItemInfo;
     ItemQuantity = Quantity;
     UpdateVisuals();
+
+    if (IsHovered())
+    {
+        UpdateTooltip();
+    }
 }
 
 void UInventorySlotWidget::ClearSlot()
 {
+    ReleaseIconCell();
+
     if (ItemIcon)
     {
         ItemIcon->SetBrushFromTexture(nullptr);
@@ -48,12 +77,60 @@ void UInventorySlotWidget::ClearSlot()
 
     CurrentItemInfo = FS_ItemInfo();
     ItemQuantity = 0;
+    RegistryIndex = INDEX_NONE;
+    SetToolTip(nullptr);
+
+    if (ActiveFilter)
+    {
+        SetFilterMatch(ActiveFilter->Matches(nullptr));
+    }
+}
+
+void UInventorySlotWidget::BindToBagSlot(UBagComponent* InBag, int32 InSlotIndex)
+{
+    BoundBag = InBag;
+    BoundSlotIndex = InBag ? InSlotIndex : INDEX_NONE;
+}
+
+bool UInventorySlotWidget::ApplyFilter(const FInventoryFilter* Filter, float InFilteredOutOpacity)
+{
+    ActiveFilter = Filter;
+    FilteredOutOpacity = InFilteredOutOpacity;
+
+    if (!ActiveFilter)
+    {
+        SetFilterMatch(true);
+        return true;
+    }
+
+    const UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+    const FItemRegistryEntry* Entry = (Registry && ItemQuantity > 0) ? Registry->GetEntry(RegistryIndex) : nullptr;
+    SetFilterMatch(ActiveFilter->Matches(Entry));
+    return bMatchesFilter;
+}
+
+void UInventorySlotWidget::SetFilterMatch(bool bMatches)
+{
+    // Only touch the widget when the state flips, so re-filtering unchanged slots costs nothing
+    if (bMatchesFilter == bMatches)
+    {
+        return;
+    }
+
+    bMatchesFilter = bMatches;
+    SetRenderOpacity(bMatchesFilter ? 1.0f : FilteredOutOpacity);
 }
 
 void UInventorySlotWidget::UpdateVisuals()
 {
-    if (!CurrentItemInfo.ItemIcon || ItemQuantity <= 0)
+    if (ActiveFilter)
+    {
+        ApplyFilter(ActiveFilter, FilteredOutOpacity);
+    }
+
+    if (ItemQuantity <= 0 || !UpdateIconBrush())
     {
+        ReleaseIconCell();
         if (ItemIcon)
             ItemIcon->SetVisibility(ESlateVisibility::Hidden);
         if (QuantityText)
@@ -61,12 +138,6 @@ void UInventorySlotWidget::UpdateVisuals()
         return;
     }
 
-    if (ItemIcon)
-    {
-        ItemIcon->SetBrushFromTexture(CurrentItemInfo.ItemIcon);
-        ItemIcon->SetVisibility(ESlateVisibility::Visible);
-    }
-
     if (QuantityText)
     {
         if (ItemQuantity > 1)
@@ -81,6 +152,116 @@ void UInventorySlotWidget::UpdateVisuals()
     }
 }
 
+bool UInventorySlotWidget::UpdateIconBrush()
+{
+    // Count changes keep the cell, so the brush is only set when the item changes
+    if (IconAtlasCell != INDEX_NONE)
+        return true;
+
+    if (UInventoryIconAtlasSubsystem* Atlas = UInventoryIconAtlasSubsystem::Get())
+    {
+        const int32 RequestedIndex = RegistryIndex;
+        IconAtlasCell = Atlas->AcquireIcon(RequestedIndex, FSimpleDelegate::CreateWeakLambda(this, [this, RequestedIndex]()
+        {
+            if (RegistryIndex == RequestedIndex && IconAtlasCell != INDEX_NONE)
+            {
+                ApplyAtlasBrush();
+            }
+        }));
+        if (IconAtlasCell != INDEX_NONE)
+        {
+            ApplyAtlasBrush();
+            return true;
+        }
+    }
+
+    // A cooked icon that isn't loaded yet streams in; the slot stays blank until it arrives
+    UTexture2D* Texture = CurrentItemInfo.ItemIcon;
+    if (!Texture)
+    {
+        if (UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get())
+        {
+            const int32 RequestedIndex = RegistryIndex;
+            Texture = Registry->RequestIcon(RequestedIndex, FSimpleDelegate::CreateWeakLambda(this, [this, RequestedIndex]()
+            {
+                if (RegistryIndex == RequestedIndex)
+                {
+                    UpdateVisuals();
+                }
+            }));
+        }
+    }
+    if (!Texture)
+        return false;
+
+    if (ItemIcon)
+    {
+        ItemIcon->SetBrushFromTexture(Texture);
+        ItemIcon->SetVisibility(ESlateVisibility::Visible);
+    }
+    return true;
+}
+
+void UInventorySlotWidget::ApplyAtlasBrush()
+{
+    if (!ItemIcon)
+        return;
+
+    // A reused cell still holds the evicted item's icon until the new one is drawn
+    FSlateBrush Brush;
+    const UInventoryIconAtlasSubsystem* Atlas = UInventoryIconAtlasSubsystem::Get();
+    if (Atlas && Atlas->GetCellBrush(IconAtlasCell, Brush))
+    {
+        ItemIcon->SetBrush(Brush);
+        ItemIcon->SetVisibility(ESlateVisibility::Visible);
+    }
+    else
+    {
+        ItemIcon->SetVisibility(ESlateVisibility::Hidden);
+    }
+}
+
+void UInventorySlotWidget::ReleaseIconCell()
+{
+    if (IconAtlasCell == INDEX_NONE)
+        return;
+
+    if (UInventoryIconAtlasSubsystem* Atlas = UInventoryIconAtlasSubsystem::Get())
+    {
+        Atlas->ReleaseIcon(IconAtlasCell);
+    }
+    IconAtlasCell = INDEX_NONE;
+}
+
+void UInventorySlotWidget::NativeOnMouseEnter(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
+{
+    Super::NativeOnMouseEnter(InGeometry, InMouseEvent);
+    UpdateTooltip();
+}
+
+void UInventorySlotWidget::NativeOnMouseLeave(const FPointerEvent& InMouseEvent)
+{
+    Super::NativeOnMouseLeave(InMouseEvent);
+
+    // The tooltip widget is shared, so only the hovered slot holds on to it
+    SetToolTip(nullptr);
+}
+
+void UInventorySlotWidget::UpdateTooltip()
+{
+    if (ItemQuantity <= 0)
+    {
+        SetToolTip(nullptr);
+        return;
+    }
+
+    APlayerController* OwningPlayer = GetOwningPlayer();
+    UItemTooltipSubsystem* Tooltips = UItemTooltipSubsystem::Get(OwningPlayer);
+    const UBagComponent* Bag = BoundBag.Get();
+    const float WeightReduction = Bag ? Bag->GetWeightReduction() : 0.0f;
+    SetToolTip(Tooltips ? Tooltips->GetTooltipFor(OwningPlayer, CurrentItemInfo, ItemQuantity, WeightReduction) : nullptr);
+}
+
 FReply UInventorySlotWidget::NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
 {
     if (ItemQuantity <= 0)
@@ -88,53 +269,72 @@ FReply UInventorySlotWidget::NativeOnMouseButtonDown(const FGeometry& InGeometry
 
     if (InMouseEvent.GetEffectingButton() == EKeys::LeftMouseButton)
     {
-        // Store the original data for the drag operation
+        // The slot keeps showing its contents; it only changes once the server applies the move
         DraggedItemInfo = CurrentItemInfo;
-        
+
         if (InMouseEvent.IsShiftDown() && ItemQuantity > 1)
         {
             DraggedQuantity = 1;
-            // Just reduce quantity, don't clear
-            ItemQuantity -= 1;
-            UpdateVisuals();
         }
         else if (InMouseEvent.IsControlDown() && ItemQuantity > 1)
         {
             DraggedQuantity = ItemQuantity / 2;
-            // Just reduce quantity, don't clear
-            ItemQuantity -= DraggedQuantity;
-            UpdateVisuals();
         }
         else
         {
             DraggedQuantity = ItemQuantity;
-            ClearSlot();
         }
 
-        bIsInDragOperation = true;
         return FReply::Handled().DetectDrag(TakeWidget(), EKeys::LeftMouseButton);
     }
 
+    // Right-click uses the item; the server validates type, cooldown and ownership
+    if (InMouseEvent.GetEffectingButton() == EKeys::RightMouseButton && CurrentItemInfo.ItemType == EItemType::Consumable)
+    {
+        APlayerController* OwningPlayer = GetOwningPlayer();
+        UItemUseComponent* ItemUse = OwningPlayer ? OwningPlayer->FindComponentByClass<UItemUseComponent>() : nullptr;
+        if (ItemUse && BoundBag.IsValid())
+        {
+            ItemUse->UseItemInSlot(BoundBag.Get(), BoundSlotIndex);
+            return FReply::Handled();
+        }
+    }
+
     return FReply::Unhandled();
 }
 
 void UInventorySlotWidget::NativeOnDragDetected(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent, UDragDropOperation*& OutOperation)
 {
+    // Only slots backed by a bag have anything to move
+    if (!BoundBag.IsValid())
+    {
+        return;
+    }
+
     UInventoryDragDropOperation* DragDropOp = Cast<UInventoryDragDropOperation>(UWidgetBlueprintLibrary::CreateDragDropOperation(UInventoryDragDropOperation::StaticClass()));
     
     if (DragDropOp)
     {
-        // Store the original item data
+        DragDropOp->Payload.Source = FInventoryContainerHandle::ForBag(BoundBag.Get());
+        DragDropOp->Payload.SlotIndex = BoundSlotIndex;
+        DragDropOp->Payload.ItemID = DraggedItemInfo.ItemID;
+        DragDropOp->Payload.Count = DraggedQuantity;
         DragDropOp->DraggedItem = DraggedItemInfo;
-        DragDropOp->OriginalQuantity = DraggedQuantity;
-        DragDropOp->SourceSlot = this;
-        DragDropOp->bSplitStack = InMouseEvent.IsShiftDown() || InMouseEvent.IsControlDown();
+        DragDropOp->bSplitStack = DraggedQuantity < ItemQuantity;
 
         UDragDropVisual* DragVisual = CreateWidget<UDragDropVisual>(this, LoadClass<UDragDropVisual>(nullptr, TEXT("/Game/Inventory/Widgets/WBP_DragVisual.WBP_DragVisual_C")));
         
         if (DragVisual)
         {
-            DragVisual->SetItemIcon(DraggedItemInfo.ItemIcon);
+            // The visual pins its own cell, since the slot may release this one mid-drag
+            if (IconAtlasCell != INDEX_NONE)
+            {
+                DragVisual->SetAtlasIcon(RegistryIndex);
+            }
+            else if (ItemIcon)
+            {
+                DragVisual->SetIconBrush(ItemIcon->GetBrush());
+            }
             DragDropOp->DefaultDragVisual = DragVisual;
             DragDropOp->Pivot = EDragPivot::MouseDown;
         }
@@ -146,64 +346,18 @@ void UInventorySlotWidget::NativeOnDragDetected(const FGeometry& InGeometry, con
 bool UInventorySlotWidget::NativeOnDrop(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation)
 {
     UInventoryDragDropOperation* InventoryDragDrop = Cast<UInventoryDragDropOperation>(InOperation);
-    if (!InventoryDragDrop || !InventoryDragDrop->SourceSlot)
-        return false;
-
-    // If dropping on same slot, do nothing
-    if (InventoryDragDrop->SourceSlot == this)
+    if (!InventoryDragDrop || !BoundBag.IsValid())
         return false;
 
-    // Handle stack merging
-    if (ItemQuantity > 0 && CurrentItemInfo.ItemID == InventoryDragDrop->DraggedItem.ItemID)
-    {
-        int32 SpaceAvailable = CurrentItemInfo.MaxStackSize - ItemQuantity;
-        if (SpaceAvailable > 0)
-        {
-            int32 AmountToAdd = FMath::Min(SpaceAvailable, InventoryDragDrop->OriginalQuantity);
-            ItemQuantity += AmountToAdd;
-            UpdateVisuals();
-
-            // Update source slot
-            UInventorySlotWidget* SourceSlot = Cast<UInventorySlotWidget>(InventoryDragDrop->SourceSlot);
-            if (SourceSlot)
-            {
-                if (SourceSlot->ItemQuantity > AmountToAdd)
-                {
-                    SourceSlot->ItemQuantity -= AmountToAdd;
-                    SourceSlot->UpdateVisuals();
-                }
-                else
-                {
-                    SourceSlot->ClearSlot();
-                }
-            }
-            return true;
-        }
-    }
-
-    // Handle normal swap
-    FS_ItemInfo TempItem = CurrentItemInfo;
-    int32 TempQuantity = ItemQuantity;
-
-    SetItemDetails(InventoryDragDrop->DraggedItem, InventoryDragDrop->OriginalQuantity);
-
-    if (UInventorySlotWidget* SourceSlot = Cast<UInventorySlotWidget>(InventoryDragDrop->SourceSlot))
+    if (UInventoryRouterComponent* Router = GetInventoryRouter())
     {
-        if (TempQuantity > 0)
-        {
-            SourceSlot->SetItemDetails(TempItem, TempQuantity);
-        }
-        else
-        {
-            SourceSlot->ClearSlot();
-        }
+        Router->RouteDrop(InventoryDragDrop->Payload, FInventoryContainerHandle::ForBag(BoundBag.Get()), BoundSlotIndex);
     }
-
-    bIsInDragOperation = false;
     return true;
 }
 
-void UInventorySlotWidget::NativeOnDragCancelled(const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation)
+UInventoryRouterComponent* UInventorySlotWidget::GetInventoryRouter() const
 {
-    bIsInDragOperation = false;
-}
\ No newline at end of file
+    const APlayerController* OwningPlayer = GetOwningPlayer();
+    return OwningPlayer ? OwningPlayer->FindComponentByClass<UInventoryRouterComponent>() : nullptr;
+}
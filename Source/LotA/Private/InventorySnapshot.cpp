@@ -0,0 +1,159 @@
+// InventorySnapshot.cpp
+#include "InventorySnapshot.h"
+#include "ItemInstanceSubsystem.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+	const uint32 SnapshotMagic = 0x4C414953; // "LAIS"
+	const int32 SnapshotFileVersion = 1;
+}
+
+// Global rather than in the anonymous namespace so TArray's operator<< finds them by argument lookup
+static FArchive& operator<<(FArchive& Ar, FInventorySlotSnapshot& Slot)
+{
+	return Ar << Slot.ItemID << Slot.Count << Slot.InstanceIndex;
+}
+
+static FArchive& operator<<(FArchive& Ar, FItemInstanceProperty& Property)
+{
+	return Ar << Property.Key << Property.Value;
+}
+
+static FArchive& operator<<(FArchive& Ar, FItemInstanceData& Data)
+{
+	Ar << Data.Guid << Data.ItemID << Data.Durability << Data.MaxDurability << Data.bSoulbound;
+	Ar << Data.RolledStats.Armor << Data.RolledStats.Damage << Data.RolledStats.Strength;
+	Ar << Data.RolledStats.Agility << Data.RolledStats.Stamina << Data.RolledStats.Intellect;
+	Ar << Data.Properties;
+	return Ar;
+}
+
+void FInventoryContainerSnapshot::AddSlot(FName ItemID, int32 Count, FItemInstanceHandle Instance, const UItemInstanceSubsystem* InstanceSubsystem)
+{
+	FInventorySlotSnapshot& Slot = Slots.AddDefaulted_GetRef();
+	Slot.ItemID = ItemID;
+	Slot.Count = Count;
+
+	const FItemInstanceData* InstanceData = InstanceSubsystem ? InstanceSubsystem->FindInstance(Instance) : nullptr;
+	if (InstanceData)
+	{
+		Slot.InstanceIndex = Instances.Add(*InstanceData);
+		InstanceRevision = InstanceSubsystem->GetRevision();
+	}
+}
+
+bool FInventoryContainerSnapshot::IsCurrent(uint64 ContainerRevision, const UItemInstanceSubsystem* InstanceSubsystem) const
+{
+	if (Revision != ContainerRevision)
+	{
+		return false;
+	}
+
+	// Durability and the like change without touching the container
+	return Instances.Num() == 0 || !InstanceSubsystem || InstanceRevision == InstanceSubsystem->GetRevision();
+}
+
+FArchive& operator<<(FArchive& Ar, FInventoryContainerSnapshot& Snapshot)
+{
+	Ar << Snapshot.ContainerName << Snapshot.BagItemID << Snapshot.Revision;
+	Ar << Snapshot.Slots << Snapshot.Instances;
+	return Ar;
+}
+
+const FInventoryContainerSnapshot* FInventorySnapshot::FindContainer(FName ContainerName) const
+{
+	const FInventoryContainerSnapshotRef* Found = Containers.FindByPredicate([ContainerName](const FInventoryContainerSnapshotRef& Container)
+	{
+		return Container->ContainerName == ContainerName;
+	});
+	return Found ? &Found->Get() : nullptr;
+}
+
+void FInventorySnapshot::Diff(const FInventorySnapshot& From, const FInventorySnapshot& To, TArray<FInventorySnapshotChange>& OutChanges)
+{
+	static const FInventoryContainerSnapshot EmptyContainer;
+
+	auto DiffContainers = [&OutChanges](FName ContainerName, const FInventoryContainerSnapshot& Old, const FInventoryContainerSnapshot& New)
+	{
+		const int32 NumSlots = FMath::Max(Old.Slots.Num(), New.Slots.Num());
+		for (int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex)
+		{
+			const FInventorySlotSnapshot OldSlot = Old.Slots.IsValidIndex(SlotIndex) ? Old.Slots[SlotIndex] : FInventorySlotSnapshot();
+			const FInventorySlotSnapshot NewSlot = New.Slots.IsValidIndex(SlotIndex) ? New.Slots[SlotIndex] : FInventorySlotSnapshot();
+			if (OldSlot.ItemID != NewSlot.ItemID || OldSlot.Count != NewSlot.Count)
+			{
+				OutChanges.Add({ ContainerName, SlotIndex, OldSlot.ItemID, OldSlot.Count, NewSlot.ItemID, NewSlot.Count });
+			}
+		}
+	};
+
+	for (const FInventoryContainerSnapshotRef& NewContainer : To.Containers)
+	{
+		const FInventoryContainerSnapshot* OldContainer = From.FindContainer(NewContainer->ContainerName);
+		if (OldContainer != &NewContainer.Get())
+		{
+			DiffContainers(NewContainer->ContainerName, OldContainer ? *OldContainer : EmptyContainer, *NewContainer);
+		}
+	}
+
+	// Containers that went away entirely
+	for (const FInventoryContainerSnapshotRef& OldContainer : From.Containers)
+	{
+		if (!To.FindContainer(OldContainer->ContainerName))
+		{
+			DiffContainers(OldContainer->ContainerName, *OldContainer, EmptyContainer);
+		}
+	}
+}
+
+void FInventorySnapshot::SaveToBytes(TArray<uint8>& OutBytes) const
+{
+	FMemoryWriter Writer(OutBytes);
+
+	uint32 Magic = SnapshotMagic;
+	int32 FileVersion = SnapshotFileVersion;
+	uint64 SnapshotVersion = Version;
+	int64 Ticks = CapturedAt.GetTicks();
+	int32 NumContainers = Containers.Num();
+	Writer << Magic << FileVersion << SnapshotVersion << Ticks << NumContainers;
+
+	for (const FInventoryContainerSnapshotRef& Container : Containers)
+	{
+		// Writing never changes the container; the archive API just isn't const
+		Writer << const_cast<FInventoryContainerSnapshot&>(Container.Get());
+	}
+}
+
+FInventorySnapshotPtr FInventorySnapshot::LoadFromBytes(const TArray<uint8>& Bytes)
+{
+	FMemoryReader Reader(Bytes);
+
+	uint32 Magic = 0;
+	int32 FileVersion = 0;
+	Reader << Magic << FileVersion;
+	if (Magic != SnapshotMagic || FileVersion != SnapshotFileVersion)
+	{
+		return nullptr;
+	}
+
+	TSharedRef<FInventorySnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FInventorySnapshot, ESPMode::ThreadSafe>();
+	int64 Ticks = 0;
+	int32 NumContainers = 0;
+	Reader << Snapshot->Version << Ticks << NumContainers;
+	Snapshot->CapturedAt = FDateTime(Ticks);
+
+	for (int32 Index = 0; Index < NumContainers && !Reader.IsError(); ++Index)
+	{
+		TSharedRef<FInventoryContainerSnapshot, ESPMode::ThreadSafe> Container = MakeShared<FInventoryContainerSnapshot, ESPMode::ThreadSafe>();
+		Reader << Container.Get();
+		Snapshot->Containers.Add(Container);
+	}
+
+	if (Reader.IsError())
+	{
+		return nullptr;
+	}
+	return Snapshot;
+}
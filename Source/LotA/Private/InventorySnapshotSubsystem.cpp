@@ -0,0 +1,111 @@
+// InventorySnapshotSubsystem.cpp
+#include "InventorySnapshotSubsystem.h"
+#include "BagComponent.h"
+#include "InventoryRegistryComponent.h"
+#include "EquipmentComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+UInventorySnapshotSubsystem* UInventorySnapshotSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UInventorySnapshotSubsystem>() : nullptr;
+}
+
+void UInventorySnapshotSubsystem::Deinitialize()
+{
+	// Saves hold nothing but the snapshot, but let them finish writing before the world goes
+	UE::Tasks::Wait(PendingSaves);
+	PendingSaves.Empty();
+	LatestSnapshots.Empty();
+
+	Super::Deinitialize();
+}
+
+FInventorySnapshotPtr UInventorySnapshotSubsystem::CaptureSnapshot(const APawn* Pawn)
+{
+	if (!Pawn)
+	{
+		return nullptr;
+	}
+
+	TArray<FInventoryContainerSnapshotRef> Containers;
+	if (const UEquipmentComponent* Equipment = Pawn->FindComponentByClass<UEquipmentComponent>())
+	{
+		Containers.Add(Equipment->GetSnapshot());
+	}
+
+	TArray<UBagComponent*> Bags;
+	UInventoryRegistryComponent::GetBagsOf(Pawn, Bags);
+	for (const UBagComponent* Bag : Bags)
+	{
+		Containers.Add(Bag->GetSnapshot());
+	}
+
+	// Unchanged containers hand back the same snapshot, so comparing pointers is enough
+	FInventorySnapshotPtr& Latest = LatestSnapshots.FindOrAdd(Pawn);
+	if (Latest.IsValid() && Latest->Containers.Num() == Containers.Num())
+	{
+		bool bChanged = false;
+		for (int32 Index = 0; Index < Containers.Num() && !bChanged; ++Index)
+		{
+			bChanged = Latest->Containers[Index] != Containers[Index];
+		}
+		if (!bChanged)
+		{
+			return Latest;
+		}
+	}
+
+	TSharedRef<FInventorySnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FInventorySnapshot, ESPMode::ThreadSafe>();
+	Snapshot->Version = NextVersion++;
+	Snapshot->CapturedAt = FDateTime::UtcNow();
+	Snapshot->Containers = MoveTemp(Containers);
+	Latest = Snapshot;
+
+	// Forget pawns that are gone while we're here
+	for (auto It = LatestSnapshots.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	return Snapshot;
+}
+
+UE::Tasks::TTask<bool> UInventorySnapshotSubsystem::SaveSnapshotAsync(FInventorySnapshotPtr Snapshot, const FString& FilePath)
+{
+	PendingSaves.RemoveAll([](const UE::Tasks::TTask<bool>& Task) { return Task.IsCompleted(); });
+
+	UE::Tasks::TTask<bool> Task = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Snapshot, FilePath]()
+	{
+		if (!Snapshot.IsValid())
+		{
+			return false;
+		}
+
+		TArray<uint8> Bytes;
+		Snapshot->SaveToBytes(Bytes);
+		if (!FFileHelper::SaveArrayToFile(Bytes, *FilePath))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Failed to write inventory snapshot %s"), *FilePath);
+			return false;
+		}
+		return true;
+	}, LowLevelTasks::ETaskPriority::BackgroundNormal);
+
+	PendingSaves.Add(Task);
+	return Task;
+}
+
+void UInventorySnapshotSubsystem::SaveInventory(APawn* Pawn, const FString& FileName)
+{
+	if (FInventorySnapshotPtr Snapshot = CaptureSnapshot(Pawn))
+	{
+		const FString FilePath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Inventory"), FPaths::MakeValidFileName(FileName) + TEXT(".bin"));
+		SaveSnapshotAsync(Snapshot, FilePath);
+	}
+}
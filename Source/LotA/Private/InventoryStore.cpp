@@ -0,0 +1,396 @@
+// InventoryStore.cpp
+#include "InventoryStore.h"
+#include "Algo/BinarySearch.h"
+
+FInventoryEntityHandle FInventoryStore::CreateInventory(int32 NumSlots)
+{
+	NumSlots = FMath::Max(0, NumSlots);
+	if (NumSlots > SlotsPerChunk)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Inventory store: %d slots requested, at most %d fit in one inventory"), NumSlots, SlotsPerChunk);
+		return FInventoryEntityHandle();
+	}
+
+	int32 ChunkIndex = INDEX_NONE;
+	int32 First = 0;
+	if (NumSlots > 0 && !AllocateRun(NumSlots, ChunkIndex, First))
+	{
+		return FInventoryEntityHandle();
+	}
+
+	const int32 EntityIndex = FreeEntities.Num() > 0 ? FreeEntities.Pop(EAllowShrinking::No) : Entities.AddDefaulted();
+	FEntity& Entity = Entities[EntityIndex];
+	Entity.Chunk = ChunkIndex;
+	Entity.First = First;
+	Entity.NumSlots = NumSlots;
+	Entity.OccupiedSlots = 0;
+	Entity.bAlive = true;
+
+	FInventoryEntityHandle Handle;
+	Handle.Index = EntityIndex;
+	Handle.Serial = Entity.Serial;
+	return Handle;
+}
+
+void FInventoryStore::DestroyInventory(FInventoryEntityHandle Inventory)
+{
+	FEntity* Entity = FindEntity(Inventory);
+	if (!Entity)
+	{
+		return;
+	}
+
+	if (Entity->NumSlots > 0)
+	{
+		FreeRun(Entity->Chunk, Entity->First, Entity->NumSlots);
+	}
+
+	// Bumping the serial is what makes outstanding handles stale
+	++Entity->Serial;
+	Entity->Chunk = INDEX_NONE;
+	Entity->NumSlots = 0;
+	Entity->OccupiedSlots = 0;
+	Entity->bAlive = false;
+	FreeEntities.Add(Inventory.Index);
+}
+
+bool FInventoryStore::ResizeInventory(FInventoryEntityHandle Inventory, int32 NewNumSlots)
+{
+	FEntity* Entity = FindEntity(Inventory);
+	NewNumSlots = FMath::Max(0, NewNumSlots);
+	if (!Entity || NewNumSlots > SlotsPerChunk)
+	{
+		return false;
+	}
+
+	const int32 OldNumSlots = Entity->NumSlots;
+	if (NewNumSlots == OldNumSlots)
+	{
+		return true;
+	}
+
+	if (NewNumSlots < OldNumSlots)
+	{
+		const TArray<int32>& Counts = Chunks[Entity->Chunk].Counts;
+		for (int32 Slot = Entity->First + NewNumSlots; Slot < Entity->First + OldNumSlots; ++Slot)
+		{
+			if (Counts[Slot] > 0)
+			{
+				return false;
+			}
+		}
+
+		FreeRun(Entity->Chunk, Entity->First + NewNumSlots, OldNumSlots - NewNumSlots);
+		Entity->NumSlots = NewNumSlots;
+		if (NewNumSlots == 0)
+		{
+			Entity->Chunk = INDEX_NONE;
+			Entity->First = 0;
+		}
+		return true;
+	}
+
+	if (OldNumSlots > 0 && ClaimRunAt(Entity->Chunk, Entity->First + OldNumSlots, NewNumSlots - OldNumSlots))
+	{
+		Entity->NumSlots = NewNumSlots;
+		return true;
+	}
+
+	// The old run stays allocated until its contents are copied, so the new one can't overlap it
+	int32 NewChunk = INDEX_NONE;
+	int32 NewFirst = 0;
+	if (!AllocateRun(NewNumSlots, NewChunk, NewFirst))
+	{
+		return false;
+	}
+
+	if (OldNumSlots > 0)
+	{
+		const FChunk& From = Chunks[Entity->Chunk];
+		FChunk& To = Chunks[NewChunk];
+		FMemory::Memcpy(&To.ItemIndices[NewFirst], &From.ItemIndices[Entity->First], OldNumSlots * sizeof(int32));
+		FMemory::Memcpy(&To.Counts[NewFirst], &From.Counts[Entity->First], OldNumSlots * sizeof(int32));
+		FMemory::Memcpy(&To.Instances[NewFirst], &From.Instances[Entity->First], OldNumSlots * sizeof(FItemInstanceHandle));
+		FreeRun(Entity->Chunk, Entity->First, OldNumSlots);
+	}
+
+	Entity->Chunk = NewChunk;
+	Entity->First = NewFirst;
+	Entity->NumSlots = NewNumSlots;
+	return true;
+}
+
+int32 FInventoryStore::GetNumSlots(FInventoryEntityHandle Inventory) const
+{
+	const FEntity* Entity = FindEntity(Inventory);
+	return Entity ? Entity->NumSlots : 0;
+}
+
+int32 FInventoryStore::GetFreeSlotCount(FInventoryEntityHandle Inventory) const
+{
+	const FEntity* Entity = FindEntity(Inventory);
+	return Entity ? Entity->NumSlots - Entity->OccupiedSlots : 0;
+}
+
+FInventoryStoreSlot FInventoryStore::GetSlot(FInventoryEntityHandle Inventory, int32 SlotIndex) const
+{
+	FInventoryStoreSlot Slot;
+	const FEntity* Entity = FindEntity(Inventory);
+	if (Entity && SlotIndex >= 0 && SlotIndex < Entity->NumSlots)
+	{
+		const FChunk& Chunk = Chunks[Entity->Chunk];
+		const int32 Index = Entity->First + SlotIndex;
+		Slot.ItemIndex = Chunk.ItemIndices[Index];
+		Slot.Count = Chunk.Counts[Index];
+		Slot.Instance = Chunk.Instances[Index];
+	}
+	return Slot;
+}
+
+void FInventoryStore::SetSlot(FInventoryEntityHandle Inventory, int32 SlotIndex, const FInventoryStoreSlot& Slot)
+{
+	FEntity* Entity = FindEntity(Inventory);
+	if (!Entity || SlotIndex < 0 || SlotIndex >= Entity->NumSlots)
+	{
+		return;
+	}
+
+	FChunk& Chunk = Chunks[Entity->Chunk];
+	const int32 Index = Entity->First + SlotIndex;
+	const bool bWasOccupied = Chunk.Counts[Index] > 0;
+	const bool bOccupied = !Slot.IsEmpty() && Slot.ItemIndex != INDEX_NONE;
+
+	Chunk.ItemIndices[Index] = bOccupied ? Slot.ItemIndex : INDEX_NONE;
+	Chunk.Counts[Index] = bOccupied ? Slot.Count : 0;
+	Chunk.Instances[Index] = bOccupied ? Slot.Instance : FItemInstanceHandle();
+	Entity->OccupiedSlots += int32(bOccupied) - int32(bWasOccupied);
+}
+
+int32 FInventoryStore::AddItem(FInventoryEntityHandle Inventory, int32 ItemIndex, int32 Count, int32 MaxStack)
+{
+	FEntity* Entity = FindEntity(Inventory);
+	if (!Entity || ItemIndex == INDEX_NONE || Count <= 0 || Entity->NumSlots == 0)
+	{
+		return Count;
+	}
+
+	MaxStack = FMath::Max(1, MaxStack);
+	FChunk& Chunk = Chunks[Entity->Chunk];
+	int32* ItemIndices = &Chunk.ItemIndices[Entity->First];
+	int32* Counts = &Chunk.Counts[Entity->First];
+	FItemInstanceHandle* Instances = &Chunk.Instances[Entity->First];
+
+	for (int32 Slot = 0; Slot < Entity->NumSlots && Count > 0; ++Slot)
+	{
+		if (ItemIndices[Slot] == ItemIndex && Counts[Slot] > 0 && Counts[Slot] < MaxStack && !Instances[Slot].IsValid())
+		{
+			const int32 ToAdd = FMath::Min(MaxStack - Counts[Slot], Count);
+			Counts[Slot] += ToAdd;
+			Count -= ToAdd;
+		}
+	}
+
+	for (int32 Slot = 0; Slot < Entity->NumSlots && Count > 0; ++Slot)
+	{
+		if (Counts[Slot] == 0)
+		{
+			const int32 ToAdd = FMath::Min(MaxStack, Count);
+			ItemIndices[Slot] = ItemIndex;
+			Counts[Slot] = ToAdd;
+			Instances[Slot] = FItemInstanceHandle();
+			Count -= ToAdd;
+			++Entity->OccupiedSlots;
+		}
+	}
+
+	return Count;
+}
+
+int32 FInventoryStore::RemoveItem(FInventoryEntityHandle Inventory, int32 ItemIndex, int32 Count)
+{
+	FEntity* Entity = FindEntity(Inventory);
+	if (!Entity || ItemIndex == INDEX_NONE || Count <= 0 || Entity->NumSlots == 0)
+	{
+		return 0;
+	}
+
+	FChunk& Chunk = Chunks[Entity->Chunk];
+	int32 Removed = 0;
+	for (int32 Slot = Entity->First + Entity->NumSlots - 1; Slot >= Entity->First && Removed < Count; --Slot)
+	{
+		if (Chunk.ItemIndices[Slot] != ItemIndex || Chunk.Counts[Slot] <= 0 || Chunk.Instances[Slot].IsValid())
+		{
+			continue;
+		}
+
+		const int32 ToRemove = FMath::Min(Chunk.Counts[Slot], Count - Removed);
+		Chunk.Counts[Slot] -= ToRemove;
+		Removed += ToRemove;
+
+		if (Chunk.Counts[Slot] == 0)
+		{
+			Chunk.ItemIndices[Slot] = INDEX_NONE;
+			--Entity->OccupiedSlots;
+		}
+	}
+
+	return Removed;
+}
+
+int32 FInventoryStore::GetItemCount(FInventoryEntityHandle Inventory, int32 ItemIndex) const
+{
+	const TConstArrayView<int32> ItemIndices = GetItemIndices(Inventory);
+	const TConstArrayView<int32> Counts = GetCounts(Inventory);
+
+	int32 Total = 0;
+	for (int32 Slot = 0; Slot < ItemIndices.Num(); ++Slot)
+	{
+		Total += ItemIndices[Slot] == ItemIndex ? Counts[Slot] : 0;
+	}
+	return Total;
+}
+
+TConstArrayView<int32> FInventoryStore::GetItemIndices(FInventoryEntityHandle Inventory) const
+{
+	const FEntity* Entity = FindEntity(Inventory);
+	return Entity && Entity->NumSlots > 0 ? MakeArrayView(&Chunks[Entity->Chunk].ItemIndices[Entity->First], Entity->NumSlots) : TConstArrayView<int32>();
+}
+
+TConstArrayView<int32> FInventoryStore::GetCounts(FInventoryEntityHandle Inventory) const
+{
+	const FEntity* Entity = FindEntity(Inventory);
+	return Entity && Entity->NumSlots > 0 ? MakeArrayView(&Chunks[Entity->Chunk].Counts[Entity->First], Entity->NumSlots) : TConstArrayView<int32>();
+}
+
+TConstArrayView<FItemInstanceHandle> FInventoryStore::GetInstances(FInventoryEntityHandle Inventory) const
+{
+	const FEntity* Entity = FindEntity(Inventory);
+	return Entity && Entity->NumSlots > 0 ? MakeArrayView(&Chunks[Entity->Chunk].Instances[Entity->First], Entity->NumSlots) : TConstArrayView<FItemInstanceHandle>();
+}
+
+SIZE_T FInventoryStore::GetAllocatedSize() const
+{
+	SIZE_T Size = Chunks.GetAllocatedSize() + Entities.GetAllocatedSize() + FreeEntities.GetAllocatedSize();
+	for (const FChunk& Chunk : Chunks)
+	{
+		Size += Chunk.ItemIndices.GetAllocatedSize() + Chunk.Counts.GetAllocatedSize() + Chunk.Instances.GetAllocatedSize() + Chunk.FreeRuns.GetAllocatedSize();
+	}
+	return Size;
+}
+
+void FInventoryStore::Reset()
+{
+	// Serials carry on so handles from before the reset stay stale
+	FreeEntities.Reset();
+	for (int32 EntityIndex = Entities.Num() - 1; EntityIndex >= 0; --EntityIndex)
+	{
+		FEntity& Entity = Entities[EntityIndex];
+		if (Entity.bAlive)
+		{
+			++Entity.Serial;
+		}
+		Entity = FEntity{ Entity.Serial };
+		FreeEntities.Add(EntityIndex);
+	}
+	Chunks.Empty();
+}
+
+const FInventoryStore::FEntity* FInventoryStore::FindEntity(FInventoryEntityHandle Inventory) const
+{
+	if (!Entities.IsValidIndex(Inventory.Index))
+	{
+		return nullptr;
+	}
+
+	const FEntity& Entity = Entities[Inventory.Index];
+	return Entity.bAlive && Entity.Serial == Inventory.Serial ? &Entity : nullptr;
+}
+
+bool FInventoryStore::AllocateRun(int32 NumSlots, int32& OutChunk, int32& OutFirst)
+{
+	check(NumSlots > 0 && NumSlots <= SlotsPerChunk);
+
+	for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+	{
+		TArray<FSlotRun>& FreeRuns = Chunks[ChunkIndex].FreeRuns;
+		for (int32 RunIndex = 0; RunIndex < FreeRuns.Num(); ++RunIndex)
+		{
+			FSlotRun& Run = FreeRuns[RunIndex];
+			if (Run.Num < NumSlots)
+			{
+				continue;
+			}
+
+			OutChunk = ChunkIndex;
+			OutFirst = Run.First;
+			Run.First += NumSlots;
+			Run.Num -= NumSlots;
+			if (Run.Num == 0)
+			{
+				FreeRuns.RemoveAt(RunIndex, 1, EAllowShrinking::No);
+			}
+			return true;
+		}
+	}
+
+	OutChunk = Chunks.AddDefaulted();
+	OutFirst = 0;
+
+	FChunk& Chunk = Chunks[OutChunk];
+	Chunk.ItemIndices.Init(INDEX_NONE, SlotsPerChunk);
+	Chunk.Counts.Init(0, SlotsPerChunk);
+	Chunk.Instances.SetNum(SlotsPerChunk);
+	if (NumSlots < SlotsPerChunk)
+	{
+		Chunk.FreeRuns.Add({ NumSlots, SlotsPerChunk - NumSlots });
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("Inventory store: chunk %d added (%d inventories)"), Chunks.Num(), GetNumInventories());
+	return true;
+}
+
+void FInventoryStore::FreeRun(int32 ChunkIndex, int32 First, int32 NumSlots)
+{
+	FChunk& Chunk = Chunks[ChunkIndex];
+	for (int32 Slot = First; Slot < First + NumSlots; ++Slot)
+	{
+		Chunk.ItemIndices[Slot] = INDEX_NONE;
+		Chunk.Counts[Slot] = 0;
+		Chunk.Instances[Slot] = FItemInstanceHandle();
+	}
+
+	TArray<FSlotRun>& FreeRuns = Chunk.FreeRuns;
+	const int32 Insert = Algo::LowerBoundBy(FreeRuns, First, &FSlotRun::First);
+	FreeRuns.Insert({ First, NumSlots }, Insert);
+
+	// Merge with the following run, then the preceding one
+	if (FreeRuns.IsValidIndex(Insert + 1) && FreeRuns[Insert].First + FreeRuns[Insert].Num == FreeRuns[Insert + 1].First)
+	{
+		FreeRuns[Insert].Num += FreeRuns[Insert + 1].Num;
+		FreeRuns.RemoveAt(Insert + 1, 1, EAllowShrinking::No);
+	}
+	if (Insert > 0 && FreeRuns[Insert - 1].First + FreeRuns[Insert - 1].Num == FreeRuns[Insert].First)
+	{
+		FreeRuns[Insert - 1].Num += FreeRuns[Insert].Num;
+		FreeRuns.RemoveAt(Insert, 1, EAllowShrinking::No);
+	}
+}
+
+bool FInventoryStore::ClaimRunAt(int32 ChunkIndex, int32 First, int32 NumSlots)
+{
+	TArray<FSlotRun>& FreeRuns = Chunks[ChunkIndex].FreeRuns;
+	const int32 RunIndex = Algo::LowerBoundBy(FreeRuns, First, &FSlotRun::First);
+	if (!FreeRuns.IsValidIndex(RunIndex) || FreeRuns[RunIndex].First != First || FreeRuns[RunIndex].Num < NumSlots)
+	{
+		return false;
+	}
+
+	FSlotRun& Run = FreeRuns[RunIndex];
+	Run.First += NumSlots;
+	Run.Num -= NumSlots;
+	if (Run.Num == 0)
+	{
+		FreeRuns.RemoveAt(RunIndex, 1, EAllowShrinking::No);
+	}
+	return true;
+}
@@ -0,0 +1,41 @@
+// InventoryStoreSubsystem.cpp
+#include "InventoryStoreSubsystem.h"
+#include "ItemRegistrySubsystem.h"
+#include "Engine/World.h"
+
+UInventoryStoreSubsystem* UInventoryStoreSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UInventoryStoreSubsystem>() : nullptr;
+}
+
+void UInventoryStoreSubsystem::Deinitialize()
+{
+	if (Store.GetNumChunks() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Inventory store: %d inventories left in %d chunks (%llu KB)"), Store.GetNumInventories(), Store.GetNumChunks(), uint64(Store.GetAllocatedSize() / 1024));
+	}
+	Store.Reset();
+
+	Super::Deinitialize();
+}
+
+int32 UInventoryStoreSubsystem::AddItem(FInventoryEntityHandle Inventory, const FS_ItemInfo& Item, int32 Count)
+{
+	UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+	const int32 ItemIndex = Registry ? Registry->RegisterItem(Item) : INDEX_NONE;
+	return Store.AddItem(Inventory, ItemIndex, Count, Item.GetMaxStack());
+}
+
+int32 UInventoryStoreSubsystem::RemoveItem(FInventoryEntityHandle Inventory, FName ItemID, int32 Count)
+{
+	const UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+	return Registry ? Store.RemoveItem(Inventory, Registry->FindItemIndex(ItemID), Count) : 0;
+}
+
+int32 UInventoryStoreSubsystem::GetItemCount(FInventoryEntityHandle Inventory, FName ItemID) const
+{
+	const UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+	const int32 ItemIndex = Registry ? Registry->FindItemIndex(ItemID) : INDEX_NONE;
+	return ItemIndex != INDEX_NONE ? Store.GetItemCount(Inventory, ItemIndex) : 0;
+}
@@ -0,0 +1,43 @@
+// InventoryTransfer.cpp
+#include "InventoryTransfer.h"
+#include "BagComponent.h"
+#include "EquipmentComponent.h"
+
+FInventoryContainerHandle FInventoryContainerHandle::ForBag(UBagComponent* Bag)
+{
+	FInventoryContainerHandle Handle;
+	if (Bag)
+	{
+		Handle.Kind = EInventoryContainerKind::Bag;
+		Handle.Container = Bag;
+	}
+	return Handle;
+}
+
+FInventoryContainerHandle FInventoryContainerHandle::ForEquipment(UEquipmentComponent* Equipment)
+{
+	FInventoryContainerHandle Handle;
+	if (Equipment)
+	{
+		Handle.Kind = EInventoryContainerKind::Equipment;
+		Handle.Container = Equipment;
+	}
+	return Handle;
+}
+
+FInventoryContainerHandle FInventoryContainerHandle::ForKind(EInventoryContainerKind InKind)
+{
+	FInventoryContainerHandle Handle;
+	Handle.Kind = InKind;
+	return Handle;
+}
+
+UBagComponent* FInventoryContainerHandle::GetBag() const
+{
+	return Kind == EInventoryContainerKind::Bag ? Cast<UBagComponent>(Container) : nullptr;
+}
+
+UEquipmentComponent* FInventoryContainerHandle::GetEquipment() const
+{
+	return Kind == EInventoryContainerKind::Equipment ? Cast<UEquipmentComponent>(Container) : nullptr;
+}
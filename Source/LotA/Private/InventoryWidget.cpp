@@ -3,18 +3,26 @@
 #include "Components/UniformGridPanel.h"
 #include "Components/UniformGridSlot.h"
 #include "InventorySlotWidget.h"
+#include "InventoryWidgetPoolSubsystem.h"
 #include "S_ItemInfo.h"
 
 UInventoryWidget::UInventoryWidget(const FObjectInitializer& ObjectInitializer)
    : Super(ObjectInitializer)
    , NumRows(0)
    , NumColumns(0)
+   , FilteredOutOpacity(0.35f)
+   , NumFilterMatches(0)
 {
 }
 
 void UInventoryWidget::NativeConstruct()
 {
     Super::NativeConstruct();
+
+    if (UInventoryWidgetPoolSubsystem* Pool = UInventoryWidgetPoolSubsystem::Get(GetOwningPlayer()))
+    {
+        Pool->OnFilterChanged.AddUObject(this, &UInventoryWidget::HandleFilterChanged);
+    }
     
     // Add debug prints
     UE_LOG(LogTemp, Warning, TEXT("=== InventoryWidget NativeConstruct start ==="));
@@ -22,6 +30,16 @@ void UInventoryWidget::NativeConstruct()
     InitializeInventory(5, 2);  // 5 rows, 2 columns
 }
 
+void UInventoryWidget::NativeDestruct()
+{
+    if (UInventoryWidgetPoolSubsystem* Pool = UInventoryWidgetPoolSubsystem::Get(GetOwningPlayer()))
+    {
+        Pool->OnFilterChanged.RemoveAll(this);
+    }
+
+    Super::NativeDestruct();
+}
+
 void UInventoryWidget::InitializeInventory(int32 Rows, int32 Columns)
 {
     UE_LOG(LogTemp, Warning, TEXT("=== InitializeInventory start ==="));
@@ -52,6 +70,9 @@ void UInventoryWidget::CreateInventorySlots()
         return;
     }
 
+    const UInventoryWidgetPoolSubsystem* Pool = UInventoryWidgetPoolSubsystem::Get(GetOwningPlayer());
+    const FInventoryFilter* Filter = Pool ? Pool->GetActiveFilter() : nullptr;
+
     // Load the actual blueprint widget class
     const FSoftClassPath WidgetClassPath(TEXT("/Game/Inventory/Widgets/WBP_InventorySlot.WBP_InventorySlot_C"));
     UClass* SlotWidgetClass = WidgetClassPath.TryLoadClass<UInventorySlotWidget>();
@@ -78,6 +99,10 @@ void UInventoryWidget::CreateInventorySlots()
                     GridSlot->SetColumn(Col);
                     UE_LOG(LogTemp, Warning, TEXT("Created slot at row %d, column %d"), Row, Col);
                 }
+                if (Filter)
+                {
+                    NewSlot->ApplyFilter(Filter, FilteredOutOpacity);
+                }
                 InventorySlots.Add(NewSlot);
             }
             else
@@ -105,6 +130,8 @@ void UInventoryWidget::AddTestItem(int32 SlotIndex)
        TestItem.ItemType = EItemType::Consumable;
        TestItem.Weight = 0.5f;
        TestItem.MaxStackSize = 20;
+       TestItem.CooldownGroup = FName("Potion");
+       TestItem.CooldownSeconds = 2.0f;
        TestItem.ItemIcon = Cast<UTexture2D>(StaticLoadObject(UTexture2D::StaticClass(), nullptr, TEXT("/Game/Inventory/Textures/T_HealthPotion")));
 
        if (TestItem.ItemIcon)
@@ -114,4 +141,26 @@ void UInventoryWidget::AddTestItem(int32 SlotIndex)
 
        InventorySlot->SetItemDetails(TestItem, 5);
    }
-}
\ No newline at end of file
+}
+
+void UInventoryWidget::SetFilter(const FString& Query, int32 TypeMask)
+{
+    // The filter lives in the pool so bag windows share it; HandleFilterChanged re-tests this grid
+    if (UInventoryWidgetPoolSubsystem* Pool = UInventoryWidgetPoolSubsystem::Get(GetOwningPlayer()))
+    {
+        Pool->SetFilter(Query, static_cast<uint8>(TypeMask));
+    }
+}
+
+void UInventoryWidget::HandleFilterChanged(EItemFilterChange Change)
+{
+    if (const UInventoryWidgetPoolSubsystem* Pool = UInventoryWidgetPoolSubsystem::Get(GetOwningPlayer()))
+    {
+        NumFilterMatches = Pool->ApplyFilter(InventorySlots, Change, FilteredOutOpacity);
+    }
+}
+
+void UInventoryWidget::ClearFilter()
+{
+    SetFilter(FString(), ItemTypeMask::All);
+}
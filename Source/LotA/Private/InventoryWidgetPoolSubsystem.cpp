@@ -0,0 +1,101 @@
+// InventoryWidgetPoolSubsystem.cpp
+#include "InventoryWidgetPoolSubsystem.h"
+#include "InventorySlotWidget.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+
+UInventoryWidgetPoolSubsystem* UInventoryWidgetPoolSubsystem::Get(const APlayerController* PlayerController)
+{
+	const ULocalPlayer* LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+	return LocalPlayer ? LocalPlayer->GetSubsystem<UInventoryWidgetPoolSubsystem>() : nullptr;
+}
+
+UInventorySlotWidget* UInventoryWidgetPoolSubsystem::AcquireSlotWidget(APlayerController* OwningPlayer)
+{
+	while (FreeWidgets.Num() > 0)
+	{
+		UInventorySlotWidget* PooledWidget = FreeWidgets.Pop(EAllowShrinking::No);
+		CachedSlateWidgets.Pop(EAllowShrinking::No);
+		if (IsValid(PooledWidget))
+		{
+			return PooledWidget;
+		}
+	}
+
+	if (!SlotWidgetClass)
+	{
+		const FSoftClassPath WidgetClassPath(TEXT("/Game/Inventory/Widgets/WBP_InventorySlot.WBP_InventorySlot_C"));
+		SlotWidgetClass = WidgetClassPath.TryLoadClass<UInventorySlotWidget>();
+		if (!SlotWidgetClass)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to load WBP_InventorySlot class for widget pool"));
+			return nullptr;
+		}
+	}
+
+	return OwningPlayer ? CreateWidget<UInventorySlotWidget>(OwningPlayer, SlotWidgetClass) : nullptr;
+}
+
+void UInventoryWidgetPoolSubsystem::ReleaseSlotWidget(UInventorySlotWidget* SlotWidget)
+{
+	if (!IsValid(SlotWidget))
+	{
+		return;
+	}
+
+	// The next window to acquire it applies the filter with its own opacity
+	SlotWidget->RemoveFromParent();
+	SlotWidget->ApplyFilter(nullptr, 1.0f);
+	SlotWidget->BindToBagSlot(nullptr, INDEX_NONE);
+	SlotWidget->ClearSlot();
+
+	if (FreeWidgets.Num() >= MaxPooledWidgets || FreeWidgets.Contains(SlotWidget))
+	{
+		return;
+	}
+
+	FreeWidgets.Add(SlotWidget);
+	CachedSlateWidgets.Add(SlotWidget->GetCachedWidget());
+}
+
+EItemFilterChange UInventoryWidgetPoolSubsystem::SetFilter(const FString& Query, uint8 TypeMask)
+{
+	const EItemFilterChange Change = ActiveFilter.Set(Query, TypeMask);
+	if (Change != EItemFilterChange::None)
+	{
+		OnFilterChanged.Broadcast(Change);
+	}
+	return Change;
+}
+
+int32 UInventoryWidgetPoolSubsystem::ApplyFilter(TConstArrayView<UInventorySlotWidget*> SlotWidgets, EItemFilterChange Change, float FilteredOutOpacity) const
+{
+	const FInventoryFilter* Filter = GetActiveFilter();
+	int32 NumMatches = 0;
+
+	for (UInventorySlotWidget* SlotWidget : SlotWidgets)
+	{
+		if (!SlotWidget)
+		{
+			continue;
+		}
+
+		// Narrowing can only hide current matches and widening can only reveal current misses,
+		// so the other half of the slots keeps its state untouched
+		const bool bSkip = (Change == EItemFilterChange::Narrowed && !SlotWidget->MatchesFilter())
+			|| (Change == EItemFilterChange::Widened && SlotWidget->MatchesFilter());
+
+		const bool bMatches = bSkip ? SlotWidget->MatchesFilter() : SlotWidget->ApplyFilter(Filter, FilteredOutOpacity);
+		NumMatches += bMatches ? 1 : 0;
+	}
+	return NumMatches;
+}
+
+void UInventoryWidgetPoolSubsystem::Deinitialize()
+{
+	OnFilterChanged.Clear();
+	FreeWidgets.Empty();
+	CachedSlateWidgets.Empty();
+
+	Super::Deinitialize();
+}
@@ -1,6 +1,8 @@
 ﻿#include "ItemBase.h"
+#include "ItemInstanceSubsystem.h"
 
 AItemBase::AItemBase()
+	: StackCount(1)
 {
 	PrimaryActorTick.bCanEverTick = true;
 }
@@ -10,6 +12,28 @@ void AItemBase::BeginPlay()
 	Super::BeginPlay();
 }
 
+void AItemBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// A pickup that still holds its instance is taking the item out of the game with it
+	if (HasAuthority() && InstanceHandle.IsValid())
+	{
+		if (UItemInstanceSubsystem* Instances = UItemInstanceSubsystem::Get(this))
+		{
+			Instances->ReleaseInstance(InstanceHandle);
+		}
+		InstanceHandle = FItemInstanceHandle();
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+FItemInstanceHandle AItemBase::TakeInstance()
+{
+	const FItemInstanceHandle Taken = InstanceHandle;
+	InstanceHandle = FItemInstanceHandle();
+	return Taken;
+}
+
 void AItemBase::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
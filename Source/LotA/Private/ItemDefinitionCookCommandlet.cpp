@@ -0,0 +1,121 @@
+// ItemDefinitionCookCommandlet.cpp
+#include "ItemDefinitionCookCommandlet.h"
+#include "ItemDefinitionTable.h"
+#include "ItemBase.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/UObjectIterator.h"
+
+UItemDefinitionCookCommandlet::UItemDefinitionCookCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+}
+
+int32 UItemDefinitionCookCommandlet::Main(const FString& Params)
+{
+	FString OutPath = FItemDefinitionTable::GetDefaultPath();
+	FParse::Value(*Params, TEXT("Out="), OutPath);
+	const bool bValidateOnly = FParse::Param(*Params, TEXT("ValidateOnly"));
+
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	// Blueprint item classes are only known to the asset registry until they are loaded
+	TSet<FTopLevelAssetPath> ClassPaths;
+	AssetRegistry.GetDerivedClassNames({ AItemBase::StaticClass()->GetClassPathName() }, {}, ClassPaths);
+
+	TArray<UClass*> ItemClasses;
+	for (const FTopLevelAssetPath& ClassPath : ClassPaths)
+	{
+		UClass* ItemClass = TSoftClassPtr<AItemBase>(FSoftObjectPath(ClassPath)).LoadSynchronous();
+		if (ItemClass)
+		{
+			ItemClasses.AddUnique(ItemClass);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Could not load item class %s"), *ClassPath.ToString());
+		}
+	}
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (It->IsChildOf(AItemBase::StaticClass()) && It->HasAnyClassFlags(CLASS_Native))
+		{
+			ItemClasses.AddUnique(*It);
+		}
+	}
+
+	// Path order keeps the cooked file stable between runs
+	ItemClasses.Sort([](const UClass& A, const UClass& B) { return A.GetPathName() < B.GetPathName(); });
+
+	FItemDefinitionTable Table;
+	TMap<FName, FString> SourceByID;
+	TArray<FString> Problems;
+
+	for (const UClass* ItemClass : ItemClasses)
+	{
+		// Transient classes are tool and bench stand-ins that never ship as items
+		if (ItemClass->HasAnyClassFlags(CLASS_Abstract | CLASS_Deprecated | CLASS_NewerVersionExists | CLASS_Transient)
+			|| ItemClass->GetName().StartsWith(TEXT("SKEL_")) || ItemClass->GetName().StartsWith(TEXT("REINST_")))
+		{
+			continue;
+		}
+
+		const FS_ItemInfo& Item = GetDefault<AItemBase>(ItemClass)->ItemDetails;
+
+		// Base classes that only share setup between items leave the ID empty
+		if (Item.ItemID.IsNone())
+		{
+			UE_LOG(LogTemp, Display, TEXT("Skipping %s: no ItemID"), *ItemClass->GetPathName());
+			continue;
+		}
+
+		if (const FString* FirstSource = SourceByID.Find(Item.ItemID))
+		{
+			Problems.Add(FString::Printf(TEXT("%s: ItemID used by both %s and %s"), *Item.ItemID.ToString(), **FirstSource, *ItemClass->GetPathName()));
+			continue;
+		}
+		SourceByID.Add(Item.ItemID, ItemClass->GetPathName());
+
+		if (FItemDefinitionTable::ValidateDefinition(Item, Problems))
+		{
+			Table.Add(Item);
+		}
+	}
+
+	for (const FString& Problem : Problems)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s"), *Problem);
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("Item definitions: %d classes, %d valid, %d problems, %d interned strings"),
+		ItemClasses.Num(), Table.Num(), Problems.Num(), Table.Strings.Num());
+
+	if (Problems.Num() > 0)
+	{
+		return 1;
+	}
+
+	if (!bValidateOnly)
+	{
+		if (!Table.SaveToFile(OutPath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to write %s"), *OutPath);
+			return 1;
+		}
+
+		// Read it back the way the registry will, so a run that reports success left a usable table
+		FItemDefinitionTable Written;
+		if (!Written.LoadFromFile(OutPath) || Written.Num() != Table.Num())
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s did not read back as the %d definitions written"), *OutPath, Table.Num());
+			return 1;
+		}
+		UE_LOG(LogTemp, Display, TEXT("Wrote %s (%d definitions)"), *OutPath, Written.Num());
+	}
+	return 0;
+}
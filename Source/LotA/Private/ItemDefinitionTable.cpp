@@ -0,0 +1,221 @@
+// ItemDefinitionTable.cpp
+#include "ItemDefinitionTable.h"
+#include "Engine/Texture2D.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+FArchive& operator<<(FArchive& Ar, FCookedItemDefinition& Definition)
+{
+	Ar << Definition.ItemName;
+	Ar << Definition.ItemDescription;
+	Ar << Definition.IconPathIndex;
+	Ar << Definition.CooldownGroupIndex;
+	Ar << Definition.Weight;
+	Ar << Definition.MaxStackSize;
+	Ar << Definition.BagSlots;
+	Ar << Definition.WeightReductionPercentage;
+	Ar << Definition.CooldownSeconds;
+	Ar << Definition.MaxDurability;
+	Ar << Definition.Stats.Armor << Definition.Stats.Damage << Definition.Stats.Strength;
+	Ar << Definition.Stats.Agility << Definition.Stats.Stamina << Definition.Stats.Intellect;
+	Ar << Definition.ItemType;
+	Ar << Definition.EquipSlot;
+	Ar << Definition.bUniqueInstance;
+	return Ar;
+}
+
+FString FItemDefinitionTable::GetDefaultPath()
+{
+	return FPaths::Combine(FPaths::ProjectContentDir(), TEXT("Data"), TEXT("ItemDefinitions.bin"));
+}
+
+bool FItemDefinitionTable::ValidateDefinition(const FS_ItemInfo& Item, TArray<FString>& OutProblems)
+{
+	const int32 ProblemsBefore = OutProblems.Num();
+	auto Problem = [&OutProblems, &Item](const FString& Message)
+	{
+		OutProblems.Add(FString::Printf(TEXT("%s: %s"), *Item.ItemID.ToString(), *Message));
+	};
+
+	if (Item.ItemID.IsNone())
+	{
+		Problem(TEXT("ItemID is not set"));
+	}
+	if (Item.ItemName.IsEmpty())
+	{
+		Problem(TEXT("ItemName is empty"));
+	}
+	if (!Item.ItemIcon)
+	{
+		Problem(TEXT("ItemIcon is not set"));
+	}
+	if (Item.Weight < 0.0f)
+	{
+		Problem(FString::Printf(TEXT("Weight is negative (%g)"), Item.Weight));
+	}
+	if (Item.MaxStackSize < 1)
+	{
+		Problem(FString::Printf(TEXT("MaxStackSize must be at least 1 (%d)"), Item.MaxStackSize));
+	}
+	if (Item.bUniqueInstance && Item.MaxStackSize != 1)
+	{
+		Problem(TEXT("unique items can't stack, MaxStackSize must be 1"));
+	}
+
+	switch (Item.ItemType)
+	{
+	case EItemType::Bag:
+		if (Item.BagSlots <= 0)
+		{
+			Problem(FString::Printf(TEXT("bag has no slots (BagSlots = %d)"), Item.BagSlots));
+		}
+		if (Item.WeightReductionPercentage < 0.0f || Item.WeightReductionPercentage > 100.0f)
+		{
+			Problem(FString::Printf(TEXT("WeightReductionPercentage must be 0-100 (%g)"), Item.WeightReductionPercentage));
+		}
+		break;
+
+	case EItemType::Equipment:
+		if (Item.EquipSlot == EEquipmentSlot::None || Item.EquipSlot == EEquipmentSlot::MAX || (Item.EquipSlot >= EEquipmentSlot::Bag1 && Item.EquipSlot <= EEquipmentSlot::Bag4))
+		{
+			Problem(TEXT("equipment has no valid EquipSlot"));
+		}
+		break;
+
+	case EItemType::Consumable:
+		if (Item.CooldownSeconds < 0.0f)
+		{
+			Problem(FString::Printf(TEXT("CooldownSeconds is negative (%g)"), Item.CooldownSeconds));
+		}
+		break;
+
+	default:
+		break;
+	}
+
+	return OutProblems.Num() == ProblemsBefore;
+}
+
+int32 FItemDefinitionTable::Add(const FS_ItemInfo& Item)
+{
+	FCookedItemDefinition& Definition = Definitions.AddDefaulted_GetRef();
+	Definition.ItemName = Item.ItemName;
+	Definition.ItemDescription = Item.ItemDescription;
+	Definition.IconPathIndex = Item.ItemIcon ? InternString(FSoftObjectPath(Item.ItemIcon).ToString()) : INDEX_NONE;
+	Definition.CooldownGroupIndex = Item.CooldownGroup.IsNone() ? INDEX_NONE : InternString(Item.CooldownGroup.ToString());
+	Definition.Weight = Item.Weight;
+	Definition.MaxStackSize = Item.MaxStackSize;
+	Definition.BagSlots = Item.BagSlots;
+	Definition.WeightReductionPercentage = Item.WeightReductionPercentage;
+	Definition.CooldownSeconds = Item.CooldownSeconds;
+	Definition.MaxDurability = Item.MaxDurability;
+	Definition.Stats = Item.Stats;
+	Definition.ItemType = Item.ItemType;
+	Definition.EquipSlot = Item.EquipSlot;
+	Definition.bUniqueInstance = Item.bUniqueInstance;
+
+	return ItemIDs.Add(Item.ItemID);
+}
+
+FS_ItemInfo FItemDefinitionTable::ToItemInfo(int32 Index) const
+{
+	FS_ItemInfo Item;
+	if (!Definitions.IsValidIndex(Index))
+	{
+		return Item;
+	}
+
+	const FCookedItemDefinition& Definition = Definitions[Index];
+	const FString* CooldownGroup = FindString(Definition.CooldownGroupIndex);
+
+	Item.ItemID = ItemIDs[Index];
+	Item.ItemName = Definition.ItemName;
+	Item.ItemDescription = Definition.ItemDescription;
+	Item.ItemType = Definition.ItemType;
+	Item.Weight = Definition.Weight;
+	Item.MaxStackSize = Definition.MaxStackSize;
+	Item.BagSlots = Definition.BagSlots;
+	Item.WeightReductionPercentage = Definition.WeightReductionPercentage;
+	Item.CooldownGroup = CooldownGroup ? FName(**CooldownGroup) : NAME_None;
+	Item.CooldownSeconds = Definition.CooldownSeconds;
+	Item.EquipSlot = Definition.EquipSlot;
+	Item.Stats = Definition.Stats;
+	Item.bUniqueInstance = Definition.bUniqueInstance;
+	Item.MaxDurability = Definition.MaxDurability;
+	return Item;
+}
+
+FSoftObjectPath FItemDefinitionTable::GetIconPath(int32 Index) const
+{
+	const FString* Path = Definitions.IsValidIndex(Index) ? FindString(Definitions[Index].IconPathIndex) : nullptr;
+	return Path ? FSoftObjectPath(*Path) : FSoftObjectPath();
+}
+
+bool FItemDefinitionTable::SaveToFile(const FString& Path) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	const_cast<FItemDefinitionTable*>(this)->Serialize(Writer);
+	return FFileHelper::SaveArrayToFile(Bytes, *Path);
+}
+
+bool FItemDefinitionTable::LoadFromFile(const FString& Path)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	Serialize(Reader);
+	return !Reader.IsError();
+}
+
+void FItemDefinitionTable::Serialize(FArchive& Ar)
+{
+	uint32 Magic = ExpectedMagic;
+	uint32 Version = CurrentVersion;
+	Ar << Magic << Version;
+
+	if (Ar.IsLoading() && (Magic != ExpectedMagic || Version != CurrentVersion))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Item definition table has magic %08x version %u, expected %08x version %u; re-run the ItemDefinitionCook commandlet"),
+			Magic, Version, ExpectedMagic, CurrentVersion);
+		Ar.SetError();
+		return;
+	}
+
+	Ar << Strings;
+	Ar << ItemIDs;
+	Ar << Definitions;
+
+	if (Ar.IsLoading())
+	{
+		if (ItemIDs.Num() != Definitions.Num())
+		{
+			Ar.SetError();
+			return;
+		}
+
+		StringIndices.Reset();
+		for (int32 Index = 0; Index < Strings.Num(); ++Index)
+		{
+			StringIndices.Add(Strings[Index], Index);
+		}
+	}
+}
+
+int32 FItemDefinitionTable::InternString(const FString& String)
+{
+	if (const int32* Existing = StringIndices.Find(String))
+	{
+		return *Existing;
+	}
+
+	const int32 Index = Strings.Add(String);
+	StringIndices.Add(String, Index);
+	return Index;
+}
@@ -0,0 +1,67 @@
+// ItemFilter.cpp
+#include "ItemFilter.h"
+#include "ItemRegistrySubsystem.h"
+
+namespace
+{
+	// Enough for any reasonable search box without reallocating
+	constexpr int32 QueryReserveLength = 64;
+}
+
+FInventoryFilter::FInventoryFilter()
+	: TypeMask(ItemTypeMask::All)
+{
+	Query.Reserve(QueryReserveLength);
+	PreviousQuery.Reserve(QueryReserveLength);
+}
+
+EItemFilterChange FInventoryFilter::Set(const FString& InQuery, uint8 InTypeMask)
+{
+	const uint8 PreviousTypeMask = TypeMask;
+
+	// Swap keeps both buffers' capacity alive
+	Swap(Query, PreviousQuery);
+	Query.Reset();
+	Query.Append(InQuery);
+	Query.TrimStartAndEndInline();
+	Query.ToLowerInline();
+	TypeMask = InTypeMask;
+
+	const bool bSameQuery = Query.Equals(PreviousQuery, ESearchCase::CaseSensitive);
+	if (bSameQuery && TypeMask == PreviousTypeMask)
+	{
+		return EItemFilterChange::None;
+	}
+
+	// A longer query containing the old one, and a subset of types, can only remove matches
+	const bool bQueryNarrowed = bSameQuery || PreviousQuery.IsEmpty() || Query.Contains(PreviousQuery, ESearchCase::CaseSensitive);
+	const bool bTypesNarrowed = (TypeMask & ~PreviousTypeMask) == 0;
+	if (bQueryNarrowed && bTypesNarrowed)
+	{
+		return EItemFilterChange::Narrowed;
+	}
+
+	const bool bQueryWidened = bSameQuery || Query.IsEmpty() || PreviousQuery.Contains(Query, ESearchCase::CaseSensitive);
+	const bool bTypesWidened = (PreviousTypeMask & ~TypeMask) == 0;
+	if (bQueryWidened && bTypesWidened)
+	{
+		return EItemFilterChange::Widened;
+	}
+
+	return EItemFilterChange::Replaced;
+}
+
+bool FInventoryFilter::Matches(const FItemRegistryEntry* Entry) const
+{
+	if (!Entry)
+	{
+		return !IsActive();
+	}
+
+	if ((Entry->TypeMask & TypeMask) == 0)
+	{
+		return false;
+	}
+
+	return Query.IsEmpty() || Entry->SearchKey.Contains(Query, ESearchCase::CaseSensitive);
+}
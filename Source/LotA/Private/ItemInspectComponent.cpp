@@ -0,0 +1,109 @@
+// ItemInspectComponent.cpp
+#include "ItemInspectComponent.h"
+#include "BagComponent.h"
+#include "InventoryRegistryComponent.h"
+#include "EquipmentComponent.h"
+#include "InventorySlotDataComponent.h"
+#include "ItemInstanceSubsystem.h"
+#include "GameFramework/Controller.h"
+#include "GameFramework/Pawn.h"
+
+UItemInspectComponent::UItemInspectComponent()
+	: InspectCacheSeconds(10.0f)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void UItemInspectComponent::InspectInstance(FItemInstanceHandle Handle)
+{
+	if (!Handle.IsValid())
+	{
+		return;
+	}
+
+	UItemInstanceSubsystem* Instances = UItemInstanceSubsystem::Get(this);
+	if (!Instances)
+	{
+		return;
+	}
+
+	// A listen server or standalone game owns the table itself
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		if (const FItemInstanceData* Data = Instances->FindInstance(Handle))
+		{
+			OnInstanceInspected.Broadcast(Handle, *Data);
+		}
+		return;
+	}
+
+	if (const FItemInstanceData* Cached = Instances->FindInspected(Handle, InspectCacheSeconds))
+	{
+		OnInstanceInspected.Broadcast(Handle, *Cached);
+		return;
+	}
+
+	ServerInspectInstance(Handle);
+}
+
+void UItemInspectComponent::ServerInspectInstance_Implementation(FItemInstanceHandle Handle)
+{
+	const UItemInstanceSubsystem* Instances = UItemInstanceSubsystem::Get(this);
+	const FItemInstanceData* Data = Instances ? Instances->FindInstance(Handle) : nullptr;
+
+	// Players only get to look at their own items
+	if (Data && IsOwnedInstance(Handle))
+	{
+		ClientReceiveInstance(Handle, *Data);
+	}
+}
+
+void UItemInspectComponent::ClientReceiveInstance_Implementation(FItemInstanceHandle Handle, const FItemInstanceData& Data)
+{
+	if (UItemInstanceSubsystem* Instances = UItemInstanceSubsystem::Get(this))
+	{
+		Instances->CacheInspected(Handle, Data);
+	}
+	OnInstanceInspected.Broadcast(Handle, Data);
+}
+
+bool UItemInspectComponent::IsOwnedInstance(FItemInstanceHandle Handle) const
+{
+	const APawn* Pawn = GetControlledPawn();
+	if (!Pawn)
+	{
+		return false;
+	}
+
+	if (const UEquipmentComponent* Equipment = Pawn->FindComponentByClass<UEquipmentComponent>())
+	{
+		for (int32 SlotIndex = 0; SlotIndex < UEquipmentComponent::NumSlots; ++SlotIndex)
+		{
+			if (Equipment->GetEquippedInstance(static_cast<EEquipmentSlot>(SlotIndex)) == Handle)
+			{
+				return true;
+			}
+		}
+	}
+
+	TArray<UBagComponent*> Bags;
+	UInventoryRegistryComponent::GetBagsOf(Pawn, Bags);
+	for (const UBagComponent* Bag : Bags)
+	{
+		for (const UInventorySlotDataComponent* Slot : Bag->GetInventorySlots())
+		{
+			if (Slot && Slot->GetInstanceHandle() == Handle)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+APawn* UItemInspectComponent::GetControlledPawn() const
+{
+	const AController* Controller = Cast<AController>(GetOwner());
+	return Controller ? Controller->GetPawn() : nullptr;
+}
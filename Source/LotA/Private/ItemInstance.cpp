@@ -0,0 +1,21 @@
+// ItemInstance.cpp
+#include "ItemInstance.h"
+
+float FItemInstanceData::GetProperty(FName Key, float DefaultValue) const
+{
+	const FItemInstanceProperty* Property = Properties.FindByPredicate([Key](const FItemInstanceProperty& Entry) { return Entry.Key == Key; });
+	return Property ? Property->Value : DefaultValue;
+}
+
+void FItemInstanceData::SetProperty(FName Key, float Value)
+{
+	if (FItemInstanceProperty* Property = Properties.FindByPredicate([Key](const FItemInstanceProperty& Entry) { return Entry.Key == Key; }))
+	{
+		Property->Value = Value;
+		return;
+	}
+
+	FItemInstanceProperty& NewProperty = Properties.AddDefaulted_GetRef();
+	NewProperty.Key = Key;
+	NewProperty.Value = Value;
+}
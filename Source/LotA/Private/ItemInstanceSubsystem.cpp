@@ -0,0 +1,147 @@
+// ItemInstanceSubsystem.cpp
+#include "ItemInstanceSubsystem.h"
+#include "Engine/World.h"
+
+UItemInstanceSubsystem::UItemInstanceSubsystem()
+	: StatRollFraction(0.2f)
+	, MaxInspectedInstances(64)
+{
+}
+
+UItemInstanceSubsystem* UItemInstanceSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UItemInstanceSubsystem>() : nullptr;
+}
+
+void UItemInstanceSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	RollStream.GenerateNewSeed();
+}
+
+FItemInstanceHandle UItemInstanceSubsystem::CreateInstance(const FS_ItemInfo& Item)
+{
+	FInstanceEntry Entry;
+	Entry.Serial = NextSerial++;
+	Entry.Data.Guid = FGuid::NewGuid();
+	Entry.Data.ItemID = Item.ItemID;
+	Entry.Data.MaxDurability = Item.MaxDurability;
+	Entry.Data.Durability = Item.MaxDurability;
+	if (Item.ItemType == EItemType::Equipment)
+	{
+		Entry.Data.RolledStats = RollStats(Item.Stats);
+	}
+
+	FItemInstanceHandle Handle;
+	Handle.Serial = Entry.Serial;
+	Handle.Index = Instances.Add(MoveTemp(Entry));
+	IndexByGuid.Add(Instances[Handle.Index].Data.Guid, Handle.Index);
+	return Handle;
+}
+
+FItemStats UItemInstanceSubsystem::RollStats(const FItemStats& Base)
+{
+	const float Fraction = FMath::Max(0.0f, StatRollFraction);
+	auto Roll = [this, Fraction](int32 BaseValue)
+	{
+		const int32 Spread = FMath::RoundToInt(FMath::Abs(BaseValue) * Fraction);
+		return Spread > 0 ? RollStream.RandRange(-Spread, Spread) : 0;
+	};
+
+	FItemStats Rolled;
+	Rolled.Armor = Roll(Base.Armor);
+	Rolled.Damage = Roll(Base.Damage);
+	Rolled.Strength = Roll(Base.Strength);
+	Rolled.Agility = Roll(Base.Agility);
+	Rolled.Stamina = Roll(Base.Stamina);
+	Rolled.Intellect = Roll(Base.Intellect);
+	return Rolled;
+}
+
+void UItemInstanceSubsystem::ReleaseInstance(FItemInstanceHandle Handle)
+{
+	if (!FindInstance(Handle))
+	{
+		return;
+	}
+
+	IndexByGuid.Remove(Instances[Handle.Index].Data.Guid);
+	Instances.RemoveAt(Handle.Index);
+
+	// A listen server's own player inspects through the same table
+	InspectedCache.Remove(Handle);
+}
+
+const FItemInstanceData* UItemInstanceSubsystem::FindInstance(FItemInstanceHandle Handle) const
+{
+	if (!Handle.IsValid() || !Instances.IsValidIndex(Handle.Index) || Instances[Handle.Index].Serial != Handle.Serial)
+	{
+		return nullptr;
+	}
+	return &Instances[Handle.Index].Data;
+}
+
+FItemInstanceData* UItemInstanceSubsystem::FindInstanceMutable(FItemInstanceHandle Handle)
+{
+	++Revision;
+	return const_cast<FItemInstanceData*>(FindInstance(Handle));
+}
+
+FItemInstanceHandle UItemInstanceSubsystem::FindByGuid(const FGuid& Guid) const
+{
+	FItemInstanceHandle Handle;
+	if (const int32* Index = IndexByGuid.Find(Guid))
+	{
+		Handle.Index = *Index;
+		Handle.Serial = Instances[*Index].Serial;
+	}
+	return Handle;
+}
+
+const FItemInstanceData* UItemInstanceSubsystem::FindInspected(FItemInstanceHandle Handle, double MaxAgeSeconds) const
+{
+	const FInspectedEntry* Entry = InspectedCache.Find(Handle);
+	const UWorld* World = GetWorld();
+	if (!Entry || !World || World->GetTimeSeconds() - Entry->ReceivedTime > MaxAgeSeconds)
+	{
+		return nullptr;
+	}
+	Entry->LastUsedTime = World->GetTimeSeconds();
+	return &Entry->Data;
+}
+
+void UItemInstanceSubsystem::CacheInspected(FItemInstanceHandle Handle, const FItemInstanceData& Data)
+{
+	// Handles the client no longer sees are never asked for again, so the cache is capped rather than pruned
+	if (!InspectedCache.Contains(Handle) && InspectedCache.Num() >= FMath::Max(1, MaxInspectedInstances))
+	{
+		const TPair<FItemInstanceHandle, FInspectedEntry>* LeastRecentlyUsed = nullptr;
+		for (const TPair<FItemInstanceHandle, FInspectedEntry>& Cached : InspectedCache)
+		{
+			if (!LeastRecentlyUsed || Cached.Value.LastUsedTime < LeastRecentlyUsed->Value.LastUsedTime)
+			{
+				LeastRecentlyUsed = &Cached;
+			}
+		}
+		const FItemInstanceHandle Evicted = LeastRecentlyUsed->Key;
+		InspectedCache.Remove(Evicted);
+	}
+
+	FInspectedEntry& Entry = InspectedCache.FindOrAdd(Handle);
+	Entry.Data = Data;
+	Entry.ReceivedTime = GetWorld() ? GetWorld()->GetTimeSeconds() : 0.0;
+	Entry.LastUsedTime = Entry.ReceivedTime;
+
+	OnInstanceInspected.Broadcast(Handle, Entry.Data);
+}
+
+void UItemInstanceSubsystem::Deinitialize()
+{
+	Instances.Empty();
+	IndexByGuid.Empty();
+	InspectedCache.Empty();
+
+	Super::Deinitialize();
+}
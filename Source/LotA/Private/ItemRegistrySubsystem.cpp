@@ -0,0 +1,218 @@
+// ItemRegistrySubsystem.cpp
+#include "ItemRegistrySubsystem.h"
+#include "ItemDefinitionTable.h"
+#include "Engine/AssetManager.h"
+#include "Engine/Texture2D.h"
+#include "Engine/Engine.h"
+#include "Internationalization/Internationalization.h"
+
+UItemRegistrySubsystem* UItemRegistrySubsystem::Get()
+{
+	return GEngine ? GEngine->GetEngineSubsystem<UItemRegistrySubsystem>() : nullptr;
+}
+
+void UItemRegistrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	CultureChangedHandle = FInternationalization::Get().OnCultureChanged().AddUObject(this, &UItemRegistrySubsystem::HandleCultureChanged);
+
+	LoadCookedDefinitions();
+}
+
+void UItemRegistrySubsystem::LoadCookedDefinitions()
+{
+	FItemDefinitionTable Table;
+	if (!Table.LoadFromFile(FItemDefinitionTable::GetDefaultPath()))
+	{
+		return;
+	}
+
+	Entries.Reserve(Table.Num());
+	IndexByID.Reserve(Table.Num());
+	for (int32 TableIndex = 0; TableIndex < Table.Num(); ++TableIndex)
+	{
+		const int32 Index = RegisterItem(Table.ToItemInfo(TableIndex));
+		if (Entries.IsValidIndex(Index))
+		{
+			Entries[Index].IconPath = Table.GetIconPath(TableIndex);
+		}
+	}
+
+	// Anything registered later depends on what the session happened to load, so it isn't net indexed
+	NumCookedEntries = Entries.Num();
+	UE_LOG(LogTemp, Log, TEXT("Loaded %d cooked item definitions"), Table.Num());
+}
+
+void UItemRegistrySubsystem::Deinitialize()
+{
+	FInternationalization::Get().OnCultureChanged().Remove(CultureChangedHandle);
+	for (TPair<int32, FIconRequest>& Request : IconRequests)
+	{
+		Request.Value.Handle->CancelHandle();
+	}
+	IconRequests.Empty();
+	Entries.Empty();
+	IndexByID.Empty();
+	NumCookedEntries = 0;
+
+	Super::Deinitialize();
+}
+
+int32 UItemRegistrySubsystem::RegisterItem(const FS_ItemInfo& ItemInfo)
+{
+	if (ItemInfo.ItemID.IsNone())
+	{
+		return INDEX_NONE;
+	}
+
+	if (const int32* ExistingIndex = IndexByID.Find(ItemInfo.ItemID))
+	{
+		FItemRegistryEntry& Existing = Entries[*ExistingIndex];
+
+		// A live definition is what this build actually uses, so a stale cooked entry gives way to it.
+		// Checked once per entry so re-registering stays a map lookup. Net indices stay put; peers still
+		// running the stale table will disagree until it is recooked.
+		if (*ExistingIndex < NumCookedEntries && !Existing.bLiveChecked)
+		{
+			Existing.bLiveChecked = true;
+			if (DefinitionsDiffer(Existing.Info, ItemInfo))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("Item %s differs from its cooked definition; using the live one. Recook the item definition table."), *ItemInfo.ItemID.ToString());
+
+				UTexture2D* LoadedIcon = Existing.Info.ItemIcon;
+				Existing.Info = ItemInfo;
+				Existing.TypeMask = ItemTypeMask::FromType(ItemInfo.ItemType);
+				BuildSearchKey(Existing);
+				if (!Existing.Info.ItemIcon)
+				{
+					Existing.Info.ItemIcon = LoadedIcon;
+				}
+			}
+		}
+
+		// A live definition can supply the icon a cooked entry was created without
+		if (!Existing.Info.ItemIcon && ItemInfo.ItemIcon)
+		{
+			Existing.Info.ItemIcon = ItemInfo.ItemIcon;
+		}
+		return *ExistingIndex;
+	}
+
+	const int32 NewIndex = Entries.AddDefaulted();
+	FItemRegistryEntry& Entry = Entries[NewIndex];
+	Entry.Info = ItemInfo;
+	Entry.TypeMask = ItemTypeMask::FromType(ItemInfo.ItemType);
+	BuildSearchKey(Entry);
+
+	IndexByID.Add(ItemInfo.ItemID, NewIndex);
+	return NewIndex;
+}
+
+int32 UItemRegistrySubsystem::FindItemIndex(FName ItemID) const
+{
+	const int32* Index = IndexByID.Find(ItemID);
+	return Index ? *Index : INDEX_NONE;
+}
+
+UTexture2D* UItemRegistrySubsystem::RequestIcon(int32 Index, FSimpleDelegate OnLoaded)
+{
+	if (!Entries.IsValidIndex(Index))
+	{
+		return nullptr;
+	}
+
+	const FItemRegistryEntry& Entry = Entries[Index];
+	if (Entry.Info.ItemIcon || !Entry.IconPath.IsValid())
+	{
+		return Entry.Info.ItemIcon;
+	}
+
+	if (FIconRequest* Pending = IconRequests.Find(Index))
+	{
+		if (OnLoaded.IsBound())
+		{
+			Pending->Waiters.Add(MoveTemp(OnLoaded));
+		}
+		return nullptr;
+	}
+
+	FIconRequest& Request = IconRequests.Add(Index);
+	if (OnLoaded.IsBound())
+	{
+		Request.Waiters.Add(MoveTemp(OnLoaded));
+	}
+
+	// May complete inside the call when the texture is already resident, which removes the request again
+	TSharedPtr<FStreamableHandle> Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Entry.IconPath,
+		FStreamableDelegate::CreateUObject(this, &UItemRegistrySubsystem::HandleIconLoaded, Index));
+	if (FIconRequest* StillPending = IconRequests.Find(Index))
+	{
+		StillPending->Handle = Handle;
+		return nullptr;
+	}
+	return Entries[Index].Info.ItemIcon;
+}
+
+void UItemRegistrySubsystem::HandleIconLoaded(int32 Index)
+{
+	FIconRequest Request;
+	if (!IconRequests.RemoveAndCopyValue(Index, Request) || !Entries.IsValidIndex(Index))
+	{
+		return;
+	}
+
+	FItemRegistryEntry& Entry = Entries[Index];
+	if (!Entry.Info.ItemIcon)
+	{
+		Entry.Info.ItemIcon = Cast<UTexture2D>(Entry.IconPath.ResolveObject());
+	}
+	if (!Entry.Info.ItemIcon)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Failed to load icon %s for item %s"), *Entry.IconPath.ToString(), *Entry.Info.ItemID.ToString());
+		return;
+	}
+
+	for (const FSimpleDelegate& Waiter : Request.Waiters)
+	{
+		Waiter.ExecuteIfBound();
+	}
+}
+
+bool UItemRegistrySubsystem::DefinitionsDiffer(const FS_ItemInfo& A, const FS_ItemInfo& B)
+{
+	// ItemIcon is left out: cooked entries never hold one until it is loaded
+	return !A.ItemName.EqualTo(B.ItemName)
+		|| !A.ItemDescription.EqualTo(B.ItemDescription)
+		|| A.ItemType != B.ItemType
+		|| A.Weight != B.Weight
+		|| A.MaxStackSize != B.MaxStackSize
+		|| A.BagSlots != B.BagSlots
+		|| A.WeightReductionPercentage != B.WeightReductionPercentage
+		|| A.CooldownGroup != B.CooldownGroup
+		|| A.CooldownSeconds != B.CooldownSeconds
+		|| A.EquipSlot != B.EquipSlot
+		|| A.Stats.Armor != B.Stats.Armor
+		|| A.Stats.Damage != B.Stats.Damage
+		|| A.Stats.Strength != B.Stats.Strength
+		|| A.Stats.Agility != B.Stats.Agility
+		|| A.Stats.Stamina != B.Stats.Stamina
+		|| A.Stats.Intellect != B.Stats.Intellect
+		|| A.bUniqueInstance != B.bUniqueInstance
+		|| A.MaxDurability != B.MaxDurability;
+}
+
+void UItemRegistrySubsystem::BuildSearchKey(FItemRegistryEntry& Entry)
+{
+	// Fall back to the ID so unnamed test items can still be found
+	Entry.SearchKey = Entry.Info.ItemName.IsEmpty() ? Entry.Info.ItemID.ToString() : Entry.Info.ItemName.ToString();
+	Entry.SearchKey.ToLowerInline();
+}
+
+void UItemRegistrySubsystem::HandleCultureChanged()
+{
+	for (FItemRegistryEntry& Entry : Entries)
+	{
+		BuildSearchKey(Entry);
+	}
+}
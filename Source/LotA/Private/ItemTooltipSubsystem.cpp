@@ -0,0 +1,116 @@
+// ItemTooltipSubsystem.cpp
+#include "ItemTooltipSubsystem.h"
+#include "ItemTooltipWidget.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+#include "Internationalization/Internationalization.h"
+
+#define LOCTEXT_NAMESPACE "ItemTooltip"
+
+UItemTooltipSubsystem::UItemTooltipSubsystem()
+{
+	// Fallback for when config doesn't name the class; nothing is loaded here
+	TooltipWidgetClass = TSoftClassPtr<UItemTooltipWidget>(FSoftObjectPath(TEXT("/Game/Inventory/Widgets/WBP_ItemTooltip.WBP_ItemTooltip_C")));
+}
+
+UItemTooltipSubsystem* UItemTooltipSubsystem::Get(const APlayerController* PlayerController)
+{
+	const ULocalPlayer* LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+	return LocalPlayer ? LocalPlayer->GetSubsystem<UItemTooltipSubsystem>() : nullptr;
+}
+
+void UItemTooltipSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	CultureChangedHandle = FInternationalization::Get().OnCultureChanged().AddUObject(this, &UItemTooltipSubsystem::HandleCultureChanged);
+}
+
+void UItemTooltipSubsystem::Deinitialize()
+{
+	FInternationalization::Get().OnCultureChanged().Remove(CultureChangedHandle);
+	DefinitionTexts.Empty();
+	TooltipWidget = nullptr;
+
+	Super::Deinitialize();
+}
+
+UItemTooltipWidget* UItemTooltipSubsystem::GetTooltipFor(APlayerController* OwningPlayer, const FS_ItemInfo& Item, int32 Quantity, float WeightReductionPercentage)
+{
+	if (!TooltipWidget)
+	{
+		const TSubclassOf<UItemTooltipWidget> WidgetClass = TooltipWidgetClass.LoadSynchronous();
+		if (!WidgetClass)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to load tooltip widget class %s"), *TooltipWidgetClass.ToString());
+			return nullptr;
+		}
+
+		TooltipWidget = OwningPlayer ? CreateWidget<UItemTooltipWidget>(OwningPlayer, WidgetClass) : nullptr;
+		if (!TooltipWidget)
+		{
+			return nullptr;
+		}
+	}
+
+	// Same reduction UBagComponent::GetTotalWeight applies to its contents
+	float StackWeight = Item.Weight * Quantity;
+	if (WeightReductionPercentage > 0.0f)
+	{
+		StackWeight *= 1.0f - (WeightReductionPercentage / 100.0f);
+	}
+
+	TooltipWidget->SetDefinitionText(GetDefinitionText(Item));
+	TooltipWidget->SetStackWeight(StackWeight, Quantity);
+	return TooltipWidget;
+}
+
+const FText& UItemTooltipSubsystem::GetDefinitionText(const FS_ItemInfo& Item)
+{
+	if (const FText* Cached = DefinitionTexts.Find(Item.ItemID))
+	{
+		return *Cached;
+	}
+	return DefinitionTexts.Add(Item.ItemID, BuildDefinitionText(Item));
+}
+
+FText UItemTooltipSubsystem::BuildDefinitionText(const FS_ItemInfo& Item)
+{
+	FNumberFormattingOptions WeightFormat;
+	WeightFormat.MaximumFractionalDigits = 1;
+
+	TArray<FText> Lines;
+	Lines.Add(Item.ItemName.IsEmpty() ? FText::FromName(Item.ItemID) : Item.ItemName);
+
+	if (!Item.ItemDescription.IsEmpty())
+	{
+		Lines.Add(Item.ItemDescription);
+	}
+
+	Lines.Add(FText::Format(LOCTEXT("Weight", "Weight: {0}"), FText::AsNumber(Item.Weight, &WeightFormat)));
+
+	if (Item.ItemType == EItemType::Bag)
+	{
+		Lines.Add(FText::Format(LOCTEXT("BagSlots", "{0} slots"), FText::AsNumber(Item.BagSlots)));
+
+		if (Item.WeightReductionPercentage > 0.0f)
+		{
+			Lines.Add(FText::Format(LOCTEXT("WeightReduction", "Contents weigh {0} less"), FText::AsPercent(Item.WeightReductionPercentage / 100.0f)));
+		}
+	}
+
+	return FText::Join(FText::FromString(TEXT("\n")), Lines);
+}
+
+void UItemTooltipSubsystem::HandleCultureChanged()
+{
+	DefinitionTexts.Empty();
+
+	// The widget would otherwise skip an unchanged stack weight and keep the old number format
+	if (TooltipWidget)
+	{
+		TooltipWidget->ResetShownText();
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,58 @@
+// ItemTooltipWidget.cpp
+#include "ItemTooltipWidget.h"
+#include "Components/TextBlock.h"
+
+#define LOCTEXT_NAMESPACE "ItemTooltip"
+
+UItemTooltipWidget::UItemTooltipWidget(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+	, ShownStackWeight(-1.0f)
+	, bStackWeightVisible(false)
+{
+}
+
+void UItemTooltipWidget::SetDefinitionText(const FText& InText)
+{
+	// Cached texts share their data, so an identity check is enough to skip re-layout
+	if (!DefinitionText || InText.IdenticalTo(ShownDefinitionText))
+	{
+		return;
+	}
+
+	ShownDefinitionText = InText;
+	DefinitionText->SetText(InText);
+}
+
+void UItemTooltipWidget::ResetShownText()
+{
+	ShownDefinitionText = FText::GetEmpty();
+	ShownStackWeight = -1.0f;
+}
+
+void UItemTooltipWidget::SetStackWeight(float TotalWeight, int32 Quantity)
+{
+	if (!StackWeightText)
+	{
+		return;
+	}
+
+	const bool bVisible = Quantity > 1;
+	if (bVisible != bStackWeightVisible)
+	{
+		bStackWeightVisible = bVisible;
+		StackWeightText->SetVisibility(bVisible ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+	}
+
+	if (!bVisible || TotalWeight == ShownStackWeight)
+	{
+		return;
+	}
+
+	ShownStackWeight = TotalWeight;
+
+	FNumberFormattingOptions WeightFormat;
+	WeightFormat.MaximumFractionalDigits = 1;
+	StackWeightText->SetText(FText::Format(LOCTEXT("StackWeight", "Stack weight: {0}"), FText::AsNumber(TotalWeight, &WeightFormat)));
+}
+
+#undef LOCTEXT_NAMESPACE
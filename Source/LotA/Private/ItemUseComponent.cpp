@@ -0,0 +1,233 @@
+// ItemUseComponent.cpp
+#include "ItemUseComponent.h"
+#include "BagComponent.h"
+#include "InventoryRegistryComponent.h"
+#include "InventorySlotDataComponent.h"
+#include "InventoryAudit.h"
+#include "TimerManager.h"
+
+UItemUseComponent::UItemUseComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void UItemUseComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	Super::EndPlay(EndPlayReason);
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(CooldownTickHandle);
+	}
+	Cooldowns.Reset();
+	ItemLocationCache.Empty();
+}
+
+void UItemUseComponent::UseItemInSlot(UBagComponent* Bag, int32 SlotIndex)
+{
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		TryUseSlot(Bag, SlotIndex);
+	}
+	else if (const UInventoryRegistryComponent* Registry = GetRegistry())
+	{
+		const int32 ContainerHandle = Registry->GetContainerHandle(Bag);
+		if (ContainerHandle != INDEX_NONE)
+		{
+			ServerUseItemInSlot(ContainerHandle, SlotIndex);
+		}
+	}
+}
+
+void UItemUseComponent::UseItemByID(FName ItemID)
+{
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		UBagComponent* Bag = nullptr;
+		int32 SlotIndex = INDEX_NONE;
+		if (FindItemSlot(ItemID, Bag, SlotIndex))
+		{
+			TryUseSlot(Bag, SlotIndex);
+		}
+	}
+	else
+	{
+		ServerUseItemByID(ItemID);
+	}
+}
+
+void UItemUseComponent::ServerUseItemInSlot_Implementation(int32 ContainerHandle, int32 SlotIndex)
+{
+	if (const UInventoryRegistryComponent* Registry = GetRegistry())
+	{
+		TryUseSlot(Registry->GetBagByHandle(ContainerHandle), SlotIndex);
+	}
+}
+
+void UItemUseComponent::ServerUseItemByID_Implementation(FName ItemID)
+{
+	UseItemByID(ItemID);
+}
+
+bool UItemUseComponent::IsOnCooldown(FName CooldownGroup) const
+{
+	const UWorld* World = GetWorld();
+	return World && Cooldowns.IsActive(CooldownGroup, World->GetTimeSeconds());
+}
+
+float UItemUseComponent::GetCooldownRemaining(FName CooldownGroup) const
+{
+	const UWorld* World = GetWorld();
+	return World ? Cooldowns.GetRemaining(CooldownGroup, World->GetTimeSeconds()) : 0.0f;
+}
+
+bool UItemUseComponent::TryUseSlot(UBagComponent* Bag, int32 SlotIndex)
+{
+	if (!Bag || !OwnsBag(Bag))
+	{
+		return false;
+	}
+
+	const TArray<UInventorySlotDataComponent*>& Slots = Bag->GetInventorySlots();
+	if (!Slots.IsValidIndex(SlotIndex) || !Slots[SlotIndex] || Slots[SlotIndex]->IsEmpty())
+	{
+		return false;
+	}
+
+	UInventorySlotDataComponent* Slot = Slots[SlotIndex];
+	if (Slot->GetItemData().ItemType != EItemType::Consumable)
+	{
+		return false;
+	}
+
+	// Items without a group still get a private cooldown keyed on their own ID
+	const FS_ItemInfo UsedItem = Slot->GetItemData();
+	const FName CooldownGroup = UsedItem.CooldownGroup.IsNone() ? UsedItem.ItemID : UsedItem.CooldownGroup;
+	if (IsOnCooldown(CooldownGroup))
+	{
+		return false;
+	}
+
+	{
+		FInventoryAuditScope AuditScope(EInventoryAuditOp::Consume);
+		if (!Slot->RemoveItems(1))
+		{
+			return false;
+		}
+	}
+
+	if (UsedItem.CooldownSeconds > 0.0f)
+	{
+		StartCooldown(CooldownGroup, UsedItem.CooldownSeconds);
+	}
+
+	OnItemUsed.Broadcast(UsedItem);
+	return true;
+}
+
+bool UItemUseComponent::FindItemSlot(FName ItemID, UBagComponent*& OutBag, int32& OutSlotIndex)
+{
+	auto SlotHoldsItem = [ItemID](const UBagComponent* Bag, int32 SlotIndex)
+	{
+		const TArray<UInventorySlotDataComponent*>& Slots = Bag->GetInventorySlots();
+		return Slots.IsValidIndex(SlotIndex) && Slots[SlotIndex] && !Slots[SlotIndex]->IsEmpty() && Slots[SlotIndex]->GetItemData().ItemID == ItemID;
+	};
+
+	if (const FItemSlotRef* Cached = ItemLocationCache.Find(ItemID))
+	{
+		UBagComponent* CachedBag = Cached->Bag.Get();
+		if (CachedBag && SlotHoldsItem(CachedBag, Cached->SlotIndex))
+		{
+			OutBag = CachedBag;
+			OutSlotIndex = Cached->SlotIndex;
+			return true;
+		}
+	}
+
+	const UInventoryRegistryComponent* Registry = GetRegistry();
+	if (!Registry)
+	{
+		return false;
+	}
+
+	for (UBagComponent* Bag : Registry->GetBags())
+	{
+		const int32 NumSlots = Bag ? Bag->GetInventorySlots().Num() : 0;
+		for (int32 SlotIndex = 0; SlotIndex < NumSlots; ++SlotIndex)
+		{
+			if (SlotHoldsItem(Bag, SlotIndex))
+			{
+				FItemSlotRef& Ref = ItemLocationCache.FindOrAdd(ItemID);
+				Ref.Bag = Bag;
+				Ref.SlotIndex = SlotIndex;
+
+				OutBag = Bag;
+				OutSlotIndex = SlotIndex;
+				return true;
+			}
+		}
+	}
+
+	ItemLocationCache.Remove(ItemID);
+	return false;
+}
+
+bool UItemUseComponent::OwnsBag(const UBagComponent* Bag) const
+{
+	const UInventoryRegistryComponent* Registry = GetRegistry();
+	return Registry && Registry->GetContainerHandle(Bag) != INDEX_NONE;
+}
+
+UInventoryRegistryComponent* UItemUseComponent::GetRegistry() const
+{
+	return UInventoryRegistryComponent::FindForActor(GetOwner());
+}
+
+void UItemUseComponent::StartCooldown(FName CooldownGroup, float Duration)
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	Cooldowns.Start(CooldownGroup, Duration, World->GetTimeSeconds());
+
+	// One timer per player drives every running cooldown
+	if (!World->GetTimerManager().IsTimerActive(CooldownTickHandle))
+	{
+		World->GetTimerManager().SetTimer(CooldownTickHandle, this, &UItemUseComponent::TickCooldowns, FCooldownWheel::TickInterval, true);
+	}
+
+	OnCooldownStarted.Broadcast(CooldownGroup, Duration);
+
+	if (GetOwnerRole() == ROLE_Authority && !GetOwner()->HasLocalNetOwner())
+	{
+		ClientCooldownStarted(CooldownGroup, Duration);
+	}
+}
+
+void UItemUseComponent::ClientCooldownStarted_Implementation(FName CooldownGroup, float Duration)
+{
+	StartCooldown(CooldownGroup, Duration);
+}
+
+void UItemUseComponent::TickCooldowns()
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	Cooldowns.Tick(World->GetTimeSeconds(), [this](FName CooldownGroup)
+	{
+		OnCooldownEnded.Broadcast(CooldownGroup);
+	});
+
+	if (!Cooldowns.HasPending())
+	{
+		World->GetTimerManager().ClearTimer(CooldownTickHandle);
+	}
+}
@@ -0,0 +1,230 @@
+// LootRoller.cpp
+#include "LootRoller.h"
+#include "LootTable.h"
+#include "ItemBase.h"
+#include "ItemRegistrySubsystem.h"
+
+int32 FLootRoller::RollBatch(const ULootTable* Table, int32 NumKills, FRandomStream& Stream, TArray<FLootDrop>& OutDrops)
+{
+	if (!Table || NumKills <= 0)
+	{
+		return 0;
+	}
+
+	return RollCompiled(CompileTable(Table), NumKills, Stream, OutDrops);
+}
+
+int32 FLootRoller::CompileTable(const ULootTable* Table)
+{
+	if (!Table)
+	{
+		return INDEX_NONE;
+	}
+
+	TArray<const ULootTable*, TInlineAllocator<MaxNestingDepth>> Path;
+	return Compile(Table, Path);
+}
+
+int32 FLootRoller::RollCompiled(int32 TableIndex, int32 NumKills, FRandomStream& Stream, TArray<FLootDrop>& OutDrops) const
+{
+	if (!CompiledTables.IsValidIndex(TableIndex) || NumKills <= 0)
+	{
+		return 0;
+	}
+
+	const int32 DropsBefore = OutDrops.Num();
+	for (int32 KillIndex = 0; KillIndex < NumKills; ++KillIndex)
+	{
+		RollTable(TableIndex, KillIndex, 0, Stream, OutDrops);
+	}
+	return OutDrops.Num() - DropsBefore;
+}
+
+void FLootRoller::Reset()
+{
+	CompiledTables.Reset();
+	CompiledIndices.Reset();
+}
+
+bool FLootRoller::Invalidate(const ULootTable* Table)
+{
+	// Parents hold indices of their nested tables, so one stale table invalidates them all
+	if (!CompiledIndices.Contains(Table))
+	{
+		return false;
+	}
+
+	Reset();
+	return true;
+}
+
+int32 FLootRoller::Compile(const ULootTable* Table, TArray<const ULootTable*, TInlineAllocator<MaxNestingDepth>>& Path)
+{
+	if (const int32* Existing = CompiledIndices.Find(Table))
+	{
+		return *Existing;
+	}
+
+	if (Path.Contains(Table) || Path.Num() >= MaxNestingDepth)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Loot table %s nests itself or is nested more than %d deep; the nested entry drops nothing"), *GetNameSafe(Table), MaxNestingDepth);
+		return INDEX_NONE;
+	}
+
+	Path.Push(Table);
+
+	UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+	auto CompileEntry = [this, &Path, Registry](const FLootEntry& Source)
+	{
+		FCompiledEntry Entry;
+		Entry.MinQuantity = FMath::Max(1, Source.MinQuantity);
+		Entry.MaxQuantity = FMath::Max(Entry.MinQuantity, Source.MaxQuantity);
+
+		if (Source.NestedTable)
+		{
+			Entry.NestedTable = Compile(Source.NestedTable, Path);
+		}
+		else if (Source.ItemClass)
+		{
+			// Copied out so nothing points into the class default object once compiled
+			const FS_ItemInfo& Item = GetDefault<AItemBase>(Source.ItemClass)->ItemDetails;
+			if (!Item.ItemID.IsNone())
+			{
+				Entry.ItemID = Item.ItemID;
+				Entry.MaxStack = Item.GetMaxStack();
+				if (Registry)
+				{
+					Registry->RegisterItem(Item);
+				}
+			}
+		}
+		return Entry;
+	};
+
+	FCompiledTable Compiled;
+	Compiled.MinRolls = FMath::Max(0, Table->MinRolls);
+	Compiled.MaxRolls = FMath::Max(Compiled.MinRolls, Table->MaxRolls);
+
+	for (const FLootEntry& Source : Table->GuaranteedDrops)
+	{
+		Compiled.Guaranteed.Add(CompileEntry(Source));
+	}
+
+	TArray<float> Weights;
+	for (const FLootEntry& Source : Table->WeightedDrops)
+	{
+		if (Source.Weight > 0.0f)
+		{
+			Compiled.Weighted.Add(CompileEntry(Source));
+			Weights.Add(Source.Weight);
+		}
+	}
+	BuildAliasTable(Weights, Compiled.Probability, Compiled.Alias);
+
+	Path.Pop();
+
+	const int32 Index = CompiledTables.Add(MoveTemp(Compiled));
+	CompiledIndices.Add(Table, Index);
+	return Index;
+}
+
+void FLootRoller::BuildAliasTable(TConstArrayView<float> Weights, TArray<float>& OutProbability, TArray<int32>& OutAlias)
+{
+	// Vose's method: scale weights so the average is 1, then pair each under-full column with an
+	// over-full one that tops it up
+	const int32 Num = Weights.Num();
+	OutProbability.SetNumUninitialized(Num);
+	OutAlias.SetNumUninitialized(Num);
+
+	double Total = 0.0;
+	for (const float Weight : Weights)
+	{
+		Total += Weight;
+	}
+	if (Num == 0 || Total <= 0.0)
+	{
+		return;
+	}
+
+	TArray<double> Scaled;
+	Scaled.SetNumUninitialized(Num);
+	TArray<int32> Small;
+	TArray<int32> Large;
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		Scaled[Index] = Weights[Index] * Num / Total;
+		OutAlias[Index] = Index;
+		(Scaled[Index] < 1.0 ? Small : Large).Add(Index);
+	}
+
+	while (Small.Num() > 0 && Large.Num() > 0)
+	{
+		const int32 Under = Small.Pop(EAllowShrinking::No);
+		const int32 Over = Large.Last();
+
+		OutProbability[Under] = static_cast<float>(Scaled[Under]);
+		OutAlias[Under] = Over;
+
+		Scaled[Over] -= 1.0 - Scaled[Under];
+		if (Scaled[Over] < 1.0)
+		{
+			Large.Pop(EAllowShrinking::No);
+			Small.Add(Over);
+		}
+	}
+
+	// Whatever is left is full up to rounding error
+	for (const int32 Index : Small)
+	{
+		OutProbability[Index] = 1.0f;
+	}
+	for (const int32 Index : Large)
+	{
+		OutProbability[Index] = 1.0f;
+	}
+}
+
+void FLootRoller::RollTable(int32 TableIndex, int32 KillIndex, int32 Depth, FRandomStream& Stream, TArray<FLootDrop>& OutDrops) const
+{
+	const FCompiledTable& Table = CompiledTables[TableIndex];
+
+	for (const FCompiledEntry& Entry : Table.Guaranteed)
+	{
+		EmitEntry(Entry, KillIndex, Depth, Stream, OutDrops);
+	}
+
+	const int32 NumWeighted = Table.Weighted.Num();
+	if (NumWeighted == 0)
+	{
+		return;
+	}
+
+	const int32 Rolls = Table.MinRolls == Table.MaxRolls ? Table.MinRolls : Stream.RandRange(Table.MinRolls, Table.MaxRolls);
+	for (int32 Roll = 0; Roll < Rolls; ++Roll)
+	{
+		const int32 Column = Stream.RandHelper(NumWeighted);
+		const int32 Picked = Stream.GetFraction() < Table.Probability[Column] ? Column : Table.Alias[Column];
+		EmitEntry(Table.Weighted[Picked], KillIndex, Depth, Stream, OutDrops);
+	}
+}
+
+void FLootRoller::EmitEntry(const FCompiledEntry& Entry, int32 KillIndex, int32 Depth, FRandomStream& Stream, TArray<FLootDrop>& OutDrops) const
+{
+	if (Entry.NestedTable != INDEX_NONE)
+	{
+		if (Depth < MaxNestingDepth)
+		{
+			RollTable(Entry.NestedTable, KillIndex, Depth + 1, Stream, OutDrops);
+		}
+		return;
+	}
+
+	if (!Entry.ItemID.IsNone())
+	{
+		FLootDrop& Drop = OutDrops.AddDefaulted_GetRef();
+		Drop.ItemID = Entry.ItemID;
+		Drop.MaxStack = Entry.MaxStack;
+		Drop.Count = Entry.MinQuantity == Entry.MaxQuantity ? Entry.MinQuantity : Stream.RandRange(Entry.MinQuantity, Entry.MaxQuantity);
+		Drop.KillIndex = KillIndex;
+	}
+}
@@ -0,0 +1,250 @@
+// LootSubsystem.cpp
+#include "LootSubsystem.h"
+#include "LootTable.h"
+#include "BagComponent.h"
+#include "InventoryAudit.h"
+#include "InventoryCommandSubsystem.h"
+#include "InventoryStoreSubsystem.h"
+#include "ItemBase.h"
+#include "ItemRegistrySubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+
+// Rolls a table for one player. Compiling and seeding happen in Capture, so Execute only reads the
+// subsystem's compiled tables, which nothing changes while commands execute.
+class FLootGrantCommand : public FInventoryCommand
+{
+public:
+	FLootGrantCommand(ULootSubsystem& InLoot, APlayerController* InPlayer, const ULootTable* InTable, int32 InNumKills, UBagComponent* InBag, TSubclassOf<AItemBase> InDropClass)
+		: Loot(&InLoot)
+		, Player(InPlayer)
+		, Table(InTable)
+		, Bag(InBag)
+		, DropClass(InDropClass)
+		, NumKills(InNumKills)
+	{
+	}
+
+	virtual void Capture() override
+	{
+		ULootSubsystem* LootSubsystem = Loot.Get();
+		if (LootSubsystem && Table.IsValid())
+		{
+			Roller = &LootSubsystem->Roller;
+			TableIndex = LootSubsystem->CompileTable(Table.Get());
+			Stream.Initialize(LootSubsystem->Stream.GetUnsignedInt());
+		}
+	}
+
+	virtual void Execute() override
+	{
+		if (Roller && TableIndex != INDEX_NONE)
+		{
+			Roller->RollCompiled(TableIndex, NumKills, Stream, Drops);
+		}
+	}
+
+	virtual void Apply() override
+	{
+		ULootSubsystem* LootSubsystem = Loot.Get();
+		if (!LootSubsystem || Drops.Num() == 0)
+		{
+			return;
+		}
+
+		TArray<FLootDrop> Leftovers;
+		LootSubsystem->GrantDrops(Drops, Bag.Get(), Leftovers);
+
+		const APawn* Pawn = Player.IsValid() ? Player->GetPawn() : nullptr;
+		if (Leftovers.Num() > 0 && Pawn)
+		{
+			// Leftovers all come from the one pawn location
+			for (FLootDrop& Leftover : Leftovers)
+			{
+				Leftover.KillIndex = 0;
+			}
+			const FVector Location = Pawn->GetActorLocation();
+			LootSubsystem->SpawnWorldDrops(Leftovers, MakeArrayView(&Location, 1), DropClass);
+		}
+	}
+
+private:
+	TWeakObjectPtr<ULootSubsystem> Loot;
+	TWeakObjectPtr<APlayerController> Player;
+	TWeakObjectPtr<const ULootTable> Table;
+	TWeakObjectPtr<UBagComponent> Bag;
+	TSubclassOf<AItemBase> DropClass;
+	int32 NumKills = 0;
+
+	const FLootRoller* Roller = nullptr;
+	int32 TableIndex = INDEX_NONE;
+	FRandomStream Stream;
+	TArray<FLootDrop> Drops;
+};
+
+ULootSubsystem* ULootSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<ULootSubsystem>() : nullptr;
+}
+
+void ULootSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	Stream.GenerateNewSeed();
+	TableChangedHandle = ULootTable::OnLootTableChanged.AddLambda([this](const ULootTable* Table)
+	{
+		if (Roller.Invalidate(Table))
+		{
+			CompiledTables.Reset();
+		}
+	});
+}
+
+void ULootSubsystem::Deinitialize()
+{
+	ULootTable::OnLootTableChanged.Remove(TableChangedHandle);
+	Roller.Reset();
+	CompiledTables.Reset();
+
+	Super::Deinitialize();
+}
+
+int32 ULootSubsystem::CompileTable(const ULootTable* Table)
+{
+	const int32 TableIndex = Roller.CompileTable(Table);
+	if (TableIndex != INDEX_NONE)
+	{
+		CompiledTables.Add(Table);
+	}
+	return TableIndex;
+}
+
+const FS_ItemInfo* ULootSubsystem::FindDropItem(const FLootDrop& Drop)
+{
+	const UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+	const FItemRegistryEntry* Entry = Registry ? Registry->FindEntry(Drop.ItemID) : nullptr;
+	return Entry ? &Entry->Info : nullptr;
+}
+
+int32 ULootSubsystem::RollBatch(const ULootTable* Table, int32 NumKills, TArray<FLootDrop>& OutDrops)
+{
+	if (!Table || NumKills <= 0)
+	{
+		return 0;
+	}
+	return Roller.RollCompiled(CompileTable(Table), NumKills, Stream, OutDrops);
+}
+
+void ULootSubsystem::SpawnWorldDrops(TConstArrayView<FLootDrop> Drops, TConstArrayView<FVector> KillLocations, TSubclassOf<AItemBase> DropClass)
+{
+	UWorld* World = GetWorld();
+	if (!World || !DropClass)
+	{
+		return;
+	}
+
+	auto SpawnDrop = [World, &DropClass](const FS_ItemInfo& Item, int32 Count, const FVector& Location)
+	{
+		const FTransform DropTransform(Location);
+		AItemBase* Pickup = World->SpawnActorDeferred<AItemBase>(DropClass, DropTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn);
+		if (Pickup)
+		{
+			Pickup->ItemDetails = Item;
+			Pickup->StackCount = Count;
+			Pickup->FinishSpawning(DropTransform);
+		}
+	};
+
+	for (const FLootDrop& Drop : Drops)
+	{
+		const FS_ItemInfo* Item = Drop.Count > 0 && KillLocations.IsValidIndex(Drop.KillIndex) ? FindDropItem(Drop) : nullptr;
+		if (!Item)
+		{
+			continue;
+		}
+
+		// Oversized rolls are split into legal stacks. Unique items stack to one, so every copy gets
+		// its own pickup and instance.
+		const FVector& Location = KillLocations[Drop.KillIndex];
+		const int32 MaxStack = FMath::Max(1, Drop.MaxStack);
+		for (int32 Remaining = Drop.Count; Remaining > 0; Remaining -= MaxStack)
+		{
+			SpawnDrop(*Item, FMath::Min(Remaining, MaxStack), Location);
+		}
+	}
+}
+
+void ULootSubsystem::GrantDrops(TConstArrayView<FLootDrop> Drops, UBagComponent* Bag, TArray<FLootDrop>& OutLeftovers)
+{
+	if (!Bag)
+	{
+		OutLeftovers.Append(Drops.GetData(), Drops.Num());
+		return;
+	}
+
+	FInventoryAuditScope AuditScope(EInventoryAuditOp::Create);
+	for (const FLootDrop& Drop : Drops)
+	{
+		const FS_ItemInfo* Item = Drop.Count > 0 ? FindDropItem(Drop) : nullptr;
+		if (!Item)
+		{
+			continue;
+		}
+
+		const int32 Leftover = Bag->AddItem(*Item, Drop.Count);
+		if (Leftover > 0)
+		{
+			FLootDrop& Remaining = OutLeftovers.Add_GetRef(Drop);
+			Remaining.Count = Leftover;
+		}
+	}
+}
+
+void ULootSubsystem::GrantDrops(TConstArrayView<FLootDrop> Drops, FInventoryEntityHandle Inventory, TArray<FLootDrop>& OutLeftovers)
+{
+	UInventoryStoreSubsystem* StoreSubsystem = UInventoryStoreSubsystem::Get(this);
+	if (!StoreSubsystem || !StoreSubsystem->GetStore().IsValid(Inventory))
+	{
+		OutLeftovers.Append(Drops.GetData(), Drops.Num());
+		return;
+	}
+
+	for (const FLootDrop& Drop : Drops)
+	{
+		const FS_ItemInfo* Item = Drop.Count > 0 ? FindDropItem(Drop) : nullptr;
+		if (!Item)
+		{
+			continue;
+		}
+
+		const int32 Leftover = StoreSubsystem->AddItem(Inventory, *Item, Drop.Count);
+		if (Leftover > 0)
+		{
+			FLootDrop& Remaining = OutLeftovers.Add_GetRef(Drop);
+			Remaining.Count = Leftover;
+		}
+	}
+}
+
+void ULootSubsystem::QueueGrant(APlayerController* Player, const ULootTable* Table, int32 NumKills, UBagComponent* Bag, TSubclassOf<AItemBase> LeftoverDropClass)
+{
+	UInventoryCommandSubsystem* Commands = UInventoryCommandSubsystem::Get(this);
+	if (!Commands || !Player || !Table || NumKills <= 0)
+	{
+		return;
+	}
+
+	Commands->Enqueue(Player, MakeUnique<FLootGrantCommand>(*this, Player, Table, NumKills, Bag, LeftoverDropClass));
+}
+
+void ULootSubsystem::RollAndSpawn(const ULootTable* Table, FVector Location)
+{
+	TArray<FLootDrop> Drops;
+	if (RollBatch(Table, 1, Drops) > 0)
+	{
+		SpawnWorldDrops(Drops, MakeArrayView(&Location, 1), AItemBase::StaticClass());
+	}
+}
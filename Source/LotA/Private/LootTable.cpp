@@ -0,0 +1,13 @@
+// LootTable.cpp
+#include "LootTable.h"
+
+FOnLootTableChanged ULootTable::OnLootTableChanged;
+
+#if WITH_EDITOR
+void ULootTable::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	OnLootTableChanged.Broadcast(this);
+}
+#endif
@@ -1,36 +1,58 @@
 #include "LotAGameModeBase.h"
-#include "UObject/ConstructorHelpers.h"
 #include "InventoryWidget.h"
 #include "LotAPlayerController.h"
+#include "Engine/AssetManager.h"
+#include "GameFramework/DefaultPawn.h"
 
 ALotAGameModeBase::ALotAGameModeBase()
 {
-    // Set the default pawn class to BP_ThirdPersonCharacter
-    static ConstructorHelpers::FClassFinder<APawn> PlayerPawnBPClass(TEXT("/Game/ThirdPerson/Blueprints/BP_ThirdPersonCharacter"));
-    if (PlayerPawnBPClass.Succeeded())
-    {
-        DefaultPawnClass = PlayerPawnBPClass.Class;
-    }
+    // Fallbacks for when config doesn't name the classes; nothing is loaded here
+    PlayerPawnClass = TSoftClassPtr<APawn>(FSoftObjectPath(TEXT("/Game/ThirdPerson/Blueprints/BP_ThirdPersonCharacter.BP_ThirdPersonCharacter_C")));
+    DefaultInventoryWidgetClass = TSoftClassPtr<UInventoryWidget>(FSoftObjectPath(TEXT("/Game/Inventory/Widgets/WBP_Inventory.WBP_Inventory_C")));
 
     // Set the default player controller class
     PlayerControllerClass = ALotAPlayerController::StaticClass();
-
-    // Find and set the inventory widget class
-    static ConstructorHelpers::FClassFinder<UInventoryWidget> InventoryWidgetBPClass(TEXT("/Game/Inventory/Widgets/WBP_Inventory"));
-    if (InventoryWidgetBPClass.Succeeded())
-    {
-        DefaultInventoryWidgetClass = InventoryWidgetBPClass.Class;
-    }
 }
 
 void ALotAGameModeBase::BeginPlay()
 {
     Super::BeginPlay();
 
-    UE_LOG(LogTemp, Warning, TEXT("GameMode BeginPlay - Default Pawn: %s"), *GetNameSafe(DefaultPawnClass));
+    UE_LOG(LogTemp, Verbose, TEXT("GameMode BeginPlay - Default Pawn: %s"), *PlayerPawnClass.ToString());
 }
 
 void ALotAGameModeBase::InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage)
 {
     Super::InitGame(MapName, Options, ErrorMessage);
-}
\ No newline at end of file
+
+    // Stream the pawn in alongside the rest of the map so the first spawn doesn't wait on it
+    if (!PlayerPawnClass.IsNull() && !PlayerPawnClass.Get())
+    {
+        PlayerPawnClassHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(PlayerPawnClass.ToSoftObjectPath());
+    }
+}
+
+UClass* ALotAGameModeBase::GetDefaultPawnClassForController_Implementation(AController* InController)
+{
+    // A pawn class set on the Blueprint wins over the configured one
+    if (DefaultPawnClass && DefaultPawnClass != ADefaultPawn::StaticClass())
+    {
+        return Super::GetDefaultPawnClassForController_Implementation(InController);
+    }
+
+    // Blocks only if the async load from InitGame hasn't finished yet
+    if (UClass* PawnClass = PlayerPawnClass.LoadSynchronous())
+    {
+        return PawnClass;
+    }
+    return Super::GetDefaultPawnClassForController_Implementation(InController);
+}
+
+TSubclassOf<UInventoryWidget> ALotAGameModeBase::GetInventoryWidgetClass() const
+{
+    if (IsNetMode(NM_DedicatedServer))
+    {
+        return nullptr;
+    }
+    return DefaultInventoryWidgetClass.LoadSynchronous();
+}
@@ -3,11 +3,35 @@
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "Blueprint/UserWidget.h"
+#include "InventoryRegistryComponent.h"
+#include "ItemUseComponent.h"
+#include "HotbarComponent.h"
+#include "InventoryRouterComponent.h"
+#include "ItemInspectComponent.h"
+#include "TradeComponent.h"
+#include "TradeWindowWidget.h"
+#include "HotbarWidget.h"
+#include "BagWidget.h"
+#include "WindowLayoutSubsystem.h"
+#include "Blueprint/WidgetLayoutLibrary.h"
 
 ALotAPlayerController::ALotAPlayerController()
 {
     bShowMouseCursor = true;
     DefaultMouseCursor = EMouseCursor::Default;
+
+    BagWindowColumns = 4;
+    BagWindowSlotSize = 52.0f;
+    BagWindowChromeHeight = 36.0f;
+    BagWindowSpacing = 8.0f;
+    bBatchingBagWindows = false;
+
+    InventoryRegistry = CreateDefaultSubobject<UInventoryRegistryComponent>(TEXT("InventoryRegistry"));
+    ItemUseComponent = CreateDefaultSubobject<UItemUseComponent>(TEXT("ItemUseComponent"));
+    HotbarComponent = CreateDefaultSubobject<UHotbarComponent>(TEXT("HotbarComponent"));
+    InventoryRouter = CreateDefaultSubobject<UInventoryRouterComponent>(TEXT("InventoryRouter"));
+    ItemInspect = CreateDefaultSubobject<UItemInspectComponent>(TEXT("ItemInspect"));
+    TradeComponent = CreateDefaultSubobject<UTradeComponent>(TEXT("TradeComponent"));
 }
 
 void ALotAPlayerController::BeginPlay()
@@ -28,9 +52,9 @@ void ALotAPlayerController::BeginPlay()
     }
 
     // Create and Add Main Inventory Widget
-    if (MainInventoryWidgetClass)
+    if (!MainInventoryWidgetClass.IsNull() && IsLocalController())
     {
-        MainInventoryWidget = CreateWidget<UMainInventoryWidget>(this, MainInventoryWidgetClass);
+        MainInventoryWidget = CreateWidget<UMainInventoryWidget>(this, MainInventoryWidgetClass.LoadSynchronous());
         if (MainInventoryWidget)
         {
             MainInventoryWidget->AddToViewport();
@@ -38,6 +62,72 @@ void ALotAPlayerController::BeginPlay()
             UE_LOG(LogTemp, Warning, TEXT("MainInventoryWidget created and added to viewport"));
         }
     }
+
+    if (!HotbarWidgetClass.IsNull() && IsLocalController())
+    {
+        HotbarWidget = CreateWidget<UHotbarWidget>(this, HotbarWidgetClass.LoadSynchronous());
+        if (HotbarWidget)
+        {
+            HotbarWidget->AddToViewport();
+            HotbarWidget->InitializeHotbar(HotbarComponent);
+        }
+    }
+
+    // The registry reports bags of whichever pawn is possessed, on the server and the owning client
+    InventoryRegistry->OnContainerAdded.AddUObject(this, &ALotAPlayerController::SubscribeToBag);
+    for (UBagComponent* Bag : InventoryRegistry->GetBags())
+    {
+        SubscribeToBag(Bag);
+    }
+
+    if (IsLocalController())
+    {
+        TradeComponent->OnTradeUpdated.AddUniqueDynamic(this, &ALotAPlayerController::OnTradeUpdated);
+        TradeComponent->OnTradeClosed.AddUniqueDynamic(this, &ALotAPlayerController::OnTradeClosed);
+    }
+}
+
+void ALotAPlayerController::OnTradeUpdated(const FTradeWindowState& State)
+{
+    // The window binds itself to later updates
+    if (TradeWindow || TradeWindowClass.IsNull())
+        return;
+
+    TradeWindow = CreateWidget<UTradeWindowWidget>(this, TradeWindowClass.LoadSynchronous());
+    if (TradeWindow)
+    {
+        TradeWindow->AddToViewport();
+        TradeWindow->BindToTrade(TradeComponent);
+    }
+}
+
+void ALotAPlayerController::OnTradeClosed(bool bCompleted)
+{
+    if (TradeWindow)
+    {
+        TradeWindow->RemoveFromParent();
+        TradeWindow = nullptr;
+    }
+}
+
+void ALotAPlayerController::SetPawn(APawn* InPawn)
+{
+    Super::SetPawn(InPawn);
+
+    if (BagEventPawn.Get() == InPawn)
+        return;
+
+    CloseAllBags();
+    BagEventPawn = InPawn;
+}
+
+void ALotAPlayerController::SubscribeToBag(UBagComponent* Bag)
+{
+    if (Bag)
+    {
+        Bag->OnBagOpened.AddUniqueDynamic(this, &ALotAPlayerController::OnBagOpened);
+        Bag->OnBagClosed.AddUniqueDynamic(this, &ALotAPlayerController::OnBagClosed);
+    }
 }
 
 void ALotAPlayerController::SetupInputComponent()
@@ -59,6 +149,19 @@ void ALotAPlayerController::SetupInputComponent()
         {
             UE_LOG(LogTemp, Error, TEXT("IA_Inventory is null"));
         }
+
+        if (IA_OpenAllBags)
+        {
+            EnhancedInput->BindAction(IA_OpenAllBags, ETriggerEvent::Started, this, &ALotAPlayerController::OpenAllBags);
+        }
+
+        for (int32 SlotIndex = 0; SlotIndex < IA_HotbarSlots.Num(); ++SlotIndex)
+        {
+            if (IA_HotbarSlots[SlotIndex])
+            {
+                EnhancedInput->BindAction(IA_HotbarSlots[SlotIndex], ETriggerEvent::Started, this, &ALotAPlayerController::ActivateHotbarSlot, SlotIndex);
+            }
+        }
     }
     else
     {
@@ -77,14 +180,7 @@ void ALotAPlayerController::ToggleMainInventory()
         bShowMouseCursor = false;
 
         // Close all open bags when closing inventory
-        TArray<UBagComponent*> BagsToClose = OpenBags;
-        for (UBagComponent* Bag : BagsToClose)
-        {
-            if (Bag)
-            {
-                Bag->CloseBag();
-            }
-        }
+        CloseAllBags();
     }
     else
     {
@@ -99,12 +195,20 @@ void ALotAPlayerController::ToggleMainInventory()
 
 void ALotAPlayerController::OpenAllBags()
 {
-    // Get all bag components from the player's inventory
-    if (APawn* PlayerPawn = GetPawn())
+    if (GetPawn())
     {
-        TArray<UBagComponent*> AllBags;
-        PlayerPawn->GetComponents<UBagComponent>(AllBags);
+        const TArray<UBagComponent*>& AllBags = InventoryRegistry->GetBags();
 
+        // Second press closes them again
+        const bool bAllOpen = AllBags.Num() > 0 && !AllBags.ContainsByPredicate([](const UBagComponent* Bag) { return Bag && !Bag->IsBagOpen(); });
+        if (bAllOpen)
+        {
+            CloseAllBags();
+            return;
+        }
+
+        // Queue every window, then create and lay them out together
+        bBatchingBagWindows = true;
         for (UBagComponent* Bag : AllBags)
         {
             if (Bag && !Bag->IsBagOpen())
@@ -112,21 +216,149 @@ void ALotAPlayerController::OpenAllBags()
                 Bag->OpenBag();
             }
         }
+        bBatchingBagWindows = false;
+
+        FlushPendingBagWindows();
+    }
+}
+
+void ALotAPlayerController::CloseAllBags()
+{
+    // OnBagClosed skips its per-bag removal while batching; the map is dropped in one go below
+    bBatchingBagWindows = true;
+    for (const TPair<TObjectPtr<UBagComponent>, TObjectPtr<UBagWidget>>& Entry : OpenBags)
+    {
+        if (Entry.Key)
+        {
+            Entry.Key->CloseBag();
+        }
+        RemoveBagWindow(Entry.Key, Entry.Value);
+    }
+    bBatchingBagWindows = false;
+
+    OpenBags.Empty();
+    PendingBagWindows.Empty();
+}
+
+void ALotAPlayerController::FlushPendingBagWindows()
+{
+    if (PendingBagWindows.Num() == 0)
+        return;
+
+    UClass* LoadedBagWidgetClass = IsLocalController() ? BagWidgetClass.LoadSynchronous() : nullptr;
+    if (!LoadedBagWidgetClass)
+    {
+        for (const TWeakObjectPtr<UBagComponent>& Bag : PendingBagWindows)
+        {
+            if (Bag.IsValid())
+            {
+                OpenBags.Add(Bag.Get(), nullptr);
+            }
+        }
+        PendingBagWindows.Reset();
+        return;
+    }
+
+    int32 ViewportX = 0;
+    int32 ViewportY = 0;
+    GetViewportSize(ViewportX, ViewportY);
+    const float ViewportScale = FMath::Max(UWidgetLayoutLibrary::GetViewportScale(this), KINDA_SMALL_NUMBER);
+    const FVector2D ViewportSize = FVector2D(ViewportX, ViewportY) / ViewportScale;
+
+    UWindowLayoutSubsystem* Layout = UWindowLayoutSubsystem::Get(this);
+
+    // New windows stack upwards from the bottom-right corner, starting a new column when one fills up
+    FVector2D Cursor(ViewportSize.X - BagWindowSpacing, ViewportSize.Y - BagWindowSpacing);
+    float ColumnWidth = 0.0f;
+
+    for (const TWeakObjectPtr<UBagComponent>& BagPtr : PendingBagWindows)
+    {
+        UBagComponent* Bag = BagPtr.Get();
+        if (!Bag || OpenBags.Contains(Bag) || !Bag->IsBagOpen())
+            continue;
+
+        UBagWidget* Window = CreateWidget<UBagWidget>(this, LoadedBagWidgetClass);
+        if (!Window)
+            continue;
+
+        FVector2D Position;
+        if (!Layout || !Layout->FindWindowPosition(Bag->GetFName(), Position))
+        {
+            const FVector2D Size = GetBagWindowSize(Bag);
+            if (Cursor.Y - Size.Y < BagWindowSpacing && ColumnWidth > 0.0f)
+            {
+                Cursor.X -= ColumnWidth + BagWindowSpacing;
+                Cursor.Y = ViewportSize.Y - BagWindowSpacing;
+                ColumnWidth = 0.0f;
+            }
+
+            Position = FVector2D(Cursor.X - Size.X, Cursor.Y - Size.Y);
+            Cursor.Y -= Size.Y + BagWindowSpacing;
+            ColumnWidth = FMath::Max(ColumnWidth, Size.X);
+
+            if (Layout)
+            {
+                Layout->SetWindowPosition(Bag->GetFName(), Position);
+            }
+        }
+
+        Window->BindToBag(Bag, BagWindowColumns);
+        Window->SetLayoutKey(Bag->GetFName());
+        Window->AddToViewport(1);
+        Window->SetWindowPosition(Position);
+        OpenBags.Add(Bag, Window);
+    }
+
+    PendingBagWindows.Reset();
+}
+
+void ALotAPlayerController::RemoveBagWindow(UBagComponent* Bag, UBagWidget* Window)
+{
+    // The position stays in the window layout under the bag's name, so reopening puts the window back where it was
+    if (Window)
+    {
+        Window->BindToBag(nullptr, BagWindowColumns);
+        Window->RemoveFromParent();
+    }
+}
+
+FVector2D ALotAPlayerController::GetBagWindowSize(const UBagComponent* Bag) const
+{
+    const int32 Columns = FMath::Max(1, BagWindowColumns);
+    const int32 Rows = FMath::DivideAndRoundUp(FMath::Max(1, Bag->GetBagSlots()), Columns);
+    return FVector2D(Columns * BagWindowSlotSize, Rows * BagWindowSlotSize + BagWindowChromeHeight);
+}
+
+void ALotAPlayerController::ActivateHotbarSlot(int32 SlotIndex)
+{
+    if (HotbarComponent)
+    {
+        HotbarComponent->ActivateSlot(SlotIndex);
     }
 }
 
 void ALotAPlayerController::OnBagOpened(UBagComponent* Bag)
 {
-    if (Bag)
+    if (!Bag || OpenBags.Contains(Bag))
+        return;
+
+    PendingBagWindows.Add(Bag);
+
+    // Opened on its own rather than through OpenAllBags
+    if (!bBatchingBagWindows)
     {
-        OpenBags.AddUnique(Bag);
+        FlushPendingBagWindows();
     }
 }
 
 void ALotAPlayerController::OnBagClosed(UBagComponent* Bag)
 {
-    if (Bag)
+    if (!Bag || bBatchingBagWindows)
+        return;
+
+    TObjectPtr<UBagWidget> Window;
+    if (OpenBags.RemoveAndCopyValue(Bag, Window))
     {
-        OpenBags.Remove(Bag);
+        RemoveBagWindow(Bag, Window);
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,104 @@
+// StartupBenchmarkSubsystem.cpp
+#include "StartupBenchmarkSubsystem.h"
+#include "Blueprint/UserWidget.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/UObjectGlobals.h"
+
+bool UStartupBenchmarkSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	return FParse::Param(FCommandLine::Get(), TEXT("StartupBenchmark")) && !IsRunningCommandlet() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UStartupBenchmarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	// Engine subsystems come up in UEngine::Init, after module loading and before the first map
+	EngineInitSeconds = SecondsSinceStart();
+
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &UStartupBenchmarkSubsystem::HandlePreLoadMap);
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UStartupBenchmarkSubsystem::HandlePostLoadMap);
+}
+
+void UStartupBenchmarkSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+	Super::Deinitialize();
+}
+
+void UStartupBenchmarkSubsystem::HandlePreLoadMap(const FString& InMapName)
+{
+	if (!bRecorded)
+	{
+		MapName = InMapName;
+		MapLoadStartSeconds = SecondsSinceStart();
+	}
+}
+
+void UStartupBenchmarkSubsystem::HandlePostLoadMap(UWorld* World)
+{
+	// The first game map is the one startup waits on; editor and transition worlds don't count
+	if (bRecorded || !World || !World->IsGameWorld() || MapLoadStartSeconds <= 0.0)
+	{
+		return;
+	}
+	bRecorded = true;
+
+	const double Now = SecondsSinceStart();
+	WriteRow(Now - MapLoadStartSeconds, Now);
+
+	if (!FParse::Param(FCommandLine::Get(), TEXT("StartupBenchmarkKeepRunning")))
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+void UStartupBenchmarkSubsystem::WriteRow(double MapLoadSeconds, double TotalSeconds) const
+{
+	// Widget Blueprints that got pulled in; a dedicated server should have none
+	int32 WidgetClasses = 0;
+	for (TObjectIterator<UClass> It; It; ++It)
+	{
+		if (It->IsChildOf(UUserWidget::StaticClass()) && It->HasAnyClassFlags(CLASS_CompiledFromBlueprint))
+		{
+			++WidgetClasses;
+		}
+	}
+
+	const int32 NumObjects = GUObjectArray.GetObjectArrayNumMinusAvailable();
+	const double UsedMB = double(FPlatformMemory::GetStats().UsedPhysical) / (1024.0 * 1024.0);
+	const TCHAR* Mode = IsRunningDedicatedServer() ? TEXT("Server") : TEXT("Game");
+
+	const FString CsvPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Profiling"), TEXT("StartupBenchmark.csv"));
+	const bool bNewFile = !IFileManager::Get().FileExists(*CsvPath);
+
+	FString Rows;
+	if (bNewFile)
+	{
+		Rows += TEXT("Timestamp,Mode,Map,EngineInitSeconds,MapLoadSeconds,TotalSeconds,Objects,WidgetClasses,UsedPhysicalMB\n");
+	}
+	Rows += FString::Printf(TEXT("%s,%s,%s,%.3f,%.3f,%.3f,%d,%d,%.1f\n"),
+		*FDateTime::UtcNow().ToIso8601(), Mode, *FPaths::GetBaseFilename(MapName),
+		EngineInitSeconds, MapLoadSeconds, TotalSeconds, NumObjects, WidgetClasses, UsedMB);
+
+	if (!FFileHelper::SaveStringToFile(Rows, *CsvPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM, &IFileManager::Get(), FILEWRITE_Append))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not write startup benchmark to %s"), *CsvPath);
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Startup benchmark: engine init %.3fs, map %s %.3fs, total %.3fs, %d objects, %d widget classes -> %s"),
+		EngineInitSeconds, *MapName, MapLoadSeconds, TotalSeconds, NumObjects, WidgetClasses, *CsvPath);
+}
+
+double UStartupBenchmarkSubsystem::SecondsSinceStart()
+{
+	return FPlatformTime::Seconds() - GStartTime;
+}
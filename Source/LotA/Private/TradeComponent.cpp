@@ -0,0 +1,148 @@
+// TradeComponent.cpp
+#include "TradeComponent.h"
+#include "TradeSubsystem.h"
+#include "VendorComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+
+UTradeComponent::UTradeComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void UTradeComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	// A player leaving mid-trade cancels it for the partner too
+	if (GetOwnerRole() == ROLE_Authority)
+	{
+		if (UTradeSubsystem* Trades = GetTradeSubsystem())
+		{
+			Trades->CancelTrade(GetPlayerController());
+		}
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void UTradeComponent::RequestTrade(APlayerState* Partner)
+{
+	ServerRequestTrade(Partner);
+}
+
+void UTradeComponent::StageItem(UBagComponent* Bag, int32 SlotIndex, int32 Count)
+{
+	ServerStageItem(Bag, SlotIndex, Count);
+}
+
+void UTradeComponent::UnstageItem(int32 OfferIndex)
+{
+	ServerUnstageItem(OfferIndex);
+}
+
+void UTradeComponent::SetAccepted(bool bAccepted)
+{
+	ServerSetAccepted(bAccepted);
+}
+
+void UTradeComponent::CancelTrade()
+{
+	ServerCancelTrade();
+}
+
+void UTradeComponent::BuyFromVendor(UVendorComponent* Vendor, int32 StockIndex, int32 Count)
+{
+	ServerBuyFromVendor(Vendor, StockIndex, Count);
+}
+
+void UTradeComponent::SellToVendor(UVendorComponent* Vendor, UBagComponent* Bag, int32 SlotIndex, int32 Count)
+{
+	ServerSellToVendor(Vendor, Bag, SlotIndex, Count);
+}
+
+void UTradeComponent::ServerRequestTrade_Implementation(APlayerState* Partner)
+{
+	UTradeSubsystem* Trades = GetTradeSubsystem();
+	APlayerController* PartnerController = Partner ? Partner->GetPlayerController() : nullptr;
+	if (Trades && PartnerController)
+	{
+		Trades->RequestTrade(GetPlayerController(), PartnerController);
+	}
+}
+
+void UTradeComponent::ServerStageItem_Implementation(UBagComponent* Bag, int32 SlotIndex, int32 Count)
+{
+	if (UTradeSubsystem* Trades = GetTradeSubsystem())
+	{
+		Trades->StageItem(GetPlayerController(), Bag, SlotIndex, Count);
+	}
+}
+
+void UTradeComponent::ServerUnstageItem_Implementation(int32 OfferIndex)
+{
+	if (UTradeSubsystem* Trades = GetTradeSubsystem())
+	{
+		Trades->UnstageItem(GetPlayerController(), OfferIndex);
+	}
+}
+
+void UTradeComponent::ServerSetAccepted_Implementation(bool bAccepted)
+{
+	if (UTradeSubsystem* Trades = GetTradeSubsystem())
+	{
+		Trades->SetAccepted(GetPlayerController(), bAccepted);
+	}
+}
+
+void UTradeComponent::ServerCancelTrade_Implementation()
+{
+	if (UTradeSubsystem* Trades = GetTradeSubsystem())
+	{
+		Trades->CancelTrade(GetPlayerController());
+	}
+}
+
+void UTradeComponent::ServerBuyFromVendor_Implementation(UVendorComponent* Vendor, int32 StockIndex, int32 Count)
+{
+	APlayerController* PlayerController = GetPlayerController();
+	if (Vendor && PlayerController)
+	{
+		Vendor->QueuePurchase(PlayerController, StockIndex, Count);
+	}
+}
+
+void UTradeComponent::ServerSellToVendor_Implementation(UVendorComponent* Vendor, UBagComponent* Bag, int32 SlotIndex, int32 Count)
+{
+	APlayerController* PlayerController = GetPlayerController();
+	if (Vendor && PlayerController)
+	{
+		Vendor->QueueSell(PlayerController, Bag, SlotIndex, Count);
+	}
+}
+
+void UTradeComponent::ClientTradeRequested_Implementation(APlayerState* FromPlayer)
+{
+	OnTradeRequested.Broadcast(FromPlayer);
+}
+
+void UTradeComponent::ClientTradeUpdated_Implementation(const FTradeWindowState& State)
+{
+	TradeState = State;
+	OnTradeUpdated.Broadcast(TradeState);
+}
+
+void UTradeComponent::ClientTradeClosed_Implementation(bool bCompleted)
+{
+	TradeState = FTradeWindowState();
+	OnTradeClosed.Broadcast(bCompleted);
+}
+
+APlayerController* UTradeComponent::GetPlayerController() const
+{
+	return Cast<APlayerController>(GetOwner());
+}
+
+UTradeSubsystem* UTradeComponent::GetTradeSubsystem() const
+{
+	return UTradeSubsystem::Get(this);
+}
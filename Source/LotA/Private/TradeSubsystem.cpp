@@ -0,0 +1,548 @@
+// TradeSubsystem.cpp
+#include "TradeSubsystem.h"
+#include "TradeComponent.h"
+#include "BagComponent.h"
+#include "InventoryAudit.h"
+#include "InventoryCommandSubsystem.h"
+#include "InventoryRegistryComponent.h"
+#include "InventorySlotDataComponent.h"
+#include "ItemInstanceSubsystem.h"
+#include "Algo/AnyOf.h"
+#include "Engine/World.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+
+namespace
+{
+	UInventorySlotDataComponent* GetOfferSlot(const FTradeOfferItem& Offer)
+	{
+		const TArray<UInventorySlotDataComponent*>* Slots = Offer.Bag ? &Offer.Bag->GetInventorySlots() : nullptr;
+		return Slots && Slots->IsValidIndex(Offer.SlotIndex) ? (*Slots)[Offer.SlotIndex] : nullptr;
+	}
+
+	UTradeComponent* GetTradeComponent(const APlayerController* PlayerController)
+	{
+		return PlayerController ? PlayerController->FindComponentByClass<UTradeComponent>() : nullptr;
+	}
+}
+
+UTradeSubsystem::UTradeSubsystem()
+	: MaxTradeDistance(1000.0f)
+	, NextSessionId(1)
+{
+}
+
+UTradeSubsystem* UTradeSubsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	return World ? World->GetSubsystem<UTradeSubsystem>() : nullptr;
+}
+
+void UTradeSubsystem::Deinitialize()
+{
+	Sessions.Empty();
+	UnwatchUnstagedBags();
+	SessionByParty.Empty();
+	PendingRequests.Empty();
+
+	Super::Deinitialize();
+}
+
+void UTradeSubsystem::RequestTrade(APlayerController* Requester, APlayerController* Target)
+{
+	if (!Requester || !Target || Requester == Target || IsTrading(Requester) || IsTrading(Target))
+	{
+		return;
+	}
+
+	FTradeSession Session;
+	Session.Parties[0] = Requester;
+	Session.Parties[1] = Target;
+	if (!InRange(Session))
+	{
+		return;
+	}
+
+	// Target asked first, so this request is the answer
+	const TWeakObjectPtr<const APlayerController>* TargetRequest = PendingRequests.Find(Target);
+	if (!TargetRequest || TargetRequest->Get() != Requester)
+	{
+		PendingRequests.Add(Requester, Target);
+		if (UTradeComponent* TargetTrade = GetTradeComponent(Target))
+		{
+			TargetTrade->ClientTradeRequested(Requester->PlayerState);
+		}
+		return;
+	}
+
+	PendingRequests.Remove(Requester);
+	PendingRequests.Remove(Target);
+
+	const int32 SessionId = NextSessionId++;
+	SessionByParty.Add(Requester, SessionId);
+	SessionByParty.Add(Target, SessionId);
+	SendState(SessionId, Sessions.Add(SessionId, MoveTemp(Session)));
+}
+
+bool UTradeSubsystem::StageItem(APlayerController* Party, UBagComponent* Bag, int32 SlotIndex, int32 Count)
+{
+	int32 Side = 0;
+	FTradeSession* Session = FindSession(Party, Side);
+	const APawn* Pawn = Party ? Party->GetPawn() : nullptr;
+	if (!Session || !Pawn || !Bag || Bag->GetOwner() != Pawn)
+	{
+		return false;
+	}
+
+	FTradeOfferItem Offer;
+	Offer.Bag = Bag;
+	Offer.SlotIndex = SlotIndex;
+	const UInventorySlotDataComponent* Slot = GetOfferSlot(Offer);
+	if (!Slot || Slot->IsEmpty() || Count <= 0 || Count > Slot->GetStackCount())
+	{
+		return false;
+	}
+	Offer.ItemID = Slot->GetItemData().ItemID;
+	Offer.Count = Count;
+	Offer.Instance = Slot->GetInstanceHandle();
+
+	TArray<FTradeOfferItem>& Offers = Session->Offers[Side];
+	FTradeOfferItem* Existing = Offers.FindByPredicate([&Offer](const FTradeOfferItem& Other) { return Other.Bag == Offer.Bag && Other.SlotIndex == Offer.SlotIndex; });
+	if (Existing)
+	{
+		*Existing = Offer;
+	}
+	else if (Offers.Num() < MaxOfferItems)
+	{
+		Offers.Add(Offer);
+	}
+	else
+	{
+		return false;
+	}
+
+	WatchBag(Bag);
+	ResetAcceptance(*Session);
+	SendState(SessionByParty.FindRef(Party), *Session);
+	return true;
+}
+
+bool UTradeSubsystem::UnstageItem(APlayerController* Party, int32 OfferIndex)
+{
+	int32 Side = 0;
+	FTradeSession* Session = FindSession(Party, Side);
+	if (!Session || !Session->Offers[Side].IsValidIndex(OfferIndex))
+	{
+		return false;
+	}
+
+	Session->Offers[Side].RemoveAt(OfferIndex);
+	ResetAcceptance(*Session);
+	SendState(SessionByParty.FindRef(Party), *Session);
+	return true;
+}
+
+void UTradeSubsystem::SetAccepted(APlayerController* Party, bool bAccepted)
+{
+	int32 Side = 0;
+	FTradeSession* Session = FindSession(Party, Side);
+	if (!Session || Session->bAccepted[Side] == bAccepted)
+	{
+		return;
+	}
+
+	const int32 SessionId = SessionByParty.FindRef(Party);
+	Session->bAccepted[Side] = bAccepted;
+	SendState(SessionId, *Session);
+
+	UInventoryCommandSubsystem* Commands = UInventoryCommandSubsystem::Get(this);
+	if (Session->bAccepted[0] && Session->bAccepted[1] && !Session->bCommitQueued && Commands)
+	{
+		Session->bCommitQueued = true;
+		APlayerController* Parties[] = { Session->Parties[0].Get(), Session->Parties[1].Get() };
+		TWeakObjectPtr<UTradeSubsystem> WeakThis(this);
+		Commands->Enqueue(Parties, MakeUnique<FInventoryApplyCommand>([WeakThis, SessionId]()
+		{
+			if (UTradeSubsystem* Trades = WeakThis.Get())
+			{
+				Trades->CommitQueued(SessionId);
+			}
+		},
+		[WeakThis, SessionId]()
+		{
+			if (UTradeSubsystem* Trades = WeakThis.Get())
+			{
+				Trades->CommitDiscarded(SessionId);
+			}
+		}));
+	}
+}
+
+void UTradeSubsystem::CancelTrade(APlayerController* Party)
+{
+	PendingRequests.Remove(Party);
+
+	if (const int32* SessionId = SessionByParty.Find(Party))
+	{
+		EndSession(*SessionId, false);
+	}
+}
+
+void UTradeSubsystem::CommitQueued(int32 SessionId)
+{
+	FTradeSession* Session = Sessions.Find(SessionId);
+	if (!Session)
+	{
+		return;
+	}
+
+	Session->bCommitQueued = false;
+
+	// Either side may have changed its offer since accepting, which cleared the acceptance
+	if (Session->bAccepted[0] && Session->bAccepted[1] && Commit(*Session))
+	{
+		EndSession(SessionId, true);
+	}
+	else
+	{
+		ResetAcceptance(*Session);
+		SendState(SessionId, *Session);
+	}
+}
+
+void UTradeSubsystem::CommitDiscarded(int32 SessionId)
+{
+	// A party's queue went away with the commit in it, so it never ran; both sides accept again
+	if (FTradeSession* Session = Sessions.Find(SessionId))
+	{
+		Session->bCommitQueued = false;
+		ResetAcceptance(*Session);
+		SendState(SessionId, *Session);
+	}
+}
+
+bool UTradeSubsystem::Commit(FTradeSession& Session)
+{
+	TGuardValue<bool> CommitGuard(bCommitting, true);
+
+	if (!InRange(Session) || !ValidateOffer(Session, 0) || !ValidateOffer(Session, 1))
+	{
+		return false;
+	}
+
+	const APawn* Pawns[2] = { Session.Parties[0]->GetPawn(), Session.Parties[1]->GetPawn() };
+
+	// Each side must have room for what it receives, counting the slots its own offer empties
+	for (int32 Side = 0; Side < 2; ++Side)
+	{
+		const int32 Receiver = 1 - Side;
+
+		int32 Needed = 0;
+		for (const FTradeOfferItem& Offer : Session.Offers[Side])
+		{
+			Needed += SlotsNeeded(GetOfferSlot(Offer)->GetItemData(), Offer.Count);
+		}
+
+		int32 Freed = 0;
+		for (const FTradeOfferItem& Offer : Session.Offers[Receiver])
+		{
+			Freed += Offer.Count == GetOfferSlot(Offer)->GetStackCount() ? 1 : 0;
+		}
+
+		if (Needed > CountFreeSlots(Pawns[Receiver]) + Freed)
+		{
+			UE_LOG(LogTemp, Log, TEXT("Trade: %s has no room for the offered items"), *GetNameSafe(Session.Parties[Receiver].Get()));
+			return false;
+		}
+	}
+
+	struct FTakenItems
+	{
+		FS_ItemInfo Item;
+		int32 Count;
+		FItemInstanceHandle Instance;
+		UInventorySlotDataComponent* Source;
+	};
+
+	FInventoryAuditScope AuditScope(EInventoryAuditOp::Trade);
+
+	// Everything was checked above, so from here on the exchange runs to completion
+	TArray<FTakenItems, TInlineAllocator<MaxOfferItems>> Taken[2];
+	for (int32 Side = 0; Side < 2; ++Side)
+	{
+		for (const FTradeOfferItem& Offer : Session.Offers[Side])
+		{
+			UInventorySlotDataComponent* Slot = GetOfferSlot(Offer);
+			FTakenItems& Items = Taken[Side].Add_GetRef({ Slot->GetItemData(), Offer.Count, FItemInstanceHandle(), Slot });
+			Slot->TakeItems(Offer.Count, Items.Instance);
+		}
+	}
+
+	for (int32 Side = 0; Side < 2; ++Side)
+	{
+		for (const FTakenItems& Items : Taken[Side])
+		{
+			int32 Leftover = AddToBags(Pawns[1 - Side], Items.Item, Items.Count, Items.Instance);
+			if (!ensureMsgf(Leftover == 0, TEXT("Trade placement failed after its capacity check")))
+			{
+				// Give back what didn't fit rather than lose it
+				if (!Items.Source->PutItems(Items.Item, Leftover, Items.Instance))
+				{
+					Leftover = AddToBags(Pawns[Side], Items.Item, Leftover, Items.Instance);
+					UE_CLOG(Leftover > 0, LogTemp, Error, TEXT("Trade lost %d x %s"), Leftover, *Items.Item.ItemID.ToString());
+				}
+			}
+		}
+	}
+	return true;
+}
+
+bool UTradeSubsystem::ValidateOffer(const FTradeSession& Session, int32 Side) const
+{
+	const APlayerController* Party = Session.Parties[Side].Get();
+	const APawn* Pawn = Party ? Party->GetPawn() : nullptr;
+	if (!Pawn)
+	{
+		return false;
+	}
+
+	// Offers may have gone stale while the other side was deciding
+	for (const FTradeOfferItem& Offer : Session.Offers[Side])
+	{
+		const UInventorySlotDataComponent* Slot = GetOfferSlot(Offer);
+		if (!Slot || Offer.Bag->GetOwner() != Pawn || Slot->IsEmpty() || Slot->GetItemData().ItemID != Offer.ItemID
+			|| Slot->GetInstanceHandle() != Offer.Instance || Offer.Count > Slot->GetStackCount())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+bool UTradeSubsystem::InRange(const FTradeSession& Session) const
+{
+	const APlayerController* First = Session.Parties[0].Get();
+	const APlayerController* Second = Session.Parties[1].Get();
+	const APawn* FirstPawn = First ? First->GetPawn() : nullptr;
+	const APawn* SecondPawn = Second ? Second->GetPawn() : nullptr;
+	return FirstPawn && SecondPawn && FVector::DistSquared(FirstPawn->GetActorLocation(), SecondPawn->GetActorLocation()) <= FMath::Square(MaxTradeDistance);
+}
+
+UTradeSubsystem::FTradeSession* UTradeSubsystem::FindSession(const APlayerController* Party, int32& OutSide)
+{
+	const int32* SessionId = SessionByParty.Find(Party);
+	FTradeSession* Session = SessionId ? Sessions.Find(*SessionId) : nullptr;
+	if (Session)
+	{
+		OutSide = Session->Parties[0].Get() == Party ? 0 : 1;
+	}
+	return Session;
+}
+
+void UTradeSubsystem::ResetAcceptance(FTradeSession& Session)
+{
+	Session.bAccepted[0] = false;
+	Session.bAccepted[1] = false;
+}
+
+void UTradeSubsystem::WatchBag(UBagComponent* Bag)
+{
+	if (Bag && !WatchedBags.Contains(Bag))
+	{
+		WatchedBags.Add(Bag, Bag->OnSlotChanged.AddUObject(this, &UTradeSubsystem::HandleBagSlotChanged));
+	}
+}
+
+void UTradeSubsystem::UnwatchUnstagedBags()
+{
+	TSet<const UBagComponent*> StagedBags;
+	for (const TPair<int32, FTradeSession>& Session : Sessions)
+	{
+		for (const TArray<FTradeOfferItem>& Offers : Session.Value.Offers)
+		{
+			for (const FTradeOfferItem& Offer : Offers)
+			{
+				StagedBags.Add(Offer.Bag);
+			}
+		}
+	}
+
+	for (auto It = WatchedBags.CreateIterator(); It; ++It)
+	{
+		UBagComponent* Bag = It.Key().Get();
+		if (!StagedBags.Contains(Bag))
+		{
+			if (Bag)
+			{
+				Bag->OnSlotChanged.Remove(It.Value());
+			}
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UTradeSubsystem::HandleBagSlotChanged(UBagComponent* Bag, int32 SlotIndex)
+{
+	if (bCommitting)
+	{
+		return;
+	}
+
+	// What either side accepted is no longer what's on the table
+	for (TPair<int32, FTradeSession>& Session : Sessions)
+	{
+		const bool bStaged = Algo::AnyOf(Session.Value.Offers, [Bag, SlotIndex](const TArray<FTradeOfferItem>& Offers)
+		{
+			return Offers.ContainsByPredicate([Bag, SlotIndex](const FTradeOfferItem& Offer) { return Offer.Bag == Bag && Offer.SlotIndex == SlotIndex; });
+		});
+
+		if (bStaged && (Session.Value.bAccepted[0] || Session.Value.bAccepted[1]))
+		{
+			ResetAcceptance(Session.Value);
+			SendState(Session.Key, Session.Value);
+		}
+	}
+}
+
+void UTradeSubsystem::SendState(int32 SessionId, const FTradeSession& Session) const
+{
+	for (int32 Side = 0; Side < 2; ++Side)
+	{
+		const APlayerController* Partner = Session.Parties[1 - Side].Get();
+		UTradeComponent* Trade = GetTradeComponent(Session.Parties[Side].Get());
+		if (!Trade)
+		{
+			continue;
+		}
+
+		FTradeWindowState State;
+		State.SessionId = SessionId;
+		State.Partner = Partner ? Partner->PlayerState : nullptr;
+		State.MyOffer = Session.Offers[Side];
+		State.bMyAccepted = Session.bAccepted[Side];
+		State.bPartnerAccepted = Session.bAccepted[1 - Side];
+
+		// The partner's bags mean nothing to this client; only what and how many
+		State.PartnerOffer.Reserve(Session.Offers[1 - Side].Num());
+		for (const FTradeOfferItem& Offer : Session.Offers[1 - Side])
+		{
+			FTradeOfferItem& View = State.PartnerOffer.AddDefaulted_GetRef();
+			View.ItemID = Offer.ItemID;
+			View.Count = Offer.Count;
+		}
+
+		Trade->ClientTradeUpdated(State);
+	}
+}
+
+void UTradeSubsystem::EndSession(int32 SessionId, bool bCompleted)
+{
+	FTradeSession Session;
+	if (!Sessions.RemoveAndCopyValue(SessionId, Session))
+	{
+		return;
+	}
+
+	for (const TWeakObjectPtr<APlayerController>& Party : Session.Parties)
+	{
+		SessionByParty.Remove(Party.Get());
+		if (UTradeComponent* Trade = GetTradeComponent(Party.Get()))
+		{
+			Trade->ClientTradeClosed(bCompleted);
+		}
+	}
+
+	UnwatchUnstagedBags();
+}
+
+void UTradeSubsystem::GetBags(const APawn* Pawn, TArray<UBagComponent*>& OutBags)
+{
+	UInventoryRegistryComponent::GetBagsOf(Pawn, OutBags);
+}
+
+int32 UTradeSubsystem::CountFreeSlots(const APawn* Pawn)
+{
+	TArray<UBagComponent*> Bags;
+	GetBags(Pawn, Bags);
+
+	int32 FreeSlots = 0;
+	for (const UBagComponent* Bag : Bags)
+	{
+		FreeSlots += Bag->GetFreeSlotCount();
+	}
+	return FreeSlots;
+}
+
+int32 UTradeSubsystem::CountItem(const APawn* Pawn, FName ItemID)
+{
+	TArray<UBagComponent*> Bags;
+	GetBags(Pawn, Bags);
+
+	int32 Count = 0;
+	for (const UBagComponent* Bag : Bags)
+	{
+		Count += Bag->GetItemCount(ItemID);
+	}
+	return Count;
+}
+
+int32 UTradeSubsystem::SlotsNeeded(const FS_ItemInfo& Item, int32 Count)
+{
+	return Count > 0 ? FMath::DivideAndRoundUp(Count, Item.GetMaxStack()) : 0;
+}
+
+bool UTradeSubsystem::RemoveFromBags(const APawn* Pawn, FName ItemID, int32 Count)
+{
+	if (Count <= 0 || CountItem(Pawn, ItemID) < Count)
+	{
+		return Count == 0;
+	}
+
+	TArray<UBagComponent*> Bags;
+	GetBags(Pawn, Bags);
+	for (const UBagComponent* Bag : Bags)
+	{
+		// Bag totals skip bags without the item before touching any slot
+		for (int32 SlotIndex = 0; Count > 0 && Bag->GetItemCount(ItemID) > 0 && SlotIndex < Bag->GetInventorySlots().Num(); ++SlotIndex)
+		{
+			UInventorySlotDataComponent* Slot = Bag->GetInventorySlots()[SlotIndex];
+			if (Slot && !Slot->IsEmpty() && Slot->GetItemData().ItemID == ItemID)
+			{
+				const int32 Removed = FMath::Min(Count, Slot->GetStackCount());
+				Slot->RemoveItems(Removed);
+				Count -= Removed;
+			}
+		}
+	}
+	return Count == 0;
+}
+
+int32 UTradeSubsystem::AddToBags(const APawn* Pawn, const FS_ItemInfo& Item, int32 Count, FItemInstanceHandle Instance)
+{
+	TArray<UBagComponent*> Bags;
+	GetBags(Pawn, Bags);
+
+	for (UBagComponent* Bag : Bags)
+	{
+		if (Count <= 0)
+		{
+			break;
+		}
+
+		// A unique item keeps its instance, so it needs an empty slot to adopt it
+		if (Instance.IsValid())
+		{
+			for (UInventorySlotDataComponent* Slot : Bag->GetInventorySlots())
+			{
+				if (Slot && Slot->PutItems(Item, Count, Instance))
+				{
+					return 0;
+				}
+			}
+			continue;
+		}
+		Count = Bag->AddItem(Item, Count);
+	}
+	return Count;
+}
@@ -0,0 +1,179 @@
+// TradeWindowWidget.cpp
+#include "TradeWindowWidget.h"
+#include "TradeComponent.h"
+#include "InventorySlotWidget.h"
+#include "InventoryDragDropOperation.h"
+#include "InventoryRouterComponent.h"
+#include "InventoryWidgetPoolSubsystem.h"
+#include "ItemRegistrySubsystem.h"
+#include "Components/Button.h"
+#include "Components/PanelWidget.h"
+#include "Components/TextBlock.h"
+#include "GameFramework/PlayerController.h"
+#include "GameFramework/PlayerState.h"
+
+#define LOCTEXT_NAMESPACE "TradeWindow"
+
+UTradeWindowWidget::UTradeWindowWidget(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+}
+
+void UTradeWindowWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	if (AcceptButton)
+	{
+		AcceptButton->OnClicked.AddUniqueDynamic(this, &UTradeWindowWidget::HandleAcceptClicked);
+	}
+	if (CancelButton)
+	{
+		CancelButton->OnClicked.AddUniqueDynamic(this, &UTradeWindowWidget::HandleCancelClicked);
+	}
+}
+
+void UTradeWindowWidget::NativeDestruct()
+{
+	if (Trade.IsValid())
+	{
+		Trade->OnTradeUpdated.RemoveDynamic(this, &UTradeWindowWidget::HandleTradeUpdated);
+	}
+	ReleaseOfferWidgets(MyOfferWidgets);
+	ReleaseOfferWidgets(PartnerOfferWidgets);
+
+	Super::NativeDestruct();
+}
+
+void UTradeWindowWidget::BindToTrade(UTradeComponent* InTrade)
+{
+	if (Trade.IsValid())
+	{
+		Trade->OnTradeUpdated.RemoveDynamic(this, &UTradeWindowWidget::HandleTradeUpdated);
+	}
+
+	Trade = InTrade;
+	if (InTrade)
+	{
+		InTrade->OnTradeUpdated.AddUniqueDynamic(this, &UTradeWindowWidget::HandleTradeUpdated);
+		HandleTradeUpdated(InTrade->GetTradeState());
+	}
+}
+
+void UTradeWindowWidget::HandleTradeUpdated(const FTradeWindowState& State)
+{
+	FillOfferPanel(MyOfferPanel, MyOfferWidgets, State.MyOffer);
+	FillOfferPanel(PartnerOfferPanel, PartnerOfferWidgets, State.PartnerOffer);
+
+	if (PartnerNameText)
+	{
+		PartnerNameText->SetText(State.Partner ? FText::FromString(State.Partner->GetPlayerName()) : FText::GetEmpty());
+	}
+
+	if (StatusText)
+	{
+		if (State.bMyAccepted && State.bPartnerAccepted)
+		{
+			StatusText->SetText(LOCTEXT("Completing", "Completing trade..."));
+		}
+		else if (State.bPartnerAccepted)
+		{
+			StatusText->SetText(LOCTEXT("PartnerAccepted", "Partner accepted"));
+		}
+		else if (State.bMyAccepted)
+		{
+			StatusText->SetText(LOCTEXT("WaitingForPartner", "Waiting for partner"));
+		}
+		else
+		{
+			StatusText->SetText(FText::GetEmpty());
+		}
+	}
+}
+
+void UTradeWindowWidget::FillOfferPanel(UPanelWidget* Panel, TArray<TObjectPtr<UInventorySlotWidget>>& Widgets, const TArray<FTradeOfferItem>& Offer)
+{
+	if (!Panel)
+	{
+		return;
+	}
+
+	UInventoryWidgetPoolSubsystem* Pool = UInventoryWidgetPoolSubsystem::Get(GetOwningPlayer());
+	if (!Pool)
+	{
+		return;
+	}
+
+	// Offers are small, so a changed offer just redraws its panel from pooled widgets
+	while (Widgets.Num() > Offer.Num())
+	{
+		Pool->ReleaseSlotWidget(Widgets.Pop());
+	}
+	while (Widgets.Num() < Offer.Num())
+	{
+		UInventorySlotWidget* SlotWidget = Pool->AcquireSlotWidget(GetOwningPlayer());
+		if (!SlotWidget)
+		{
+			break;
+		}
+		Panel->AddChild(SlotWidget);
+		Widgets.Add(SlotWidget);
+	}
+
+	UItemRegistrySubsystem* Registry = UItemRegistrySubsystem::Get();
+	for (int32 OfferIndex = 0; OfferIndex < Widgets.Num(); ++OfferIndex)
+	{
+		if (const FItemRegistryEntry* Entry = Registry ? Registry->FindEntry(Offer[OfferIndex].ItemID) : nullptr)
+		{
+			Widgets[OfferIndex]->SetItemDetails(Entry->Info, Offer[OfferIndex].Count);
+		}
+		else
+		{
+			Widgets[OfferIndex]->ClearSlot();
+		}
+	}
+}
+
+void UTradeWindowWidget::ReleaseOfferWidgets(TArray<TObjectPtr<UInventorySlotWidget>>& Widgets)
+{
+	if (UInventoryWidgetPoolSubsystem* Pool = UInventoryWidgetPoolSubsystem::Get(GetOwningPlayer()))
+	{
+		for (UInventorySlotWidget* SlotWidget : Widgets)
+		{
+			Pool->ReleaseSlotWidget(SlotWidget);
+		}
+	}
+	Widgets.Reset();
+}
+
+bool UTradeWindowWidget::NativeOnDrop(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation)
+{
+	UInventoryDragDropOperation* InventoryDragDrop = Cast<UInventoryDragDropOperation>(InOperation);
+	APlayerController* PlayerController = GetOwningPlayer();
+	UInventoryRouterComponent* Router = PlayerController ? PlayerController->FindComponentByClass<UInventoryRouterComponent>() : nullptr;
+	if (!InventoryDragDrop || !Router)
+	{
+		return false;
+	}
+
+	Router->RouteDrop(InventoryDragDrop->Payload, FInventoryContainerHandle::ForKind(EInventoryContainerKind::Trade), INDEX_NONE);
+	return true;
+}
+
+void UTradeWindowWidget::HandleAcceptClicked()
+{
+	if (Trade.IsValid())
+	{
+		Trade->SetAccepted(!Trade->GetTradeState().bMyAccepted);
+	}
+}
+
+void UTradeWindowWidget::HandleCancelClicked()
+{
+	if (Trade.IsValid())
+	{
+		Trade->CancelTrade();
+	}
+}
+
+#undef LOCTEXT_NAMESPACE
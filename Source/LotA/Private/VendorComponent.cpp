@@ -0,0 +1,177 @@
+// VendorComponent.cpp
+#include "VendorComponent.h"
+#include "BagComponent.h"
+#include "InventoryAudit.h"
+#include "InventoryCommandSubsystem.h"
+#include "InventorySlotDataComponent.h"
+#include "ItemBase.h"
+#include "TradeSubsystem.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Net/UnrealNetwork.h"
+
+UVendorComponent::UVendorComponent()
+	: SellPriceScale(0.25f)
+	, InteractionRange(500.0f)
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void UVendorComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UVendorComponent, Stock);
+}
+
+void UVendorComponent::QueuePurchase(APlayerController* Player, int32 StockIndex, int32 Count)
+{
+	UInventoryCommandSubsystem* Commands = UInventoryCommandSubsystem::Get(this);
+	if (!Commands || !Player)
+	{
+		Purchase(Player ? Player->GetPawn() : nullptr, StockIndex, Count);
+		return;
+	}
+
+	// Checked when it runs, against the inventory as the commands before it left it
+	TWeakObjectPtr<UVendorComponent> WeakThis(this);
+	TWeakObjectPtr<APlayerController> WeakPlayer(Player);
+	Commands->EnqueueApply(Player, [WeakThis, WeakPlayer, StockIndex, Count]()
+	{
+		UVendorComponent* Vendor = WeakThis.Get();
+		const APlayerController* Buyer = WeakPlayer.Get();
+		if (Vendor && Buyer)
+		{
+			Vendor->Purchase(Buyer->GetPawn(), StockIndex, Count);
+		}
+	});
+}
+
+void UVendorComponent::QueueSell(APlayerController* Player, UBagComponent* Bag, int32 SlotIndex, int32 Count)
+{
+	UInventoryCommandSubsystem* Commands = UInventoryCommandSubsystem::Get(this);
+	if (!Commands || !Player)
+	{
+		Sell(Player ? Player->GetPawn() : nullptr, Bag, SlotIndex, Count);
+		return;
+	}
+
+	// The bag is held weakly while queued; one destroyed in the meantime fails validation
+	TWeakObjectPtr<UVendorComponent> WeakThis(this);
+	TWeakObjectPtr<APlayerController> WeakPlayer(Player);
+	TWeakObjectPtr<UBagComponent> WeakBag(Bag);
+	Commands->EnqueueApply(Player, [WeakThis, WeakPlayer, WeakBag, SlotIndex, Count]()
+	{
+		UVendorComponent* Vendor = WeakThis.Get();
+		const APlayerController* Seller = WeakPlayer.Get();
+		if (Vendor && Seller)
+		{
+			Vendor->Sell(Seller->GetPawn(), WeakBag.Get(), SlotIndex, Count);
+		}
+	});
+}
+
+bool UVendorComponent::Purchase(APawn* Buyer, int32 StockIndex, int32 Count)
+{
+	const FS_ItemInfo* Currency = GetCurrency();
+	if (GetOwnerRole() != ROLE_Authority || !Currency || !IsInRange(Buyer) || !Stock.IsValidIndex(StockIndex) || Count <= 0)
+	{
+		return false;
+	}
+
+	FVendorStockEntry& Entry = Stock[StockIndex];
+	if (!Entry.ItemClass || (Entry.Quantity >= 0 && Entry.Quantity < Count))
+	{
+		return false;
+	}
+
+	const FS_ItemInfo& Item = GetDefault<AItemBase>(Entry.ItemClass)->ItemDetails;
+	const int64 Cost = static_cast<int64>(Entry.Price) * Count;
+	if (Item.ItemID.IsNone() || Cost > MAX_int32 || UTradeSubsystem::CountItem(Buyer, Currency->ItemID) < Cost)
+	{
+		return false;
+	}
+
+	// Room is checked against empty slots alone, so the purchase can't half-fit
+	if (UTradeSubsystem::SlotsNeeded(Item, Count) > UTradeSubsystem::CountFreeSlots(Buyer))
+	{
+		return false;
+	}
+
+	FInventoryAuditScope AuditScope(EInventoryAuditOp::Trade);
+	UTradeSubsystem::RemoveFromBags(Buyer, Currency->ItemID, static_cast<int32>(Cost));
+	const int32 Leftover = UTradeSubsystem::AddToBags(Buyer, Item, Count);
+	ensureMsgf(Leftover == 0, TEXT("Vendor purchase didn't fit after its capacity check"));
+
+	if (Entry.Quantity >= 0)
+	{
+		Entry.Quantity -= Count;
+		OnStockChanged.Broadcast(this);
+	}
+	return true;
+}
+
+bool UVendorComponent::Sell(APawn* Seller, UBagComponent* Bag, int32 SlotIndex, int32 Count)
+{
+	const FS_ItemInfo* Currency = GetCurrency();
+	if (GetOwnerRole() != ROLE_Authority || !Currency || !IsInRange(Seller) || !Bag || Bag->GetOwner() != Seller || Count <= 0)
+	{
+		return false;
+	}
+
+	const TArray<UInventorySlotDataComponent*>& Slots = Bag->GetInventorySlots();
+	UInventorySlotDataComponent* Slot = Slots.IsValidIndex(SlotIndex) ? Slots[SlotIndex] : nullptr;
+	if (!Slot || Slot->IsEmpty() || Slot->GetStackCount() < Count)
+	{
+		return false;
+	}
+
+	const FName ItemID = Slot->GetItemData().ItemID;
+	FVendorStockEntry* Entry = Stock.FindByPredicate([ItemID](const FVendorStockEntry& Candidate)
+	{
+		return Candidate.ItemClass && GetDefault<AItemBase>(Candidate.ItemClass)->ItemDetails.ItemID == ItemID;
+	});
+
+	const int32 UnitPrice = Entry ? FMath::FloorToInt(Entry->Price * SellPriceScale) : 0;
+	const int64 Payment = static_cast<int64>(UnitPrice) * Count;
+	if (Payment <= 0 || Payment > MAX_int32)
+	{
+		return false;
+	}
+
+	// Selling a whole stack frees its slot for the payment
+	const int32 FreeSlots = UTradeSubsystem::CountFreeSlots(Seller) + (Count == Slot->GetStackCount() ? 1 : 0);
+	if (UTradeSubsystem::SlotsNeeded(*Currency, static_cast<int32>(Payment)) > FreeSlots)
+	{
+		return false;
+	}
+
+	FInventoryAuditScope AuditScope(EInventoryAuditOp::Trade);
+	Slot->RemoveItems(Count);
+	const int32 Leftover = UTradeSubsystem::AddToBags(Seller, *Currency, static_cast<int32>(Payment));
+	ensureMsgf(Leftover == 0, TEXT("Vendor payment didn't fit after its capacity check"));
+
+	if (Entry->Quantity >= 0)
+	{
+		Entry->Quantity += Count;
+		OnStockChanged.Broadcast(this);
+	}
+	return true;
+}
+
+bool UVendorComponent::IsInRange(const APawn* Pawn) const
+{
+	return Pawn && GetOwner() && FVector::DistSquared(Pawn->GetActorLocation(), GetOwner()->GetActorLocation()) <= FMath::Square(InteractionRange);
+}
+
+void UVendorComponent::OnRep_Stock()
+{
+	OnStockChanged.Broadcast(this);
+}
+
+const FS_ItemInfo* UVendorComponent::GetCurrency() const
+{
+	const FS_ItemInfo* Currency = CurrencyClass ? &GetDefault<AItemBase>(CurrencyClass)->ItemDetails : nullptr;
+	return Currency && !Currency->ItemID.IsNone() ? Currency : nullptr;
+}
@@ -0,0 +1,84 @@
+// WindowLayoutSubsystem.cpp
+#include "WindowLayoutSubsystem.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+#include "Misc/ConfigCacheIni.h"
+
+UWindowLayoutSubsystem* UWindowLayoutSubsystem::Get(const APlayerController* PlayerController)
+{
+	const ULocalPlayer* LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+	return LocalPlayer ? LocalPlayer->GetSubsystem<UWindowLayoutSubsystem>() : nullptr;
+}
+
+void UWindowLayoutSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const ULocalPlayer* LocalPlayer = GetLocalPlayer();
+	ConfigSection = FString::Printf(TEXT("WindowLayout.Player%d"), LocalPlayer ? LocalPlayer->GetLocalPlayerIndex() : 0);
+
+	const FConfigSection* Section = GConfig ? GConfig->GetSection(*ConfigSection, false, GGameUserSettingsIni) : nullptr;
+	if (!Section)
+	{
+		return;
+	}
+
+	for (const TPair<FName, FConfigValue>& Entry : *Section)
+	{
+		FString XString;
+		FString YString;
+		if (Entry.Value.GetValue().Split(TEXT(","), &XString, &YString))
+		{
+			Positions.Add(Entry.Key, FIntPoint(FCString::Atoi(*XString), FCString::Atoi(*YString)));
+		}
+	}
+}
+
+void UWindowLayoutSubsystem::Deinitialize()
+{
+	SaveLayout();
+
+	Super::Deinitialize();
+}
+
+bool UWindowLayoutSubsystem::FindWindowPosition(FName WindowKey, FVector2D& OutPosition) const
+{
+	if (const FIntPoint* Position = Positions.Find(WindowKey))
+	{
+		OutPosition = FVector2D(Position->X, Position->Y);
+		return true;
+	}
+	return false;
+}
+
+void UWindowLayoutSubsystem::SetWindowPosition(FName WindowKey, const FVector2D& Position)
+{
+	if (WindowKey.IsNone())
+	{
+		return;
+	}
+
+	const FIntPoint Rounded(FMath::RoundToInt(Position.X), FMath::RoundToInt(Position.Y));
+	FIntPoint& Stored = Positions.FindOrAdd(WindowKey, FIntPoint(INT32_MIN, INT32_MIN));
+	if (Stored != Rounded)
+	{
+		Stored = Rounded;
+		bDirty = true;
+	}
+}
+
+void UWindowLayoutSubsystem::SaveLayout()
+{
+	if (!bDirty || !GConfig)
+	{
+		return;
+	}
+
+	GConfig->EmptySection(*ConfigSection, GGameUserSettingsIni);
+	for (const TPair<FName, FIntPoint>& Entry : Positions)
+	{
+		GConfig->SetString(*ConfigSection, *Entry.Key.ToString(), *FString::Printf(TEXT("%d,%d"), Entry.Value.X, Entry.Value.Y), GGameUserSettingsIni);
+	}
+	GConfig->Flush(false, GGameUserSettingsIni);
+	bDirty = false;
+}
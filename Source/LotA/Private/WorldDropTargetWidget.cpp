@@ -0,0 +1,21 @@
+// WorldDropTargetWidget.cpp
+#include "WorldDropTargetWidget.h"
+#include "InventoryDragDropOperation.h"
+#include "InventoryRouterComponent.h"
+#include "GameFramework/PlayerController.h"
+
+bool UWorldDropTargetWidget::NativeOnDrop(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation)
+{
+	const UInventoryDragDropOperation* InventoryDragDrop = Cast<UInventoryDragDropOperation>(InOperation);
+	if (!InventoryDragDrop)
+	{
+		return Super::NativeOnDrop(InGeometry, InDragDropEvent, InOperation);
+	}
+
+	const APlayerController* OwningPlayer = GetOwningPlayer();
+	if (UInventoryRouterComponent* Router = OwningPlayer ? OwningPlayer->FindComponentByClass<UInventoryRouterComponent>() : nullptr)
+	{
+		Router->RouteDrop(InventoryDragDrop->Payload, FInventoryContainerHandle::ForKind(EInventoryContainerKind::World), INDEX_NONE);
+	}
+	return true;
+}
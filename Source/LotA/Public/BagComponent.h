@@ -5,11 +5,26 @@
 #include "Components/ActorComponent.h"
 #include "S_ItemInfo.h"
 #include "InventorySlotDataComponent.h"
+#include "InventorySnapshot.h"
+#include "InventoryNetTypes.h"
+#include "InventoryStore.h"
 #include "BagComponent.generated.h"
 
+class UInventoryStoreSubsystem;
+
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBagOpened, UBagComponent*, Bag);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnBagClosed, UBagComponent*, Bag);
 
+// Native change events; cheap enough to fire on every slot mutation
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnBagSlotChanged, UBagComponent* /*Bag*/, int32 /*SlotIndex*/);
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnBagItemCountChanged, UBagComponent* /*Bag*/, FName /*ItemID*/, int32 /*Delta*/);
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnBagWeightChanged, UBagComponent* /*Bag*/, float /*NewTotalWeight*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBagResized, UBagComponent* /*Bag*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnBagLifetimeEvent, UBagComponent* /*Bag*/);
+
+// A bag's contents are an inventory in the world's UInventoryStoreSubsystem, on the server and on the
+// owning client alike. The slot components are views of it that exist for replication, the widgets
+// and callers working slot by slot; counts, free slots and snapshots are read from the store.
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class LOTA_API UBagComponent : public UActorComponent
 {
@@ -33,7 +48,7 @@ public:
     UFUNCTION(BlueprintPure, Category = "Bag")
     bool HasItems() const;
 
-    // Calculate total weight including contents
+    // Total weight including contents, from the cached contents weight
     UFUNCTION(BlueprintPure, Category = "Bag")
     float GetTotalWeight() const;
 
@@ -41,9 +56,27 @@ public:
     UFUNCTION(BlueprintPure, Category = "Bag")
     float GetWeightReduction() const { return BagInfo.WeightReductionPercentage; }
 
-    // Set bag data
+    // Set bag data. Re-initializing an existing bag resizes it in place, keeping the contents of
+    // surviving slots; returns false if the overflow from a shrink doesn't fit in the owner's other bags.
     UFUNCTION(BlueprintCallable, Category = "Bag")
-    void InitializeBag(const FS_ItemInfo& BagItemInfo);
+    bool InitializeBag(const FS_ItemInfo& BagItemInfo);
+
+    // Grow or shrink the slot array in place (authority only). Items in removed slots move into the
+    // surviving slots or the owner's other bags; nothing changes if they don't all fit.
+    UFUNCTION(BlueprintCallable, Category = "Bag")
+    bool ResizeBag(int32 NewSlotCount);
+
+    // Add items, topping up existing stacks before using empty slots (authority only).
+    // Returns how many didn't fit.
+    UFUNCTION(BlueprintCallable, Category = "Bag")
+    int32 AddItem(const FS_ItemInfo& Item, int32 Count);
+
+    // Number of empty slots, from the store's occupied count
+    UFUNCTION(BlueprintPure, Category = "Bag")
+    int32 GetFreeSlotCount() const;
+
+    // The item this bag was initialized from
+    const FS_ItemInfo& GetBagInfo() const { return BagInfo; }
 
     // Get number of bag slots
     UFUNCTION(BlueprintPure, Category = "Bag")
@@ -56,11 +89,41 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Bag")
     FOnBagClosed OnBagClosed;
 
+    // Fired when a slot's item or count changes, on the server and the owning client
+    FOnBagSlotChanged OnSlotChanged;
+
+    // Fired with the change in total count of an item in this bag
+    FOnBagItemCountChanged OnItemCountChanged;
+
+    // Fired when the number of slots changes
+    FOnBagResized OnResized;
+
+    // Fired with the new GetTotalWeight() whenever contents or the bag item change
+    FOnBagWeightChanged OnWeightChanged;
+
+    // Total count of an item in this bag, summed over the store's count column
+    UFUNCTION(BlueprintPure, Category = "Bag")
+    int32 GetItemCount(FName ItemID) const;
+
+    // Contents of one slot in the store; empty for out of range indices
+    FInventoryStoreSlot ReadSlot(int32 SlotIndex) const;
+
+    // Overwrite one slot in the store and report the change. Slot views write through this.
+    void WriteSlot(int32 SlotIndex, const FInventoryStoreSlot& Contents);
+
+    // This bag's inventory in the world's UInventoryStoreSubsystem
+    FInventoryEntityHandle GetStoreHandle() const { return StoreHandle; }
+
     // Get bag inventory slots
     UFUNCTION(BlueprintPure, Category = "Bag")
     const TArray<UInventorySlotDataComponent*>& GetInventorySlots() const { return InventorySlots; }
 
+    // Immutable copy of the contents. The same copy is returned until the bag changes.
+    FInventoryContainerSnapshotRef GetSnapshot() const;
+
 protected:
+    virtual void OnRegister() override;
+    virtual void OnUnregister() override;
     virtual void BeginPlay() override;
     virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
@@ -69,14 +132,34 @@ private:
     UPROPERTY(ReplicatedUsing = OnRep_IsOpen)
     bool bIsOpen;
 
-    // Bag item information
-    UPROPERTY(Replicated)
+    // Bag item information. Clients rebuild it from BagItem and their item registry.
     FS_ItemInfo BagInfo;
 
-    // Array of inventory slots in the bag
-    UPROPERTY()
+    // What replicates of BagInfo: the item reference, plus the full definition only for bags
+    // outside the cooked table
+    UPROPERTY(ReplicatedUsing = OnRep_BagInfo)
+    FItemNetReference BagItem;
+
+    UPROPERTY(ReplicatedUsing = OnRep_BagInfo)
+    FS_ItemInfo UncookedBagInfo;
+
+    // Views of the store inventory's slots, one per slot
+    UPROPERTY(ReplicatedUsing = OnRep_InventorySlots)
     TArray<UInventorySlotDataComponent*> InventorySlots;
 
+    // Where the contents live; invalid until the bag has slots
+    FInventoryEntityHandle StoreHandle;
+
+    UPROPERTY(Transient)
+    TObjectPtr<UInventoryStoreSubsystem> StoreSubsystem;
+
+    // Unreduced weight of the contents, maintained from slot writes
+    double ContentsWeight;
+
+    // Bumped on every change to slots or bag data, so GetSnapshot knows when its copy is stale
+    uint64 SnapshotRevision;
+    mutable TSharedPtr<const FInventoryContainerSnapshot, ESPMode::ThreadSafe> CachedSnapshot;
+
     // Reference to the UI widget
     UPROPERTY()
     class UWidget* BagWidget;
@@ -85,6 +168,28 @@ private:
     UFUNCTION()
     void OnRep_IsOpen();
 
-    // Initialize inventory slots
-    void CreateInventorySlots();
+    UFUNCTION()
+    void OnRep_InventorySlots();
+
+    UFUNCTION()
+    void OnRep_BagInfo();
+
+    // Match InventorySlots to SlotCount, reusing pooled slot components
+    bool ResizeSlots(int32 SlotCount);
+
+    // Move the contents of slots at and after FirstRemovedIndex somewhere else; all or nothing
+    bool RelocateOverflow(int32 FirstRemovedIndex);
+
+    // Release every slot back to the pool and free the store inventory
+    void ReleaseAllSlots();
+
+    // Create or resize the store inventory to NumSlots. Slots that are cut off are emptied first,
+    // since a replicated resize can arrive before their contents do.
+    void SyncStoreSize(int32 NumSlots);
+
+    // Report a slot write: item counts, audit, weight and events
+    void HandleSlotChanged(int32 SlotIndex, const FInventoryStoreSlot& OldContents, const FInventoryStoreSlot& NewContents);
+
+    // Greedy placement shared by AddItem and overflow relocation: existing stacks first, then empty slots
+    static int32 AddItemToSlots(TArrayView<UInventorySlotDataComponent* const> Slots, const FS_ItemInfo& Item, int32 Count);
 };
\ No newline at end of file
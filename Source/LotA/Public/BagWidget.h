@@ -2,10 +2,16 @@
 
 #include "CoreMinimal.h"
 #include "DraggableWindowBase.h"
+#include "ItemFilter.h"
 #include "BagWidget.generated.h"
 
-class UUniformGridPanel;  // Changed from UInventoryWidget
+class UUniformGridPanel;
+class UTextBlock;
+class UBagComponent;
+class UInventorySlotWidget;
 
+// Window showing the contents of one bag. Slot widgets come from the player's shared pool and
+// are redrawn individually as the bag reports slot changes; the pool's item filter dims them.
 UCLASS()
 class LOTA_API UBagWidget : public UDraggableWindowBase
 {
@@ -14,12 +20,44 @@ class LOTA_API UBagWidget : public UDraggableWindowBase
 public:
 	UBagWidget(const FObjectInitializer& ObjectInitializer);
 
+	// Show Bag in this window, laid out InColumns wide. Passing null releases all slots.
 	UFUNCTION(BlueprintCallable, Category = "Bag")
-	void InitializeBag(int32 Rows, int32 Columns);
+	void BindToBag(UBagComponent* Bag, int32 InColumns);
+
+	UFUNCTION(BlueprintPure, Category = "Bag")
+	UBagComponent* GetBag() const { return BoundBag.Get(); }
 
 protected:
-	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 
 	UPROPERTY(meta = (BindWidget))
-	UUniformGridPanel* InventoryGrid;  // Changed to match your blueprint
-};
\ No newline at end of file
+	UUniformGridPanel* InventoryGrid;
+
+	// Shows the bag's name when present
+	UPROPERTY(meta = (BindWidgetOptional))
+	UTextBlock* TitleText;
+
+	// Slots per row
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Bag", meta = (ClampMin = "1"))
+	int32 Columns;
+
+	// Opacity for slots that don't match the player's item filter
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Bag", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float FilteredOutOpacity;
+
+	// One widget per bag slot, in slot order
+	UPROPERTY()
+	TArray<UInventorySlotWidget*> SlotWidgets;
+
+private:
+	TWeakObjectPtr<UBagComponent> BoundBag;
+
+	void RebuildSlots();
+	void ReleaseSlots();
+	void RefreshSlot(int32 SlotIndex);
+	void UnbindFromBag();
+
+	void HandleSlotChanged(UBagComponent* Bag, int32 SlotIndex);
+	void HandleBagResized(UBagComponent* Bag);
+	void HandleFilterChanged(EItemFilterChange Change);
+};
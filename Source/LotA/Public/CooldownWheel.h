@@ -0,0 +1,50 @@
+// CooldownWheel.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Hashed timer wheel for one player's cooldown groups. All groups share a single fixed-rate
+// tick, so a player with ten cooldowns running still costs one timer. Ready times live in a
+// map for O(1) queries; the wheel only exists to report expiry.
+struct LOTA_API FCooldownWheel
+{
+	static constexpr int32 NumBuckets = 64;
+	static constexpr float TickInterval = 0.25f;
+
+	// Start (or restart) a group's cooldown. Returns the time it will be ready.
+	double Start(FName Group, float Duration, double Now);
+
+	// Whether the group is still cooling down at Now
+	bool IsActive(FName Group, double Now) const;
+
+	// Seconds left on a group, 0 if ready
+	float GetRemaining(FName Group, double Now) const;
+
+	// Advance one bucket and call OnExpired for each group that just became ready
+	void Tick(double Now, TFunctionRef<void(FName)> OnExpired);
+
+	// Whether anything is scheduled, i.e. whether the owner's tick timer needs to run
+	bool HasPending() const { return NumPending > 0; }
+
+	void Reset();
+
+private:
+	struct FEntry
+	{
+		FName Group;
+
+		// Ready time the entry was scheduled for; a restart leaves an entry whose time no longer matches
+		double ReadyTime;
+
+		// Full turns of the wheel left before the entry is due
+		int32 Rounds;
+	};
+
+	// Put an entry in the bucket Delay seconds from the current one, at least one tick ahead
+	void Schedule(FName Group, double ReadyTime, double Delay);
+
+	TArray<FEntry> Buckets[NumBuckets];
+	TMap<FName, double> ReadyTimes;
+	int32 CurrentBucket = 0;
+	int32 NumPending = 0;
+};
@@ -19,15 +19,28 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "DragDrop Visual")
 	void SetItemIcon(UTexture2D* Icon);
 
+	UFUNCTION(BlueprintCallable, Category = "DragDrop Visual")
+	void SetIconBrush(const FSlateBrush& Brush);
+
+	// Show a registry entry's icon from the icon atlas, pinned until the visual is destroyed
+	void SetAtlasIcon(int32 RegistryIndex);
+
 	UFUNCTION(BlueprintCallable, Category = "DragDrop Visual")
 	void SetQuantityText(int32 Quantity);
 
 protected:
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 
 	UPROPERTY(meta = (BindWidget))
 	UImage* ItemIcon;
 
 	UPROPERTY(meta = (BindWidget))
 	UTextBlock* QuantityText;
+
+private:
+	int32 IconAtlasCell = INDEX_NONE;
+
+	void ApplyAtlasBrush();
+	void ReleaseIconCell();
 };
\ No newline at end of file
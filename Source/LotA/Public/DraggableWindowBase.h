@@ -4,6 +4,12 @@
 #include "Blueprint/UserWidget.h"
 #include "DraggableWindowBase.generated.h"
 
+class UDraggableWindowBase;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnWindowMoved, UDraggableWindowBase* /*Window*/, const FVector2D& /*NewPosition*/);
+
+// Window that the player moves by dragging its title bar. Dragging captures the mouse and only
+// rewrites the window's slot position, so the cost is the same however much the window contains.
 UCLASS()
 class LOTA_API UDraggableWindowBase : public UUserWidget
 {
@@ -12,11 +18,50 @@ class LOTA_API UDraggableWindowBase : public UUserWidget
 public:
 	UDraggableWindowBase(const FObjectInitializer& ObjectInitializer);
 
-protected:
-	virtual void NativeConstruct() override;
+	// Move the window, in slate units relative to the viewport (or its canvas panel)
+	UFUNCTION(BlueprintCallable, Category = "Window")
+	void SetWindowPosition(FVector2D NewPosition);
+
+	UFUNCTION(BlueprintPure, Category = "Window")
+	FVector2D GetWindowPosition() const { return WindowPosition; }
 
-	// Handles dragging of the window
+	// Name the window is saved under in the player's window layout. Windows without one aren't saved.
+	void SetLayoutKey(FName InLayoutKey) { LayoutKey = InLayoutKey; }
+	FName GetLayoutKey() const { return LayoutKey; }
+
+	// Fired once when a drag ends at a new position
+	FOnWindowMoved OnWindowMoved;
+
+protected:
 	virtual FReply NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
-	virtual void NativeOnDragDetected(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent, UDragDropOperation*& OutOperation) override;
-};
+	virtual FReply NativeOnMouseMove(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+	virtual FReply NativeOnMouseButtonUp(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+	virtual void NativeOnMouseCaptureLost(const FCaptureLostEvent& CaptureLostEvent) override;
 
+	// Items released over the window's chrome stay where they were instead of falling through to whatever is behind
+	virtual bool NativeOnDrop(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation) override;
+
+	// Area that starts a drag. Without one the whole window background does.
+	UPROPERTY(meta = (BindWidgetOptional))
+	UWidget* TitleBar;
+
+	// Positions are rounded to this grid while dragging; 0 disables it
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Window", meta = (ClampMin = "0.0"))
+	float SnapGridSize;
+
+	// Windows closer than this to a viewport edge stick to it
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Window", meta = (ClampMin = "0.0"))
+	float EdgeSnapDistance;
+
+private:
+	FVector2D WindowPosition;
+	FName LayoutKey;
+
+	// Drag state: where the window and the cursor were when the drag started
+	bool bIsDraggingWindow;
+	FVector2D DragStartWindowPosition;
+	FVector2D DragStartCursor;
+
+	FVector2D SnapAndClamp(const FVector2D& Position) const;
+	void EndWindowDrag();
+};
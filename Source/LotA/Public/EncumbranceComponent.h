@@ -0,0 +1,107 @@
+// EncumbranceComponent.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "EncumbranceComponent.generated.h"
+
+class AController;
+class APawn;
+class UBagComponent;
+class UInventoryRegistryComponent;
+class UCharacterMovementComponent;
+
+// Movement penalties that apply from a carried weight upwards
+USTRUCT(BlueprintType)
+struct LOTA_API FEncumbranceTier
+{
+	GENERATED_BODY()
+
+	// Tier applies once carried weight reaches this value
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Encumbrance", meta = (ClampMin = "0.0"))
+	float MinWeight = 0.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Encumbrance", meta = (ClampMin = "0.0"))
+	float WalkSpeedScale = 1.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Encumbrance", meta = (ClampMin = "0.0"))
+	float JumpVelocityScale = 1.0f;
+
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Encumbrance", meta = (ClampMin = "0.0"))
+	float StaminaDrainScale = 1.0f;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEncumbranceChanged, int32, NewTier);
+
+// Turns the weight of the owner's bags into movement modifiers. The server sums bag weights from
+// their weight-change events and replicates only the resulting tier index, so client and server
+// apply identical CharacterMovement values without either one re-summing the inventory.
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class LOTA_API UEncumbranceComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UEncumbranceComponent();
+
+	UFUNCTION(BlueprintPure, Category = "Encumbrance")
+	float GetCarriedWeight() const { return CarriedWeight; }
+
+	UFUNCTION(BlueprintPure, Category = "Encumbrance")
+	int32 GetTier() const { return EncumbranceTier; }
+
+	// Multiplier for a stamina system to apply to its drain rate
+	UFUNCTION(BlueprintPure, Category = "Encumbrance")
+	float GetStaminaDrainScale() const { return GetActiveTier().StaminaDrainScale; }
+
+	UPROPERTY(BlueprintAssignable, Category = "Encumbrance")
+	FOnEncumbranceChanged OnEncumbranceChanged;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	// Tiers sorted by MinWeight; the highest one reached applies
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Encumbrance")
+	TArray<FEncumbranceTier> Tiers;
+
+private:
+	// Index into Tiers, the only thing that goes over the wire
+	UPROPERTY(ReplicatedUsing = OnRep_EncumbranceTier)
+	uint8 EncumbranceTier;
+
+	// Server-side running total of all tracked bags
+	float CarriedWeight;
+
+	// Last reported weight per bag, so each event is applied as a delta
+	TMap<TWeakObjectPtr<UBagComponent>, float> BagWeights;
+
+	// Movement values before any penalty, captured at BeginPlay so Blueprint tuning is respected
+	float BaseMaxWalkSpeed;
+	float BaseJumpZVelocity;
+
+	// Registry of the controller possessing the owner, which reports bags added and removed
+	TWeakObjectPtr<UInventoryRegistryComponent> Registry;
+	FDelegateHandle BagRegisteredHandle;
+	FDelegateHandle BagUnregisteredHandle;
+
+	UFUNCTION()
+	void OnRep_EncumbranceTier();
+
+	UFUNCTION()
+	void HandleControllerChanged(APawn* Pawn, AController* OldController, AController* NewController);
+
+	// Follow a new registry. Bags already tracked stay tracked, so an unpossessed pawn keeps its tier.
+	void BindRegistry(UInventoryRegistryComponent* NewRegistry);
+
+	void HandleBagRegistered(UBagComponent* Bag);
+	void HandleBagUnregistered(UBagComponent* Bag);
+	void HandleBagWeightChanged(UBagComponent* Bag, float NewWeight);
+
+	void TrackBag(UBagComponent* Bag);
+	void UpdateTier();
+	void ApplyMovementModifiers();
+
+	const FEncumbranceTier& GetActiveTier() const;
+	UCharacterMovementComponent* GetMovementComponent() const;
+};
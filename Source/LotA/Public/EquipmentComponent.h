@@ -0,0 +1,133 @@
+// EquipmentComponent.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "S_ItemInfo.h"
+#include "ItemInstance.h"
+#include "InventorySnapshot.h"
+#include "EquipmentComponent.generated.h"
+
+class UBagComponent;
+
+// What other players need to draw an equipped item. Replicated to everyone, unlike the full item data.
+USTRUCT(BlueprintType)
+struct LOTA_API FEquippedVisual
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Equipment")
+	EEquipmentSlot Slot = EEquipmentSlot::None;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Equipment")
+	FName ItemID;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnEquipmentChanged, UEquipmentComponent*, Equipment, EEquipmentSlot, Slot);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnEquippedVisualsChanged, UEquipmentComponent*, Equipment);
+
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class LOTA_API UEquipmentComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UEquipmentComponent();
+
+	static constexpr int32 NumSlots = static_cast<int32>(EEquipmentSlot::MAX);
+
+	static bool IsBagSlot(EEquipmentSlot Slot) { return Slot >= EEquipmentSlot::Bag1 && Slot <= EEquipmentSlot::Bag4; }
+
+	// Whether an item may go into the given slot
+	UFUNCTION(BlueprintPure, Category = "Equipment")
+	static bool CanEquipInSlot(const FS_ItemInfo& Item, EEquipmentSlot Slot);
+
+	// Equip an item (authority only). Whatever was in the slot is returned through OutPrevious.
+	UFUNCTION(BlueprintCallable, Category = "Equipment")
+	bool EquipItem(const FS_ItemInfo& Item, EEquipmentSlot Slot, FS_ItemInfo& OutPrevious);
+
+	// Remove the item in a slot (authority only). Bags must be empty to be unequipped.
+	UFUNCTION(BlueprintCallable, Category = "Equipment")
+	bool UnequipSlot(EEquipmentSlot Slot, FS_ItemInfo& OutRemoved);
+
+	// Native versions of EquipItem/UnequipSlot for items moving between containers: the unique
+	// item's instance is passed along instead of being created or destroyed here
+	bool EquipInstance(const FS_ItemInfo& Item, FItemInstanceHandle Instance, EEquipmentSlot Slot, FS_ItemInfo& OutPrevious, FItemInstanceHandle& OutPreviousInstance);
+	bool UnequipInstance(EEquipmentSlot Slot, FS_ItemInfo& OutRemoved, FItemInstanceHandle& OutInstance);
+
+	UFUNCTION(BlueprintPure, Category = "Equipment")
+	const FS_ItemInfo& GetEquippedItem(EEquipmentSlot Slot) const;
+
+	FItemInstanceHandle GetEquippedInstance(EEquipmentSlot Slot) const;
+
+	// Immutable copy of the equipped items, one slot per EEquipmentSlot. Reused until something changes.
+	FInventoryContainerSnapshotRef GetSnapshot() const;
+
+	UFUNCTION(BlueprintPure, Category = "Equipment")
+	bool IsSlotOccupied(EEquipmentSlot Slot) const { return !GetEquippedItem(Slot).ItemID.IsNone(); }
+
+	// Bag component created for an equipped bag, null if the slot holds no bag
+	UFUNCTION(BlueprintPure, Category = "Equipment")
+	UBagComponent* GetBagInSlot(EEquipmentSlot Slot) const;
+
+	// Cached totals of all equipped stats. Combat code should read this rather than walking items.
+	UFUNCTION(BlueprintPure, Category = "Equipment")
+	const FItemStats& GetStatTotals() const { return StatTotals; }
+
+	// Visible equipment for cosmetic systems, replicated to all clients
+	UFUNCTION(BlueprintPure, Category = "Equipment")
+	const TArray<FEquippedVisual>& GetEquippedVisuals() const { return EquippedVisuals; }
+
+	UPROPERTY(BlueprintAssignable, Category = "Equipment")
+	FOnEquipmentChanged OnEquipmentChanged;
+
+	UPROPERTY(BlueprintAssignable, Category = "Equipment")
+	FOnEquippedVisualsChanged OnEquippedVisualsChanged;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	// Full item data per slot, indexed by EEquipmentSlot. Only the owning client needs it.
+	UPROPERTY(ReplicatedUsing = OnRep_EquippedItems)
+	TArray<FS_ItemInfo> EquippedItems;
+
+	// Instances of unique equipped items, indexed by EEquipmentSlot
+	UPROPERTY(Replicated)
+	TArray<FItemInstanceHandle> EquippedInstances;
+
+	// Cosmetic view of EquippedItems, kept in slot order
+	UPROPERTY(ReplicatedUsing = OnRep_EquippedVisuals)
+	TArray<FEquippedVisual> EquippedVisuals;
+
+	// Definition stats plus each unique item's rolled stats; each equip/unequip subtracts the old
+	// slot's stats and adds the new one's
+	UPROPERTY(Replicated)
+	FItemStats StatTotals;
+
+	// Bag components for the bag slots, indexed by EEquipmentSlot
+	UPROPERTY(Replicated)
+	TArray<UBagComponent*> EquippedBags;
+
+	UFUNCTION()
+	void OnRep_EquippedItems();
+
+	UFUNCTION()
+	void OnRep_EquippedVisuals();
+
+	void CreateBagForSlot(EEquipmentSlot Slot, const FS_ItemInfo& BagItem);
+	bool DestroyBagForSlot(EEquipmentSlot Slot);
+	void SetVisual(EEquipmentSlot Slot, FName ItemID);
+
+	// Definition plus rolled stats of what Index holds
+	FItemStats GetSlotStats(int32 Index) const;
+
+	void ReleaseInstance(FItemInstanceHandle Instance);
+
+	uint64 SnapshotRevision;
+	mutable TSharedPtr<const FInventoryContainerSnapshot, ESPMode::ThreadSafe> CachedSnapshot;
+
+	// Server-side changes only; every caller is already authority-gated
+	void AuditChange(EEquipmentSlot Slot, FName ItemID, int32 Delta);
+};
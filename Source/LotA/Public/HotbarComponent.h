@@ -0,0 +1,78 @@
+// HotbarComponent.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "HotbarComponent.generated.h"
+
+class UBagComponent;
+class UInventoryRegistryComponent;
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnHotbarSlotChanged, int32 /*SlotIndex*/);
+
+// Action bar bound to item IDs rather than bag slots. Lives on the player controller and keeps a
+// running total for each bound item from the bags' count-change events, so nothing polls the inventory.
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class LOTA_API UHotbarComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UHotbarComponent();
+
+	UFUNCTION(BlueprintCallable, Category = "Hotbar")
+	void BindItem(int32 SlotIndex, FName ItemID);
+
+	UFUNCTION(BlueprintCallable, Category = "Hotbar")
+	void ClearSlot(int32 SlotIndex) { BindItem(SlotIndex, NAME_None); }
+
+	// Use whatever is bound to the slot
+	UFUNCTION(BlueprintCallable, Category = "Hotbar")
+	void ActivateSlot(int32 SlotIndex);
+
+	UFUNCTION(BlueprintPure, Category = "Hotbar")
+	FName GetSlotItemID(int32 SlotIndex) const { return SlotItems.IsValidIndex(SlotIndex) ? SlotItems[SlotIndex] : NAME_None; }
+
+	// Total count of the bound item across all of the pawn's bags
+	UFUNCTION(BlueprintPure, Category = "Hotbar")
+	int32 GetSlotCount(int32 SlotIndex) const;
+
+	UFUNCTION(BlueprintPure, Category = "Hotbar")
+	int32 GetNumSlots() const { return SlotItems.Num(); }
+
+	// Fired only for slots whose binding or count changed
+	FOnHotbarSlotChanged OnSlotChanged;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	UPROPERTY(EditDefaultsOnly, Category = "Hotbar", meta = (ClampMin = "1"))
+	int32 NumSlots;
+
+private:
+	// Item bound to each slot
+	UPROPERTY()
+	TArray<FName> SlotItems;
+
+	// Running totals for bound items only
+	TMap<FName, int32> BoundTotals;
+
+	// The owner's registry; it reports bag changes, including when the pawn changes
+	TWeakObjectPtr<UInventoryRegistryComponent> Registry;
+	TArray<TWeakObjectPtr<UBagComponent>> TrackedBags;
+
+	FDelegateHandle BagRegisteredHandle;
+	FDelegateHandle BagUnregisteredHandle;
+
+	void HandleBagRegistered(UBagComponent* Bag);
+	void HandleBagUnregistered(UBagComponent* Bag);
+	void HandleItemCountChanged(UBagComponent* Bag, FName ItemID, int32 Delta);
+
+	void TrackBag(UBagComponent* Bag);
+	void UntrackBag(UBagComponent* Bag);
+	void UntrackAllBags();
+
+	// Add Delta to a bound item's total and notify the slots showing it
+	void ApplyDelta(FName ItemID, int32 Delta);
+};
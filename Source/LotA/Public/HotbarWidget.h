@@ -0,0 +1,39 @@
+// HotbarWidget.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "HotbarWidget.generated.h"
+
+class UPanelWidget;
+class UInventorySlotWidget;
+class UHotbarComponent;
+
+// Row of hotbar buttons. Each button is an inventory slot widget, redrawn only when the
+// hotbar reports that its binding or count changed.
+UCLASS()
+class LOTA_API UHotbarWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	UHotbarWidget(const FObjectInitializer& ObjectInitializer);
+
+	UFUNCTION(BlueprintCallable, Category = "Hotbar")
+	void InitializeHotbar(UHotbarComponent* InHotbar);
+
+protected:
+	virtual void NativeDestruct() override;
+
+	// Container the buttons are added to
+	UPROPERTY(meta = (BindWidget))
+	UPanelWidget* ButtonContainer;
+
+	UPROPERTY()
+	TArray<UInventorySlotWidget*> Buttons;
+
+private:
+	TWeakObjectPtr<UHotbarComponent> Hotbar;
+
+	void RefreshButton(int32 SlotIndex);
+};
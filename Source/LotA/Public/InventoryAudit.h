@@ -0,0 +1,174 @@
+// InventoryAudit.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+// Why an inventory count changed. Stored as one byte in every audit record, so values must never be renumbered.
+enum class EInventoryAuditOp : uint8
+{
+	Unknown = 0,	// A mutation outside any audit scope
+	Create = 1,		// Items entered the economy (loot, vendor purchase, GM)
+	Destroy = 2,	// Items left the economy on purpose
+	Transfer = 3,	// Moved between the player's own containers
+	Consume = 4,
+	Equip = 5,
+	Unequip = 6,
+	WorldDrop = 7,
+	Trade = 8,
+	Pickup = 9,		// Taken from a world pickup
+	Gap = 255		// Records were lost because the buffer was full; Count holds how many
+};
+
+// One fixed-size audit entry. The layout is the on-disk format, so only append fields into Reserved.
+struct FInventoryAuditRecord
+{
+	// FDateTime ticks, UTC
+	int64 Timestamp = 0;
+
+	// InventoryAudit::HashPlayerId of the owning player's unique net ID, 0 if there is none
+	uint64 PlayerHash = 0;
+
+	// InventoryAudit::HashContainerName of the bag or equipment component's path name
+	uint32 ContainerHash = 0;
+
+	// Signed change in the item's count
+	int32 Count = 0;
+
+	int16 SlotIndex = -1;
+	uint8 Op = 0;
+	uint8 Reserved = 0;
+
+	// Null-terminated, truncated ASCII item ID
+	char ItemID[36] = {};
+
+	void SetItemID(FName InItemID);
+	FString GetItemID() const { return FString(ANSI_TO_TCHAR(ItemID)); }
+};
+static_assert(sizeof(FInventoryAuditRecord) == 64, "Audit records are a fixed 64 bytes on disk");
+
+// Header at the start of every audit file
+struct FInventoryAuditFileHeader
+{
+	static constexpr uint32 ExpectedMagic = 0x4149414C; // "LAIA"
+	static constexpr uint32 CurrentVersion = 1;
+
+	uint32 Magic = ExpectedMagic;
+	uint32 Version = CurrentVersion;
+	uint32 RecordSize = sizeof(FInventoryAuditRecord);
+	uint32 Reserved = 0;
+};
+
+namespace InventoryAudit
+{
+	LOTA_API uint64 HashPlayerId(FStringView UniqueNetId);
+	LOTA_API uint32 HashContainerName(FStringView ContainerPath);
+	LOTA_API const TCHAR* OpToString(EInventoryAuditOp Op);
+
+	// Op that mutations on this thread are currently attributed to
+	LOTA_API EInventoryAuditOp GetCurrentOp();
+}
+
+// Attributes every inventory change made while it is alive to Op. Scopes nest; the innermost wins.
+class LOTA_API FInventoryAuditScope
+{
+public:
+	explicit FInventoryAuditScope(EInventoryAuditOp Op);
+	~FInventoryAuditScope();
+
+	FInventoryAuditScope(const FInventoryAuditScope&) = delete;
+	FInventoryAuditScope& operator=(const FInventoryAuditScope&) = delete;
+
+private:
+	EInventoryAuditOp PreviousOp;
+};
+
+// Bounded lock-free queue for many producers and one consumer (Vyukov's sequence-per-cell design).
+// Producers never block or allocate; a push into a full buffer fails and the caller counts the loss.
+template <typename T>
+class TAuditRingBuffer
+{
+public:
+	explicit TAuditRingBuffer(uint32 CapacityPow2)
+		: Mask(CapacityPow2 - 1)
+		, Cells(new FCell[CapacityPow2])
+	{
+		check(FMath::IsPowerOfTwo(CapacityPow2));
+		for (uint32 Index = 0; Index < CapacityPow2; ++Index)
+		{
+			Cells[Index].Sequence.store(Index, std::memory_order_relaxed);
+		}
+	}
+
+	~TAuditRingBuffer()
+	{
+		delete[] Cells;
+	}
+
+	bool Push(const T& Item)
+	{
+		uint64 Position = EnqueuePosition.load(std::memory_order_relaxed);
+		for (;;)
+		{
+			FCell& Cell = Cells[Position & Mask];
+			const uint64 Sequence = Cell.Sequence.load(std::memory_order_acquire);
+			const int64 Difference = static_cast<int64>(Sequence) - static_cast<int64>(Position);
+			if (Difference == 0)
+			{
+				if (EnqueuePosition.compare_exchange_weak(Position, Position + 1, std::memory_order_relaxed))
+				{
+					Cell.Value = Item;
+					Cell.Sequence.store(Position + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (Difference < 0)
+			{
+				return false;
+			}
+			else
+			{
+				Position = EnqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	// Consumer thread only
+	bool Pop(T& OutItem)
+	{
+		const uint64 Position = DequeuePosition.load(std::memory_order_relaxed);
+		FCell& Cell = Cells[Position & Mask];
+		const uint64 Sequence = Cell.Sequence.load(std::memory_order_acquire);
+		if (Sequence != Position + 1)
+		{
+			return false;
+		}
+
+		OutItem = Cell.Value;
+		Cell.Sequence.store(Position + Mask + 1, std::memory_order_release);
+		DequeuePosition.store(Position + 1, std::memory_order_relaxed);
+		return true;
+	}
+
+	// Approximate, for deciding when to wake the consumer
+	uint32 ApproximateNum() const
+	{
+		return static_cast<uint32>(EnqueuePosition.load(std::memory_order_relaxed) - DequeuePosition.load(std::memory_order_relaxed));
+	}
+
+	uint32 Capacity() const { return Mask + 1; }
+
+private:
+	struct FCell
+	{
+		std::atomic<uint64> Sequence;
+		T Value;
+	};
+
+	const uint32 Mask;
+	FCell* Cells;
+
+	// Producers and the consumer on separate cache lines
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> EnqueuePosition{0};
+	alignas(PLATFORM_CACHE_LINE_SIZE) std::atomic<uint64> DequeuePosition{0};
+};
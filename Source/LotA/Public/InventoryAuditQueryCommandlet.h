@@ -0,0 +1,21 @@
+// InventoryAuditQueryCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "InventoryAuditQueryCommandlet.generated.h"
+
+// Offline reader for the inventory audit files. Prints matching records as CSV and a net count per item.
+//
+// Usage: UnrealEditor-Cmd LotA -run=InventoryAuditQuery [-Player=<unique net id> | -PlayerHash=<hex>]
+//        [-Item=<ItemID>] [-Dir=<audit dir>] [-Out=<file.csv>]
+UCLASS()
+class LOTA_API UInventoryAuditQueryCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UInventoryAuditQueryCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
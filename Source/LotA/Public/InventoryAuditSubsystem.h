@@ -0,0 +1,67 @@
+// InventoryAuditSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "InventoryAudit.h"
+#include "InventoryAuditSubsystem.generated.h"
+
+class APlayerState;
+class FInventoryAuditWriter;
+class UActorComponent;
+
+// Server-side audit trail of every item count change, for dupe investigations. Recording copies a
+// 64-byte record into a lock-free ring buffer; a background thread drains it into binary files under
+// Saved/Audit, starting a new file each UTC day or when the current one reaches MaxFileSizeMB.
+// Nothing is started until a server or standalone world records a change, so pure clients write no
+// files. Read the files with the InventoryAuditQuery commandlet.
+UCLASS(Config = Game)
+class LOTA_API UInventoryAuditSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UInventoryAuditSubsystem();
+	virtual ~UInventoryAuditSubsystem() override;
+
+	static UInventoryAuditSubsystem* Get();
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Deinitialize() override;
+
+	// Record a change of Delta items in a bag or equipment component. Game thread.
+	void RecordChange(const UActorComponent* Container, int32 SlotIndex, FName ItemID, int32 Delta);
+
+	// Queue a prepared record. Safe from any thread; never blocks.
+	void Record(const FInventoryAuditRecord& Record);
+
+	static FString GetAuditDirectory();
+
+protected:
+	UPROPERTY(Config)
+	bool bEnabled;
+
+	// Records held in memory between flushes; rounded up to a power of two
+	UPROPERTY(Config)
+	int32 BufferCapacity;
+
+	UPROPERTY(Config)
+	int32 MaxFileSizeMB;
+
+private:
+	TUniquePtr<TAuditRingBuffer<FInventoryAuditRecord>> Buffer;
+	TUniquePtr<FInventoryAuditWriter> Writer;
+
+	// Records lost to a full buffer or a file that would not open, since the writer last reported them
+	std::atomic<uint32> DroppedRecords;
+
+	bool bStartAttempted = false;
+
+	// Hashes are stable across sessions but costly to compute, so each is made once
+	TMap<TWeakObjectPtr<const APlayerState>, uint64> PlayerHashes;
+	TMap<TWeakObjectPtr<const UActorComponent>, uint32> ContainerHashes;
+
+	void StartWriter();
+	uint64 GetPlayerHash(const UActorComponent* Container);
+	uint32 GetContainerHash(const UActorComponent* Container);
+};
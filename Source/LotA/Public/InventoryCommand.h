@@ -0,0 +1,58 @@
+// InventoryCommand.h
+#pragma once
+
+#include "CoreMinimal.h"
+
+// One queued change to a player's inventory, run by UInventoryCommandSubsystem in three steps.
+// Only Execute runs off the game thread, so anything expensive that doesn't need UObjects (rolling,
+// sorting, serializing) belongs there, working on whatever Capture copied out.
+class LOTA_API FInventoryCommand
+{
+public:
+	virtual ~FInventoryCommand() = default;
+
+	// Game thread, right before the command is handed to a worker
+	virtual void Capture() {}
+
+	// Worker thread, holding the locks of every player the command was queued for. Must not touch UObjects.
+	virtual void Execute() {}
+
+	// Game thread, in queue order: write the result into the inventory, where it replicates as usual
+	virtual void Apply() = 0;
+
+	// Game thread, instead of the other steps when the command is dropped unrun because a queue it was
+	// in went away. Undo whatever bookkeeping expected it to run.
+	virtual void Discard() {}
+
+	// Whether Capture reads inventory state. Such a command starts a new batch, so everything queued
+	// before it has been applied by the time it captures.
+	virtual bool ReadsInventory() const { return false; }
+};
+
+// Command that only applies, for changes that are cheap but must stay in order with the rest of the queue
+class LOTA_API FInventoryApplyCommand : public FInventoryCommand
+{
+public:
+	explicit FInventoryApplyCommand(TFunction<void()>&& InApply, TFunction<void()>&& InDiscard = nullptr)
+		: ApplyFunction(MoveTemp(InApply))
+		, DiscardFunction(MoveTemp(InDiscard))
+	{
+	}
+
+	virtual void Apply() override
+	{
+		ApplyFunction();
+	}
+
+	virtual void Discard() override
+	{
+		if (DiscardFunction)
+		{
+			DiscardFunction();
+		}
+	}
+
+private:
+	TFunction<void()> ApplyFunction;
+	TFunction<void()> DiscardFunction;
+};
@@ -0,0 +1,90 @@
+// InventoryCommandSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "InventoryCommand.h"
+#include "InventoryCommandSubsystem.generated.h"
+
+class APlayerController;
+
+// Server-side queue of inventory commands, one queue per player. Each tick every player's next batch
+// is executed as its own task, so players are processed in parallel across the worker threads, and
+// the results are applied back on the game thread in the order they were queued.
+//
+// A command queued for several players (a trade) waits until it reaches the front of all their
+// queues and then runs alone, holding each player's lock in ascending key order, so two such
+// commands can never deadlock and no player's commands overtake it.
+UCLASS()
+class LOTA_API UInventoryCommandSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UInventoryCommandSubsystem* Get(const UObject* WorldContextObject);
+
+	// Commands taken from one player's queue per tick
+	static constexpr int32 MaxCommandsPerPlayerPerTick = 16;
+
+	// Commands queued for several players (trade commits) dispatched per tick; the rest wait at the
+	// front of their queues, holding up only those players
+	static constexpr int32 MaxCommitsPerTick = 4;
+
+	void Enqueue(APlayerController* Player, TUniquePtr<FInventoryCommand> Command);
+	void Enqueue(TConstArrayView<APlayerController*> Players, TUniquePtr<FInventoryCommand> Command);
+	void EnqueueApply(APlayerController* Player, TFunction<void()>&& Apply);
+
+	// Drop everything still queued for a player without applying it; each command gets Discard instead
+	void DiscardQueue(const APlayerController* Player);
+
+	int32 GetNumQueued(const APlayerController* Player) const;
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	using FPlayerKey = TObjectKey<APlayerController>;
+
+	struct FQueuedCommand
+	{
+		TUniquePtr<FInventoryCommand> Command;
+
+		// Keys of every player the command was queued for, ascending
+		TArray<FPlayerKey, TInlineAllocator<2>> Players;
+
+		uint64 Sequence = 0;
+	};
+
+	struct FPlayerQueue
+	{
+		TWeakObjectPtr<APlayerController> Player;
+		TArray<TSharedPtr<FQueuedCommand>> Pending;
+
+		// Held by whichever task is executing this player's commands
+		FCriticalSection Lock;
+	};
+
+	// Commands executed together by one task
+	struct FWorkUnit
+	{
+		TArray<FPlayerQueue*, TInlineAllocator<2>> Queues;
+		TArray<FQueuedCommand*, TInlineAllocator<MaxCommandsPerPlayerPerTick>> Commands;
+	};
+
+	TMap<FPlayerKey, TUniquePtr<FPlayerQueue>> Queues;
+	uint64 NextSequence = 0;
+
+	static FPlayerKey GetPlayerKey(const APlayerController* Player) { return FPlayerKey(Player); }
+	FPlayerQueue& FindOrAddQueue(APlayerController* Player);
+
+	// Remove a queue, along with any shared commands it was holding up in other players' queues.
+	// Every removed command is told through Discard.
+	void RemoveQueue(FPlayerKey Key);
+	bool IsAtFrontOfAll(const FQueuedCommand& Queued) const;
+
+	// Build this tick's work units from the front of each queue
+	void GatherWork(TArray<FWorkUnit>& OutUnits);
+	static void ExecuteUnit(FWorkUnit& Unit);
+};
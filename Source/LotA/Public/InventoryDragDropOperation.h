@@ -4,7 +4,7 @@
 #include "CoreMinimal.h"
 #include "Blueprint/DragDropOperation.h"
 #include "S_ItemInfo.h"
-#include "InventorySlotWidget.h"
+#include "InventoryTransfer.h"
 #include "InventoryDragDropOperation.generated.h"
 
 UCLASS()
@@ -13,19 +13,15 @@ class LOTA_API UInventoryDragDropOperation : public UDragDropOperation
 	GENERATED_BODY()
 
 public:
-	// The source inventory slot this drag operation started from
+	// What is being moved and where from; this is all a drop target hands to the router
 	UPROPERTY(BlueprintReadWrite, Category = "Inventory")
-	UInventorySlotWidget* SourceSlot;
+	FInventoryDragPayload Payload;
 
-	// The item and quantity being dragged
+	// Item shown on the drag visual
 	UPROPERTY(BlueprintReadWrite, Category = "Inventory")
 	FS_ItemInfo DraggedItem;
 
 	// Whether this is a split operation (shift or ctrl drag)
 	UPROPERTY()
 	bool bSplitStack;
-
-	// The original quantity in the source slot before the drag started
-	UPROPERTY()
-	int32 OriginalQuantity;
-};
\ No newline at end of file
+};
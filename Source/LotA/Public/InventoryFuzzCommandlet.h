@@ -0,0 +1,26 @@
+// InventoryFuzzCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "InventoryFuzzCommandlet.generated.h"
+
+// Headless fuzzer for inventory moves. Each run possesses a throwaway pawn with bags and equipment and
+// applies a seeded random sequence of operations: adds, removals and resizes straight on the bags, and
+// splits, merges, moves, swaps, equips, unequips, world drops and destroys through the same drop router
+// the UI uses. After every step it checks that no item was created or lost across bags, equipment and
+// spawned pickups, that every unique item holds exactly one live instance, and that no stack exceeds its
+// limit. A failing sequence is shrunk to a minimal reproduction.
+//
+// Usage: UnrealEditor-Cmd LotA -run=InventoryFuzz [-Seed=N] [-Runs=N] [-Steps=N] [-Bags=N]
+// Returns 0 when every run passes, 1 otherwise.
+UCLASS()
+class LOTA_API UInventoryFuzzCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UInventoryFuzzCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,125 @@
+// InventoryIconAtlasSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "Containers/Ticker.h"
+#include "InventoryIconAtlasSubsystem.generated.h"
+
+class UTexture2D;
+class UTextureRenderTarget2D;
+struct FSlateBrush;
+struct FStreamableHandle;
+
+// An icon waiting to be drawn into its atlas cell
+USTRUCT()
+struct FInventoryIconDraw
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TObjectPtr<UTexture2D> Icon = nullptr;
+
+	int32 Cell = INDEX_NONE;
+	int32 RegistryIndex = INDEX_NONE;
+};
+
+// Packs item icons into a few shared render-target pages, so inventory slots all draw from the same
+// handful of textures and Slate batches them together. Pages are split into fixed-size cells handed
+// out per registry entry. Slots pin the cell they show; unpinned cells stay cached in least recently
+// released order and are reused once the memory budget allows no more pages. Icon textures are
+// streamed in and held only until they have been drawn into their cell.
+UCLASS(Config = Game)
+class LOTA_API UInventoryIconAtlasSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UInventoryIconAtlasSubsystem();
+
+	// Null on dedicated servers and in commandlets
+	static UInventoryIconAtlasSubsystem* Get();
+
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Pin the icon of a registry entry and return its cell to release later, or INDEX_NONE if the entry
+	// has no icon or every cell in the budget is pinned. A reused cell still shows the evicted icon until
+	// the new one is drawn; OnDrawn runs then, unless it already has been.
+	int32 AcquireIcon(int32 RegistryIndex, FSimpleDelegate OnDrawn = FSimpleDelegate());
+
+	// Point OutBrush at a cell. False until the cell's icon has been drawn.
+	bool GetCellBrush(int32 Cell, FSlateBrush& OutBrush) const;
+
+	// Unpin a cell returned by AcquireIcon. Its icon stays cached until the cell is needed again.
+	void ReleaseIcon(int32 Cell);
+
+	int32 GetNumPages() const { return Pages.Num(); }
+
+protected:
+	// Width and height of a page in pixels
+	UPROPERTY(Config)
+	int32 PageSize;
+
+	// Width and height of one icon cell in pixels
+	UPROPERTY(Config)
+	int32 CellSize;
+
+	// Pages are added until they would exceed this
+	UPROPERTY(Config)
+	int32 MemoryBudgetMB;
+
+private:
+	struct FIconCell
+	{
+		int32 RegistryIndex = INDEX_NONE;
+		int32 PinCount = 0;
+
+		// The cell holds RegistryIndex's icon rather than whatever it held before
+		bool bDrawn = false;
+		TArray<FSimpleDelegate> OnDrawn;
+
+		// Keeps a streamed icon loaded until it is drawn
+		TSharedPtr<FStreamableHandle> IconLoad;
+
+		// Links in the list of unpinned cells
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+	};
+
+	UPROPERTY()
+	TArray<TObjectPtr<UTextureRenderTarget2D>> Pages;
+
+	TArray<FIconCell> Cells;
+	TMap<int32, int32> CellByRegistryIndex;
+
+	// Unpinned cells: empty ones first, then cached icons from least to most recently released
+	int32 FreeHead;
+	int32 FreeTail;
+
+	int32 CellsPerRow;
+	int32 CellsPerPage;
+	int32 MaxPages;
+
+	UPROPERTY()
+	TArray<FInventoryIconDraw> PendingDraws;
+
+	FTSTicker::FDelegateHandle TickHandle;
+
+	bool Tick(float DeltaTime);
+
+	void HandleIconLoaded(int32 Cell, int32 RegistryIndex);
+	void QueueDraw(int32 Cell, int32 RegistryIndex, UTexture2D* Icon);
+
+	// Draw queued icons, one canvas per page. Icons still streaming in wait for the next tick.
+	void FlushPendingDraws();
+
+	bool AddPage();
+	void FillBrush(int32 Cell, FSlateBrush& OutBrush) const;
+	FVector2D GetCellOrigin(int32 Cell) const;
+
+	void LinkHead(int32 Cell);
+	void LinkTail(int32 Cell);
+	void Unlink(int32 Cell);
+};
@@ -0,0 +1,26 @@
+// InventoryNetLoadCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "InventoryNetLoadCommandlet.generated.h"
+
+// Launches an inventory network load test: a dedicated server running scripted inventory churn and N
+// headless clients connected to it, every process recording UInventoryNetProfilerSubsystem's CSV and
+// a trace with the net channel on. Waits for all of them to finish, merges the CSVs into
+// InventoryNetLoad.csv with a leading Process column and logs each connection's average bandwidth.
+// The per-process traces are left next to it for Networking Insights.
+//
+// Usage: UnrealEditor-Cmd LotA -run=InventoryNetLoad -Map=/Game/Maps/Map [-Clients=4] [-Seconds=60]
+//        [-Churn=20] [-Port=7777] [-Warmup=15] [-Out=<dir>]
+// Returns 0 when every process exits cleanly, 1 otherwise.
+UCLASS()
+class LOTA_API UInventoryNetLoadCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UInventoryNetLoadCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
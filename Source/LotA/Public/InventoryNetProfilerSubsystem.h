@@ -0,0 +1,116 @@
+// InventoryNetProfilerSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "InventoryNetProfilerSubsystem.generated.h"
+
+class AActor;
+class APlayerController;
+class UActorComponent;
+class ULootTable;
+class UNetConnection;
+class UNetDriver;
+struct FFrame;
+struct FOutParmRec;
+
+// Measures what inventory costs on the wire. While recording, every connection of this world is
+// sampled once a second into a CSV, one row per connection and stat:
+// - bytes and packets per second in each direction, from the connection's own stats;
+// - Property:Class.Name, replicated properties of this module's components that changed, as received
+//   from the server on clients and as queued for the owning connection on the server;
+// - RPC:Class.Function, RPCs of this module's components sent over that connection.
+// The session is also traced with the net channel on, so Networking Insights can break the bits down
+// further; start and end of the window are bookmarked in the trace. On the server it also drives
+// scripted churn for every connected player through the game's own paths: loot grants through
+// ULootSubsystem, moves, destroys and bag swaps through the player's drop router.
+//
+// UInventoryNetLoadCommandlet launches a server and N headless clients with the right arguments and
+// merges their CSVs. By hand, or in PIE through the console:
+//   UnrealEditor LotA -server -InventoryNetProfile=60 -InventoryChurn=20 [-InventoryNetProfileCsv=<file>]
+//   LotA.NetProfile <Seconds> [ChurnOpsPerSecond]
+UCLASS(Config = Game)
+class LOTA_API UInventoryNetProfilerSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UInventoryNetProfilerSubsystem* Get(const UObject* WorldContextObject);
+
+	// Record for Seconds into CsvPath, churning ChurnOpsPerSecond operations per player per second on
+	// the server. Starts a trace to TracePath unless the process is already tracing.
+	void StartRecording(float Seconds, float ChurnOpsPerSecond, const FString& CsvPath, const FString& TracePath);
+	void StopRecording();
+
+	bool IsRecording() const { return bRecording; }
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+protected:
+	// What churned loot is rolled from; without one churn only moves, destroys and swaps
+	UPROPERTY(Config)
+	TSoftObjectPtr<ULootTable> ChurnLootTable;
+
+private:
+	// Replicated property values of one component as of the last tick
+	struct FPropertyShadow
+	{
+		const UClass* Class = nullptr;
+		uint8* Values = nullptr;
+	};
+
+	UPROPERTY()
+	TObjectPtr<const ULootTable> LoadedChurnTable;
+
+	bool bRecording = false;
+
+	TUniquePtr<FArchive> CsvFile;
+	FString CsvFilePath;
+
+	// Counts since the last sample, per connection, keyed by stat
+	TMap<FString, TMap<FString, int32>> Counts;
+
+	TMap<TObjectKey<UActorComponent>, FPropertyShadow> Shadows;
+
+	// The driver whose RPC hook is bound here
+	TWeakObjectPtr<UNetDriver> HookedDriver;
+
+	// The trace was started here, so it is stopped here too
+	bool bOwnsTrace = false;
+
+	// Exit the process once recording ends, for launched runs
+	bool bQuitWhenDone = false;
+
+	double RecordingStartTime = 0.0;
+	double RecordingEndTime = 0.0;
+	double NextSampleTime = 0.0;
+
+	float ChurnRate = 0.0f;
+	float ChurnBudget = 0.0f;
+	FRandomStream ChurnStream;
+
+	void RunChurn(float DeltaTime);
+	void ChurnPlayer(APlayerController* Player);
+
+	void WriteSample(double Now);
+	void WriteRow(double Time, const FString& Connection, const FString& Stat, double Value);
+
+	// Count the replicated properties of tracked components that changed since the last tick
+	void CountPropertyChanges();
+	void FreeShadow(FPropertyShadow& Shadow);
+
+	void HookRPCs();
+	void UnhookRPCs();
+	void HandleSendRPC(AActor* Actor, UFunction* Function, void* Parameters, FOutParmRec* OutParms, FFrame* Stack, UObject* SubObject, bool& bBlockSendRPC);
+
+	// Components of this module are the ones counted
+	static bool IsTracked(const UObject* Object);
+
+	// Row label of the connection an actor's traffic goes over
+	FString DescribeConnection(const AActor* Actor) const;
+	FString DescribeConnection(const UNetConnection* Connection) const;
+};
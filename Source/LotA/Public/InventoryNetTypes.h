@@ -0,0 +1,70 @@
+// InventoryNetTypes.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ItemInstance.h"
+#include "InventoryNetTypes.generated.h"
+
+class UPackageMap;
+
+// An item definition on the wire. Cooked items go as their registry index in as few bits as the
+// table needs; anything else falls back to the ItemID. Receivers look the definition up locally.
+USTRUCT()
+struct LOTA_API FItemNetReference
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FName ItemID;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	// Shared with FInventorySlotNetData; returns the registry index used, or INDEX_NONE
+	static int32 SerializeItemID(FArchive& Ar, FName& ItemID);
+
+	bool operator==(const FItemNetReference& Other) const { return ItemID == Other.ItemID; }
+};
+
+template<>
+struct TStructOpsTypeTraits<FItemNetReference> : public TStructOpsTypeTraitsBase2<FItemNetReference>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
+
+// Replicated contents of one inventory slot: which item, how many and which instance. An empty slot
+// is a single bit; a cooked stackable item is its index plus a count bounded by its stack size.
+USTRUCT()
+struct LOTA_API FInventorySlotNetData
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FName ItemID;
+
+	UPROPERTY()
+	int32 Count = 0;
+
+	UPROPERTY()
+	FItemInstanceHandle Instance;
+
+	bool NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess);
+
+	bool operator==(const FInventorySlotNetData& Other) const
+	{
+		return ItemID == Other.ItemID && Count == Other.Count && Instance == Other.Instance;
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FInventorySlotNetData> : public TStructOpsTypeTraitsBase2<FInventorySlotNetData>
+{
+	enum
+	{
+		WithNetSerializer = true,
+		WithIdenticalViaEquality = true,
+	};
+};
@@ -0,0 +1,95 @@
+// InventoryRegistryComponent.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "BagComponent.h"
+#include "InventoryRegistryComponent.generated.h"
+
+class APawn;
+
+// A registered bag and the handle it was given
+USTRUCT()
+struct LOTA_API FInventoryContainerEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Handle = INDEX_NONE;
+
+	UPROPERTY()
+	TObjectPtr<UBagComponent> Bag = nullptr;
+};
+
+// The bags of the pawn a player controls, in registration order. Lives on the player controller.
+// The server keeps the list in sync from the bags' register/unregister calls and hands out small
+// integer handles that never change while a bag stays registered; the list replicates to the
+// owning client, so both sides agree on the handles and UI and RPCs can use them to address bags.
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class LOTA_API UInventoryRegistryComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UInventoryRegistryComponent();
+
+	// Registry of the player that owns Actor, which is either the controller or its pawn
+	static UInventoryRegistryComponent* FindForActor(const AActor* Actor);
+
+	// Actor's bags: the registry's list for player pawns and controllers, a component scan for anything else
+	static void GetBagsOf(const AActor* Actor, TArray<UBagComponent*>& OutBags);
+
+	// Every registered bag, in registration order
+	const TArray<UBagComponent*>& GetBags() const { return Bags; }
+
+	UFUNCTION(BlueprintPure, Category = "Inventory")
+	int32 GetNumContainers() const { return Bags.Num(); }
+
+	// INDEX_NONE if the bag isn't registered here
+	UFUNCTION(BlueprintPure, Category = "Inventory")
+	int32 GetContainerHandle(const UBagComponent* Bag) const;
+
+	// Null for unknown or stale handles
+	UFUNCTION(BlueprintPure, Category = "Inventory")
+	UBagComponent* GetBagByHandle(int32 Handle) const;
+
+	// Called by bags as they register and unregister; ignored off authority and for other actors' bags
+	void RegisterContainer(UBagComponent* Bag);
+	void UnregisterContainer(UBagComponent* Bag);
+
+	// Fired on the server and the owning client, including for every bag when the pawn changes
+	FOnBagLifetimeEvent OnContainerAdded;
+	FOnBagLifetimeEvent OnContainerRemoved;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	UPROPERTY(ReplicatedUsing = OnRep_Containers)
+	TArray<FInventoryContainerEntry> Containers;
+
+	// Lookups derived from Containers. Bags skips entries whose bag hasn't resolved yet.
+	UPROPERTY(Transient)
+	TArray<UBagComponent*> Bags;
+
+	TMap<int32, int32> IndexByHandle;
+	TMap<TObjectKey<UBagComponent>, int32> HandleByBag;
+
+	int32 NextHandle;
+
+	TWeakObjectPtr<APawn> TrackedPawn;
+	FDelegateHandle NewPawnHandle;
+
+	UFUNCTION()
+	void OnRep_Containers();
+
+	// Whether Bags is the bag list of Actor: the owning controller or the pawn currently tracked
+	bool ListsBagsOf(const AActor* Actor) const;
+
+	void HandleNewPawn(APawn* NewPawn);
+	void RemoveAllContainers();
+
+	// Rebuild Bags and IndexByHandle from Containers
+	void RebuildLookups();
+};
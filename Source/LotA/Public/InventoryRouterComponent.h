@@ -0,0 +1,84 @@
+// InventoryRouterComponent.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "S_ItemInfo.h"
+#include "InventoryTransfer.h"
+#include "ItemInstance.h"
+#include "InventoryRouterComponent.generated.h"
+
+class AItemBase;
+class APawn;
+class UInventorySlotDataComponent;
+
+namespace InventoryFuzz { class FFuzzer; }
+
+// Single entry point for moving items between containers. Widgets describe a drop as a payload plus a
+// destination and hand it here; the router sends it to the server as one RPC, where it is validated
+// against the player's own containers and applied to the data model, in order with the player's
+// other queued inventory commands. Lives on the player controller so it has an owning connection.
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class LOTA_API UInventoryRouterComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UInventoryRouterComponent();
+
+	// Move Payload to a destination container. DestinationIndex is a bag slot or an EEquipmentSlot value
+	// and is ignored for World and Destroy. Safe to call on the owning client.
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void RouteDrop(const FInventoryDragPayload& Payload, const FInventoryContainerHandle& Destination, int32 DestinationIndex);
+
+	// Move a world pickup into the player's bags. A unique item keeps its instance and needs an empty
+	// slot; whatever of a stack doesn't fit stays on the ground. Safe to call on the owning client.
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void PickUp(AItemBase* Pickup);
+
+	// Actor spawned for items dropped into the world
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory")
+	TSubclassOf<AItemBase> WorldDropClass;
+
+	// How far in front of the pawn world drops appear
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory")
+	float WorldDropDistance;
+
+	// How close the pawn must be to a pickup to take it
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Inventory")
+	float PickupRange;
+
+private:
+	// Drives ExecuteTransfer directly, skipping the command queue so every step applies at once
+	friend class InventoryFuzz::FFuzzer;
+
+	UFUNCTION(Server, Reliable)
+	void ServerRouteDrop(const FInventoryDragPayload& Payload, const FInventoryContainerHandle& Destination, int32 DestinationIndex);
+
+	UFUNCTION(Server, Reliable)
+	void ServerPickUp(AItemBase* Pickup);
+
+	// Validate and apply a pickup; authority only
+	bool ExecutePickUp(AItemBase* Pickup);
+
+	// Queue a transfer behind the player's other inventory commands; authority only
+	void QueueTransfer(const FInventoryDragPayload& Payload, const FInventoryContainerHandle& Destination, int32 DestinationIndex);
+
+	// Validate and apply a transfer; authority only
+	bool ExecuteTransfer(const FInventoryDragPayload& Payload, const FInventoryContainerHandle& Destination, int32 DestinationIndex);
+	bool TransferFromBag(const FInventoryDragPayload& Payload, const FInventoryContainerHandle& Destination, int32 DestinationIndex);
+	bool TransferFromEquipment(const FInventoryDragPayload& Payload, const FInventoryContainerHandle& Destination, int32 DestinationIndex);
+
+	// Equip one item from Source; whatever the slot held goes back to Source or elsewhere in the bags
+	bool EquipFromSlot(UInventorySlotDataComponent& Source, UEquipmentComponent* Equipment, int32 EquipmentSlotIndex);
+
+	// Put items in PreferredSlot, else any bag, else on the ground
+	void StoreItem(const FS_ItemInfo& Item, int32 Count, UInventorySlotDataComponent* PreferredSlot, FItemInstanceHandle Instance = FItemInstanceHandle());
+
+	void SpawnWorldDrop(const FS_ItemInfo& Item, int32 Count, FItemInstanceHandle Instance = FItemInstanceHandle());
+
+	// Whether a handle names something this player may move items to or from
+	bool IsOwnedContainer(const FInventoryContainerHandle& Handle) const;
+
+	APawn* GetControlledPawn() const;
+};
@@ -3,8 +3,16 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "S_ItemInfo.h"
+#include "ItemInstance.h"
+#include "InventoryNetTypes.h"
 #include "InventorySlotDataComponent.generated.h"
 
+class UBagComponent;
+struct FInventoryStoreSlot;
+
+// One slot of a bag, as a view: the contents live in the bag's inventory in UInventoryStoreSubsystem
+// and every read and write goes through the owning bag. The component itself only carries what
+// replicates. A slot outside a bag is empty and can't be changed.
 UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
 class LOTA_API UInventorySlotDataComponent : public UActorComponent
 {
@@ -13,13 +21,14 @@ class LOTA_API UInventorySlotDataComponent : public UActorComponent
 public:
 	UInventorySlotDataComponent();
 
-	// Store item data
-	UPROPERTY(BlueprintReadOnly, Category = "Item")
-	FS_ItemInfo ItemData;
+	// Definition of the item in the slot, from the item registry. Don't hold the reference across
+	// registering a new item.
+	UFUNCTION(BlueprintPure, Category = "Item")
+	const FS_ItemInfo& GetItemData() const;
 
 	// Current stack count for the item
-	UPROPERTY(BlueprintReadOnly, Category = "Item")
-	int32 StackCount;
+	UFUNCTION(BlueprintPure, Category = "Item")
+	int32 GetStackCount() const;
 
 	// Check if the slot is empty
 	UFUNCTION(BlueprintCallable, Category = "Item")
@@ -29,10 +38,59 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Item")
 	bool AddItems(const FS_ItemInfo& NewItem, int32 Count);
 
-	// Remove items from the slot
+	// Remove items from the slot. Emptying a slot that holds a unique item destroys its instance.
 	UFUNCTION(BlueprintCallable, Category = "Item")
 	bool RemoveItems(int32 Count);
 
+	// Instance of the unique item in this slot; invalid for stacks and empty slots
+	FItemInstanceHandle GetInstanceHandle() const;
+
+	// Remove items that are moving to another container. If that empties a slot holding a unique
+	// item, its instance is handed over through OutInstance rather than destroyed.
+	bool TakeItems(int32 Count, FItemInstanceHandle& OutInstance);
+
+	// Counterpart of TakeItems: adds the items, adopting Instance if one came along
+	bool PutItems(const FS_ItemInfo& NewItem, int32 Count, FItemInstanceHandle Instance);
+
+	// Move Count items onto Target: merges into a matching or empty slot up to the stack limit, or
+	// swaps whole stacks of different items. Returns false and changes nothing if neither applies.
+	static bool TransferItems(UInventorySlotDataComponent& Source, UInventorySlotDataComponent* Target, int32 Count);
+
+	// Empty the slot without any checks, used when recycling it. Destroys any instance it held.
+	void ResetSlot();
+
+	// Attach the slot to the bag it is a view of. Pass null when the slot is pooled.
+	void SetOwningBag(UBagComponent* InBag, int32 InSlotIndex);
+
+	UBagComponent* GetOwningBag() const { return OwningBag.Get(); }
+	int32 GetSlotIndex() const { return SlotIndex; }
+
+	// Copy the bag's contents for this slot into what replicates (authority only)
+	void UpdateNetContents();
+
 protected:
 	virtual void BeginPlay() override;
+
+private:
+	// What replicates: item, count and instance packed into a few bits, refreshed on every change
+	UPROPERTY(ReplicatedUsing = OnRep_SlotContents)
+	FInventorySlotNetData NetContents;
+
+	// Full definition, sent only for items outside the cooked table that clients can't look up
+	UPROPERTY(ReplicatedUsing = OnRep_SlotContents)
+	FS_ItemInfo UncookedItemData;
+
+	TWeakObjectPtr<UBagComponent> OwningBag;
+	int32 SlotIndex;
+
+	UFUNCTION()
+	void OnRep_SlotContents();
+
+	// The owning bag while it still holds this component at SlotIndex, otherwise null
+	UBagComponent* GetViewedBag() const;
+
+	FInventoryStoreSlot ReadContents() const;
+
+	// Write the replicated contents into the bag (clients)
+	void ApplyNetContents();
 };
@@ -0,0 +1,48 @@
+// InventorySlotPoolSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InventorySlotPoolSubsystem.generated.h"
+
+class UInventorySlotDataComponent;
+
+// Free slot components belonging to one actor
+USTRUCT()
+struct FInventorySlotFreeList
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<TObjectPtr<UInventorySlotDataComponent>> Slots;
+};
+
+// Recycles inventory slot components so bag swaps and resizes don't churn UObjects.
+// Slots are components, so they can only be reused by the actor that owns them; the pool keeps one free list per actor.
+UCLASS()
+class LOTA_API UInventorySlotPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Get an empty, registered slot owned by Owner. Reuses a pooled one when available.
+	UInventorySlotDataComponent* AcquireSlot(AActor* Owner);
+
+	// Return a slot to its owner's free list, or destroy it when it can't be pooled. Either way it is
+	// emptied first and any unique-item instance it held is released, so call this while the slot is
+	// still in its bag's slot array.
+	void ReleaseSlot(UInventorySlotDataComponent* Slot);
+
+	// Free slots kept per actor before released slots are destroyed instead
+	static constexpr int32 MaxPooledSlotsPerOwner = 128;
+
+	virtual void Deinitialize() override;
+
+private:
+	UPROPERTY()
+	TMap<TObjectPtr<AActor>, FInventorySlotFreeList> FreeLists;
+
+	// Pooled slots die with their actor, so drop its list instead of keeping the actor alive
+	UFUNCTION()
+	void HandleOwnerEndPlay(AActor* Actor, EEndPlayReason::Type EndPlayReason);
+};
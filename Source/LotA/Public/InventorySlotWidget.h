@@ -7,6 +7,9 @@
 
 class UImage;
 class UTextBlock;
+class UBagComponent;
+class UInventoryRouterComponent;
+struct FInventoryFilter;
 
 UCLASS()
 class LOTA_API UInventorySlotWidget : public UUserWidget
@@ -24,12 +27,30 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Inventory Slot")
     void ClearSlot();
 
+    // Point this widget at the bag slot it displays, so actions on it reach the data model
+    UFUNCTION(BlueprintCallable, Category = "Inventory Slot")
+    void BindToBagSlot(UBagComponent* InBag, int32 InSlotIndex);
+
+    UBagComponent* GetBoundBag() const { return BoundBag.Get(); }
+    int32 GetBoundSlotIndex() const { return BoundSlotIndex; }
+
+    // Item currently shown in the slot (NAME_None when empty)
+    FName GetItemID() const { return CurrentItemInfo.ItemID; }
+
+    // Test this slot against a filter and dim it if it doesn't match. Passing null clears filtering.
+    // The filter is kept so the slot re-tests itself when its item changes.
+    bool ApplyFilter(const FInventoryFilter* Filter, float InFilteredOutOpacity);
+
+    bool MatchesFilter() const { return bMatchesFilter; }
+
 protected:
     virtual void NativeConstruct() override;
+    virtual void NativeDestruct() override;
+    virtual void NativeOnMouseEnter(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+    virtual void NativeOnMouseLeave(const FPointerEvent& InMouseEvent) override;
     virtual FReply NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
     virtual void NativeOnDragDetected(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent, UDragDropOperation*& OutOperation) override;
     virtual bool NativeOnDrop(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation) override;
-    virtual void NativeOnDragCancelled(const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation) override;
 
 private:
     UPROPERTY(meta = (BindWidget))
@@ -44,10 +65,38 @@ private:
     UPROPERTY()
     int32 ItemQuantity;
 
+    // Bag slot this widget displays, if any
+    TWeakObjectPtr<UBagComponent> BoundBag;
+    int32 BoundSlotIndex;
+
     // Drag operation data
-    bool bIsInDragOperation;
     FS_ItemInfo DraggedItemInfo;
     int32 DraggedQuantity;
 
+    // Cached UItemRegistrySubsystem index of the current item
+    int32 RegistryIndex;
+
+    // Icon atlas cell pinned while the icon is shown, INDEX_NONE when showing a standalone texture
+    int32 IconAtlasCell;
+
+    // Filter owned by the player's UInventoryWidgetPoolSubsystem, null when unfiltered
+    const FInventoryFilter* ActiveFilter;
+    float FilteredOutOpacity;
+    bool bMatchesFilter;
+
     void UpdateVisuals();
+
+    // Point the icon brush at the item's atlas cell, or its own texture when the atlas is full.
+    // Returns false if the item has no icon.
+    bool UpdateIconBrush();
+    void ReleaseIconCell();
+
+    // Show the pinned cell once it's drawn, hidden until then
+    void ApplyAtlasBrush();
+
+    // Point the shared tooltip at this slot's stack while it is hovered
+    void UpdateTooltip();
+    void SetFilterMatch(bool bMatches);
+
+    UInventoryRouterComponent* GetInventoryRouter() const;
 };
\ No newline at end of file
@@ -0,0 +1,80 @@
+// InventorySnapshot.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ItemInstance.h"
+
+class UItemInstanceSubsystem;
+
+// One slot as it was when the snapshot was taken
+struct FInventorySlotSnapshot
+{
+	FName ItemID;
+	int32 Count = 0;
+
+	// Index into the container snapshot's Instances, for unique items
+	int32 InstanceIndex = INDEX_NONE;
+};
+
+// Immutable copy of one container (a bag or the equipment). Containers keep their last snapshot and
+// hand the same one out until they change, so consecutive inventory snapshots share every container
+// that didn't change in between.
+struct LOTA_API FInventoryContainerSnapshot
+{
+	// Component name, stable for a given pawn setup
+	FName ContainerName;
+
+	// Item the bag was made from; none for equipment
+	FName BagItemID;
+
+	// Container revision the snapshot was built at
+	uint64 Revision = 0;
+
+	// Instance table revision, recorded only when the container holds instances
+	uint64 InstanceRevision = 0;
+
+	TArray<FInventorySlotSnapshot> Slots;
+	TArray<FItemInstanceData> Instances;
+
+	// Append a slot, copying its instance data (building only)
+	void AddSlot(FName ItemID, int32 Count, FItemInstanceHandle Instance, const UItemInstanceSubsystem* InstanceSubsystem);
+
+	// Whether this still matches a container now at Revision
+	bool IsCurrent(uint64 ContainerRevision, const UItemInstanceSubsystem* InstanceSubsystem) const;
+
+	friend FArchive& operator<<(FArchive& Ar, FInventoryContainerSnapshot& Snapshot);
+};
+
+using FInventoryContainerSnapshotRef = TSharedRef<const FInventoryContainerSnapshot, ESPMode::ThreadSafe>;
+
+// A slot whose contents differ between two snapshots
+struct FInventorySnapshotChange
+{
+	FName ContainerName;
+	int32 SlotIndex = INDEX_NONE;
+	FName OldItemID;
+	int32 OldCount = 0;
+	FName NewItemID;
+	int32 NewCount = 0;
+};
+
+// Versioned, immutable view of one pawn's inventory. Nothing in it points at a UObject, so it can
+// be serialized, diffed or inspected on any thread while the live inventory keeps changing.
+struct LOTA_API FInventorySnapshot
+{
+	// Bumped only when a container changed since the previous snapshot of the same pawn
+	uint64 Version = 0;
+	FDateTime CapturedAt;
+
+	TArray<FInventoryContainerSnapshotRef> Containers;
+
+	const FInventoryContainerSnapshot* FindContainer(FName ContainerName) const;
+
+	// Slot-level differences from From to To. Containers shared by both are skipped without a look.
+	static void Diff(const FInventorySnapshot& From, const FInventorySnapshot& To, TArray<FInventorySnapshotChange>& OutChanges);
+
+	void SaveToBytes(TArray<uint8>& OutBytes) const;
+	static TSharedPtr<const FInventorySnapshot, ESPMode::ThreadSafe> LoadFromBytes(const TArray<uint8>& Bytes);
+};
+
+using FInventorySnapshotPtr = TSharedPtr<const FInventorySnapshot, ESPMode::ThreadSafe>;
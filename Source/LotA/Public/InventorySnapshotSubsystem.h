@@ -0,0 +1,42 @@
+// InventorySnapshotSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InventorySnapshot.h"
+#include "Tasks/Task.h"
+#include "InventorySnapshotSubsystem.generated.h"
+
+class APawn;
+
+// Takes inventory snapshots for saving and inspection. Capturing only copies containers that changed
+// since their last snapshot; everything after that (serializing, writing, diffing) works on the
+// immutable snapshot and can run on a background task while gameplay goes on.
+UCLASS()
+class LOTA_API UInventorySnapshotSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UInventorySnapshotSubsystem* Get(const UObject* WorldContextObject);
+
+	// Snapshot of the pawn's bags and equipment. Returns the previous snapshot itself when nothing changed.
+	FInventorySnapshotPtr CaptureSnapshot(const APawn* Pawn);
+
+	// Most recent snapshot taken of the pawn, if any
+	FInventorySnapshotPtr GetLatestSnapshot(const APawn* Pawn) const { return LatestSnapshots.FindRef(Pawn); }
+
+	// Serialize and write a snapshot on a background task
+	UE::Tasks::TTask<bool> SaveSnapshotAsync(FInventorySnapshotPtr Snapshot, const FString& FilePath);
+
+	// Capture the pawn's inventory and write it to Saved/Inventory/<FileName>.bin in the background
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void SaveInventory(APawn* Pawn, const FString& FileName);
+
+	virtual void Deinitialize() override;
+
+private:
+	TMap<TWeakObjectPtr<const APawn>, FInventorySnapshotPtr> LatestSnapshots;
+	TArray<UE::Tasks::TTask<bool>> PendingSaves;
+	uint64 NextVersion = 1;
+};
@@ -0,0 +1,147 @@
+// InventoryStore.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ItemInstance.h"
+#include "InventoryStore.generated.h"
+
+// Names one inventory in an FInventoryStore. Stale once the inventory is destroyed, even if its
+// index is reused.
+USTRUCT(BlueprintType)
+struct LOTA_API FInventoryEntityHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Index = INDEX_NONE;
+
+	UPROPERTY()
+	uint32 Serial = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+
+	bool operator==(const FInventoryEntityHandle& Other) const { return Index == Other.Index && Serial == Other.Serial; }
+	bool operator!=(const FInventoryEntityHandle& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FInventoryEntityHandle& Handle) { return HashCombine(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Serial)); }
+};
+
+// One slot of a stored inventory, copied out of or into the store's columns
+struct FInventoryStoreSlot
+{
+	// UItemRegistrySubsystem index, INDEX_NONE when empty
+	int32 ItemIndex = INDEX_NONE;
+	int32 Count = 0;
+
+	// Set only for unique items
+	FItemInstanceHandle Instance;
+
+	bool IsEmpty() const { return Count <= 0; }
+};
+
+// Inventories as plain data. Bags keep their contents here behind their slot components; holders
+// that can't afford components at all, such as vendors, mobs carrying loot and caravans, use it
+// directly. Slots live in large chunks as separate columns of item indices, counts and instance
+// handles, so an inventory is a contiguous run of 16 bytes per slot and scans over counts or items
+// touch only the column they need. Each inventory occupies one run inside
+// a single chunk, so it holds at most SlotsPerChunk slots.
+//
+// Items are identified by registry index and the store never looks anything up, so callers pass the
+// stack limit. Instances in slots belong to the caller; the store only carries their handles.
+// Game thread only.
+class LOTA_API FInventoryStore
+{
+public:
+	static constexpr int32 SlotsPerChunk = 4096;
+
+	FInventoryStore() = default;
+	FInventoryStore(const FInventoryStore&) = delete;
+	FInventoryStore& operator=(const FInventoryStore&) = delete;
+
+	// New inventory of empty slots. Invalid handle if NumSlots exceeds SlotsPerChunk.
+	FInventoryEntityHandle CreateInventory(int32 NumSlots);
+
+	// Free an inventory's slots and invalidate its handle
+	void DestroyInventory(FInventoryEntityHandle Inventory);
+
+	bool IsValid(FInventoryEntityHandle Inventory) const { return FindEntity(Inventory) != nullptr; }
+
+	// Grow or shrink in place where the neighbouring slots allow, otherwise move to a new run.
+	// Fails without changing anything if a slot that would be cut off isn't empty.
+	bool ResizeInventory(FInventoryEntityHandle Inventory, int32 NewNumSlots);
+
+	int32 GetNumSlots(FInventoryEntityHandle Inventory) const;
+	int32 GetFreeSlotCount(FInventoryEntityHandle Inventory) const;
+
+	// Empty slot for stale handles and out of range indices
+	FInventoryStoreSlot GetSlot(FInventoryEntityHandle Inventory, int32 SlotIndex) const;
+
+	// Overwrite one slot; a slot with no count is stored empty
+	void SetSlot(FInventoryEntityHandle Inventory, int32 SlotIndex, const FInventoryStoreSlot& Slot);
+
+	// Add stackable items, topping up existing stacks before using empty slots. Returns how many didn't fit.
+	int32 AddItem(FInventoryEntityHandle Inventory, int32 ItemIndex, int32 Count, int32 MaxStack);
+
+	// Take up to Count from stacks of an item, last slot first; slots holding instances are left alone.
+	// Returns how many were removed.
+	int32 RemoveItem(FInventoryEntityHandle Inventory, int32 ItemIndex, int32 Count);
+
+	// Total count of an item across the inventory
+	int32 GetItemCount(FInventoryEntityHandle Inventory, int32 ItemIndex) const;
+
+	// Columns of one inventory, one element per slot. Empty for stale handles; invalidated by any
+	// create, destroy or resize.
+	TConstArrayView<int32> GetItemIndices(FInventoryEntityHandle Inventory) const;
+	TConstArrayView<int32> GetCounts(FInventoryEntityHandle Inventory) const;
+	TConstArrayView<FItemInstanceHandle> GetInstances(FInventoryEntityHandle Inventory) const;
+
+	int32 GetNumInventories() const { return Entities.Num() - FreeEntities.Num(); }
+	int32 GetNumChunks() const { return Chunks.Num(); }
+	SIZE_T GetAllocatedSize() const;
+
+	// Destroy every inventory and free every chunk
+	void Reset();
+
+private:
+	struct FSlotRun
+	{
+		int32 First = 0;
+		int32 Num = 0;
+	};
+
+	struct FChunk
+	{
+		TArray<int32> ItemIndices;
+		TArray<int32> Counts;
+		TArray<FItemInstanceHandle> Instances;
+
+		// Unused runs, sorted by First; neighbours are always merged
+		TArray<FSlotRun> FreeRuns;
+	};
+
+	struct FEntity
+	{
+		uint32 Serial = 0;
+		int32 Chunk = INDEX_NONE;
+		int32 First = 0;
+		int32 NumSlots = 0;
+		int32 OccupiedSlots = 0;
+		bool bAlive = false;
+	};
+
+	TArray<FChunk> Chunks;
+	TArray<FEntity> Entities;
+	TArray<int32> FreeEntities;
+
+	const FEntity* FindEntity(FInventoryEntityHandle Inventory) const;
+	FEntity* FindEntity(FInventoryEntityHandle Inventory) { return const_cast<FEntity*>(AsConst(*this).FindEntity(Inventory)); }
+
+	// First fit over the existing chunks, adding a chunk when none has room
+	bool AllocateRun(int32 NumSlots, int32& OutChunk, int32& OutFirst);
+
+	// Clear a run's slots and return it to its chunk's free list
+	void FreeRun(int32 ChunkIndex, int32 First, int32 NumSlots);
+
+	// Take the free run starting at First in place, if there is one at least NumSlots long
+	bool ClaimRunAt(int32 ChunkIndex, int32 First, int32 NumSlots);
+};
@@ -0,0 +1,46 @@
+// InventoryStoreSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "InventoryStore.h"
+#include "S_ItemInfo.h"
+#include "InventoryStoreSubsystem.generated.h"
+
+// The world's inventory store. Every bag keeps its contents here, with its slot components as views;
+// NPCs keep a bare handle instead of bag components. The helpers here resolve item definitions through
+// the item registry for callers that have them.
+UCLASS()
+class LOTA_API UInventoryStoreSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UInventoryStoreSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+
+	FInventoryStore& GetStore() { return Store; }
+	const FInventoryStore& GetStore() const { return Store; }
+
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	FInventoryEntityHandle CreateInventory(int32 NumSlots) { return Store.CreateInventory(NumSlots); }
+
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	void DestroyInventory(FInventoryEntityHandle Inventory) { Store.DestroyInventory(Inventory); }
+
+	// Add items by definition, registering it if needed. Stacks go up to Item.GetMaxStack(), which is
+	// what puts unique items one per slot; they get no instance here. Returns how many didn't fit.
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	int32 AddItem(FInventoryEntityHandle Inventory, const FS_ItemInfo& Item, int32 Count);
+
+	// Returns how many were removed
+	UFUNCTION(BlueprintCallable, Category = "Inventory")
+	int32 RemoveItem(FInventoryEntityHandle Inventory, FName ItemID, int32 Count);
+
+	UFUNCTION(BlueprintPure, Category = "Inventory")
+	int32 GetItemCount(FInventoryEntityHandle Inventory, FName ItemID) const;
+
+private:
+	FInventoryStore Store;
+};
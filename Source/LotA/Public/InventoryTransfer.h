@@ -0,0 +1,67 @@
+// InventoryTransfer.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InventoryTransfer.generated.h"
+
+class UActorComponent;
+class UBagComponent;
+class UEquipmentComponent;
+
+// What kind of place an item is moved from or to
+UENUM(BlueprintType)
+enum class EInventoryContainerKind : uint8
+{
+	None,
+	Bag,
+	Equipment,
+	World,
+	Trade,
+	Destroy
+};
+
+// Names a container without caring what widget shows it. Bag and Equipment handles point at the
+// component; World and Destroy need nothing else.
+USTRUCT(BlueprintType)
+struct LOTA_API FInventoryContainerHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, Category = "Inventory")
+	EInventoryContainerKind Kind = EInventoryContainerKind::None;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Inventory")
+	TObjectPtr<UActorComponent> Container = nullptr;
+
+	static FInventoryContainerHandle ForBag(UBagComponent* Bag);
+	static FInventoryContainerHandle ForEquipment(UEquipmentComponent* Equipment);
+	static FInventoryContainerHandle ForKind(EInventoryContainerKind InKind);
+
+	UBagComponent* GetBag() const;
+	UEquipmentComponent* GetEquipment() const;
+
+	bool IsValid() const { return Kind != EInventoryContainerKind::None; }
+
+	bool operator==(const FInventoryContainerHandle& Other) const { return Kind == Other.Kind && Container == Other.Container; }
+	bool operator!=(const FInventoryContainerHandle& Other) const { return !(*this == Other); }
+};
+
+// Everything a drop needs to know about what is being moved. For equipment, SlotIndex is the EEquipmentSlot value.
+USTRUCT(BlueprintType)
+struct LOTA_API FInventoryDragPayload
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, Category = "Inventory")
+	FInventoryContainerHandle Source;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Inventory")
+	int32 SlotIndex = INDEX_NONE;
+
+	// Expected item, so a drop that raced a server change is rejected instead of moving something else
+	UPROPERTY(BlueprintReadWrite, Category = "Inventory")
+	FName ItemID;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Inventory")
+	int32 Count = 0;
+};
@@ -3,6 +3,7 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "ItemFilter.h"
 #include "InventoryWidget.generated.h"
 
 class UUniformGridPanel;
@@ -22,8 +23,21 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Inventory")
 	void AddTestItem(int32 SlotIndex);
 
+	// Dim slots that don't match the query/type mask, here and in every open bag window of this
+	// player. Meant to be called on every keystroke.
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Filter")
+	void SetFilter(const FString& Query, UPARAM(meta = (Bitmask, BitmaskEnum = "/Script/LotA.EItemType")) int32 TypeMask);
+
+	UFUNCTION(BlueprintCallable, Category = "Inventory|Filter")
+	void ClearFilter();
+
+	// Number of slots matching the current filter
+	UFUNCTION(BlueprintPure, Category = "Inventory|Filter")
+	int32 GetNumFilterMatches() const { return NumFilterMatches; }
+
 protected:
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 
 	// Grid panel to hold slots
 	UPROPERTY(meta = (BindWidget))
@@ -37,6 +51,13 @@ protected:
 	int32 NumRows;
 	int32 NumColumns;
 
+	// Opacity for slots that don't match the filter
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inventory|Filter", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float FilteredOutOpacity;
+
 private:
+	int32 NumFilterMatches;
+
 	void CreateInventorySlots();
+	void HandleFilterChanged(EItemFilterChange Change);
 };
\ No newline at end of file
@@ -0,0 +1,60 @@
+// InventoryWidgetPoolSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "ItemFilter.h"
+#include "InventoryWidgetPoolSubsystem.generated.h"
+
+class APlayerController;
+class UInventorySlotWidget;
+
+// Shared pool of inventory slot widgets for one local player. Bag windows take their slots from here
+// and hand them back when they close or shrink, so opening and closing bags reuses the same widgets
+// (and their Slate trees) instead of constructing new ones each time.
+//
+// It also holds the player's item filter, so every open inventory window dims the same slots.
+// Windows apply it to the slot widgets they acquire and re-apply it on OnFilterChanged.
+UCLASS()
+class LOTA_API UInventoryWidgetPoolSubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UInventoryWidgetPoolSubsystem* Get(const APlayerController* PlayerController);
+
+	// Get an empty slot widget, reusing a pooled one when available
+	UInventorySlotWidget* AcquireSlotWidget(APlayerController* OwningPlayer);
+
+	// Detach a slot widget from its parent, clear it and keep it for reuse
+	void ReleaseSlotWidget(UInventorySlotWidget* SlotWidget);
+
+	// Update the shared filter and tell open windows how it changed
+	EItemFilterChange SetFilter(const FString& Query, uint8 TypeMask);
+
+	// The shared filter, null when it doesn't exclude anything
+	const FInventoryFilter* GetActiveFilter() const { return ActiveFilter.IsActive() ? &ActiveFilter : nullptr; }
+
+	// Re-test SlotWidgets after a filter change, skipping the ones Change can't affect. Returns the number matching.
+	int32 ApplyFilter(TConstArrayView<UInventorySlotWidget*> SlotWidgets, EItemFilterChange Change, float FilteredOutOpacity) const;
+
+	DECLARE_MULTICAST_DELEGATE_OneParam(FOnFilterChanged, EItemFilterChange /*Change*/);
+	FOnFilterChanged OnFilterChanged;
+
+	// Free widgets kept before released ones are left for garbage collection instead
+	static constexpr int32 MaxPooledWidgets = 256;
+
+	virtual void Deinitialize() override;
+
+private:
+	UPROPERTY()
+	TArray<TObjectPtr<UInventorySlotWidget>> FreeWidgets;
+
+	// Slate widgets of pooled entries; holding them keeps TakeWidget() from rebuilding on reuse
+	TArray<TSharedPtr<SWidget>> CachedSlateWidgets;
+
+	UPROPERTY()
+	TSubclassOf<UInventorySlotWidget> SlotWidgetClass;
+
+	FInventoryFilter ActiveFilter;
+};
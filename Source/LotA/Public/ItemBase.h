@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
 #include "S_ItemInfo.h"
+#include "ItemInstance.h"
 #include "ItemBase.generated.h"
 
 UCLASS()
@@ -18,8 +19,20 @@ public:
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item")
 	FS_ItemInfo ItemDetails;
 
+	// How many of the item this pickup holds
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item", meta = (ClampMin = "1"))
+	int32 StackCount;
+
+	// Instance of a dropped unique item, owned by this pickup until something takes it
+	UPROPERTY(BlueprintReadOnly, Category = "Item")
+	FItemInstanceHandle InstanceHandle;
+
+	// Hand the instance to whatever took the item, so destroying the pickup leaves it alive
+	FItemInstanceHandle TakeInstance();
+
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 public:
 	virtual void Tick(float DeltaTime) override;
@@ -0,0 +1,23 @@
+// ItemDefinitionCookCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ItemDefinitionCookCommandlet.generated.h"
+
+// Validates every item definition (the ItemDetails defaults of AItemBase Blueprints), checks that
+// ItemIDs are unique and cooks them into the table the item registry loads at startup. Transient
+// classes, such as ALootBenchItem, are skipped. Returns non-zero if any definition is invalid, in
+// which case nothing is written, or if the written table doesn't read back.
+//
+// Usage: UnrealEditor-Cmd LotA -run=ItemDefinitionCook [-Out=<file>] [-ValidateOnly]
+UCLASS()
+class LOTA_API UItemDefinitionCookCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UItemDefinitionCookCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
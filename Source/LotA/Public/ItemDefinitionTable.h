@@ -0,0 +1,65 @@
+// ItemDefinitionTable.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "S_ItemInfo.h"
+
+// One item definition as stored in the cooked table. Strings live in the table's string pool and
+// are referenced by index, so repeated icon folders and cooldown groups are stored once.
+struct FCookedItemDefinition
+{
+	FText ItemName;
+	FText ItemDescription;
+	int32 IconPathIndex = INDEX_NONE;
+	int32 CooldownGroupIndex = INDEX_NONE;
+	float Weight = 0.0f;
+	int32 MaxStackSize = 1;
+	int32 BagSlots = 0;
+	float WeightReductionPercentage = 0.0f;
+	float CooldownSeconds = 0.0f;
+	float MaxDurability = 0.0f;
+	FItemStats Stats;
+	EItemType ItemType = EItemType::General;
+	EEquipmentSlot EquipSlot = EEquipmentSlot::None;
+	bool bUniqueInstance = false;
+
+	friend FArchive& operator<<(FArchive& Ar, FCookedItemDefinition& Definition);
+};
+
+// Every item definition in the game, cooked by the ItemDefinitionCook commandlet into one file that
+// the item registry reads with a single load at startup. ItemIDs[i] names Definitions[i].
+struct LOTA_API FItemDefinitionTable
+{
+	static constexpr uint32 ExpectedMagic = 0x4449414C; // "LAID"
+	static constexpr uint32 CurrentVersion = 1;
+
+	TArray<FName> ItemIDs;
+	TArray<FCookedItemDefinition> Definitions;
+	TArray<FString> Strings;
+
+	// Location the game loads the table from
+	static FString GetDefaultPath();
+
+	// Check a definition for values the inventory can't work with. Problems are appended as messages.
+	static bool ValidateDefinition(const FS_ItemInfo& Item, TArray<FString>& OutProblems);
+
+	// Intern Item and return its index. The icon is stored as a soft path and not loaded.
+	int32 Add(const FS_ItemInfo& Item);
+
+	int32 Num() const { return ItemIDs.Num(); }
+
+	// Rebuild the runtime definition. ItemIcon is left null; see GetIconPath.
+	FS_ItemInfo ToItemInfo(int32 Index) const;
+	FSoftObjectPath GetIconPath(int32 Index) const;
+
+	bool SaveToFile(const FString& Path) const;
+	bool LoadFromFile(const FString& Path);
+
+	void Serialize(FArchive& Ar);
+
+private:
+	TMap<FString, int32> StringIndices;
+
+	int32 InternString(const FString& String);
+	const FString* FindString(int32 Index) const { return Strings.IsValidIndex(Index) ? &Strings[Index] : nullptr; }
+};
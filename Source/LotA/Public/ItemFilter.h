@@ -0,0 +1,46 @@
+// ItemFilter.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "S_ItemInfo.h"
+
+struct FItemRegistryEntry;
+
+// How a new filter relates to the previous one, so views only re-test the slots that can change
+enum class EItemFilterChange : uint8
+{
+	None,
+	Narrowed,	// Only current matches can stop matching
+	Widened,	// Only current non-matches can start matching
+	Replaced	// Everything needs re-testing
+};
+
+// Text + type filter over item definitions. Matching runs against the precomputed
+// search keys in UItemRegistrySubsystem, so testing a slot never allocates.
+struct LOTA_API FInventoryFilter
+{
+	FInventoryFilter();
+
+	// Update the filter. The query buffers are reused, so typing does not allocate.
+	EItemFilterChange Set(const FString& InQuery, uint8 InTypeMask);
+
+	void Reset() { Set(FString(), ItemTypeMask::All); }
+
+	// Whether the filter excludes anything at all
+	bool IsActive() const { return !Query.IsEmpty() || TypeMask != ItemTypeMask::All; }
+
+	// Test a registered item. Empty slots pass in null and only match an inactive filter.
+	bool Matches(const FItemRegistryEntry* Entry) const;
+
+	const FString& GetQuery() const { return Query; }
+	uint8 GetTypeMask() const { return TypeMask; }
+
+private:
+	// Lowercase query
+	FString Query;
+
+	// Previous query, kept to detect narrowing/widening
+	FString PreviousQuery;
+
+	uint8 TypeMask;
+};
@@ -0,0 +1,47 @@
+// ItemInspectComponent.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "ItemInstance.h"
+#include "ItemInspectComponent.generated.h"
+
+class APawn;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnItemInstanceInspectedDynamic, FItemInstanceHandle, Handle, const FItemInstanceData&, Data);
+
+// Fetches per-instance data (durability, rolled stats, ...) on demand. Slots only replicate the
+// instance handle; the full data is sent to the owning client when it inspects the item, typically
+// when a tooltip opens, and cached for a short while so hovering back and forth costs nothing.
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class LOTA_API UItemInspectComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UItemInspectComponent();
+
+	// Request the data for an instance. Fires OnInstanceInspected straight away if the cache is fresh,
+	// otherwise once the server answers.
+	UFUNCTION(BlueprintCallable, Category = "Item Instance")
+	void InspectInstance(FItemInstanceHandle Handle);
+
+	UPROPERTY(BlueprintAssignable, Category = "Item Instance")
+	FOnItemInstanceInspectedDynamic OnInstanceInspected;
+
+	// How long received data is trusted before asking the server again
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Instance", meta = (ClampMin = "0.0"))
+	float InspectCacheSeconds;
+
+private:
+	UFUNCTION(Server, Reliable)
+	void ServerInspectInstance(FItemInstanceHandle Handle);
+
+	UFUNCTION(Client, Reliable)
+	void ClientReceiveInstance(FItemInstanceHandle Handle, const FItemInstanceData& Data);
+
+	// Whether the handle is in one of the pawn's bags or equipment slots
+	bool IsOwnedInstance(FItemInstanceHandle Handle) const;
+
+	APawn* GetControlledPawn() const;
+};
@@ -0,0 +1,72 @@
+// ItemInstance.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "S_ItemInfo.h"
+#include "ItemInstance.generated.h"
+
+// Points at one unique item in the world's instance table. Slots holding stackable items leave it
+// invalid, so stacks carry eight bytes and nothing else. Serial catches handles to recycled entries.
+USTRUCT(BlueprintType)
+struct LOTA_API FItemInstanceHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Index = INDEX_NONE;
+
+	UPROPERTY()
+	uint32 Serial = 0;
+
+	bool IsValid() const { return Index != INDEX_NONE; }
+
+	bool operator==(const FItemInstanceHandle& Other) const { return Index == Other.Index && Serial == Other.Serial; }
+	bool operator!=(const FItemInstanceHandle& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FItemInstanceHandle& Handle) { return HashCombine(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Serial)); }
+};
+
+// Open-ended per-instance value (enchant level, kill count, ...) for things too rare to get a field
+USTRUCT(BlueprintType)
+struct LOTA_API FItemInstanceProperty
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Item Instance")
+	FName Key;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Item Instance")
+	float Value = 0.0f;
+};
+
+// Everything that makes one copy of an item different from another
+USTRUCT(BlueprintType)
+struct LOTA_API FItemInstanceData
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Item Instance")
+	FGuid Guid;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Item Instance")
+	FName ItemID;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Item Instance")
+	float Durability = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Item Instance")
+	float MaxDurability = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Item Instance")
+	bool bSoulbound = false;
+
+	// Added on top of the definition's Stats
+	UPROPERTY(BlueprintReadOnly, Category = "Item Instance")
+	FItemStats RolledStats;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Item Instance")
+	TArray<FItemInstanceProperty> Properties;
+
+	float GetProperty(FName Key, float DefaultValue = 0.0f) const;
+	void SetProperty(FName Key, float Value);
+};
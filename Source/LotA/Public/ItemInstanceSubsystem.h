@@ -0,0 +1,83 @@
+// ItemInstanceSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ItemInstance.h"
+#include "ItemInstanceSubsystem.generated.h"
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnItemInstanceInspected, FItemInstanceHandle /*Handle*/, const FItemInstanceData& /*Data*/);
+
+// Sparse table of unique item instances. The server owns the real table and hands out handles that
+// slots, equipment and world drops store. Clients only ever see the instances their player inspected,
+// which are kept in a cache of at most MaxInspectedInstances rather than replicated with every slot.
+UCLASS(Config = Game)
+class LOTA_API UItemInstanceSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UItemInstanceSubsystem();
+
+	static UItemInstanceSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	// Create a fresh instance of Item (authority only). Equipment rolls its RolledStats here.
+	FItemInstanceHandle CreateInstance(const FS_ItemInfo& Item);
+
+	// Destroy an instance once its item leaves the game; stale or invalid handles are ignored
+	void ReleaseInstance(FItemInstanceHandle Handle);
+
+	const FItemInstanceData* FindInstance(FItemInstanceHandle Handle) const;
+
+	// Counts as a change to the instance, so cached inventory snapshots holding it are rebuilt
+	FItemInstanceData* FindInstanceMutable(FItemInstanceHandle Handle);
+	FItemInstanceHandle FindByGuid(const FGuid& Guid) const;
+
+	int32 GetNumInstances() const { return Instances.Num(); }
+
+	// Bumped whenever instance data may have been edited in place
+	uint64 GetRevision() const { return Revision; }
+
+	// Client side: data the server sent for an inspected instance, null if never seen or expired
+	const FItemInstanceData* FindInspected(FItemInstanceHandle Handle, double MaxAgeSeconds) const;
+	void CacheInspected(FItemInstanceHandle Handle, const FItemInstanceData& Data);
+
+	FOnItemInstanceInspected OnInstanceInspected;
+
+	virtual void Deinitialize() override;
+
+protected:
+	// Each non-zero stat of a new equipment instance is shifted by up to this fraction of the base value
+	UPROPERTY(Config)
+	float StatRollFraction;
+
+	// Inspected instances a client keeps; the least recently used one goes when a new one arrives
+	UPROPERTY(Config)
+	int32 MaxInspectedInstances;
+
+private:
+	struct FInstanceEntry
+	{
+		uint32 Serial = 0;
+		FItemInstanceData Data;
+	};
+
+	struct FInspectedEntry
+	{
+		FItemInstanceData Data;
+		double ReceivedTime = 0.0;
+		mutable double LastUsedTime = 0.0;
+	};
+
+	TSparseArray<FInstanceEntry> Instances;
+	TMap<FGuid, int32> IndexByGuid;
+	uint32 NextSerial = 1;
+	uint64 Revision = 0;
+	FRandomStream RollStream;
+
+	FItemStats RollStats(const FItemStats& Base);
+
+	TMap<FItemInstanceHandle, FInspectedEntry> InspectedCache;
+};
@@ -0,0 +1,98 @@
+// ItemRegistrySubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "S_ItemInfo.h"
+#include "ItemRegistrySubsystem.generated.h"
+
+struct FStreamableHandle;
+
+// Per-definition data derived once when an item is first registered
+USTRUCT()
+struct LOTA_API FItemRegistryEntry
+{
+	GENERATED_BODY()
+
+	// The item definition as registered. A property so GC sees its icon.
+	UPROPERTY()
+	FS_ItemInfo Info;
+
+	// Lowercase display name used for text search
+	FString SearchKey;
+
+	// Single bit for the item's EItemType, see ItemTypeMask
+	uint8 TypeMask = 0;
+
+	// Icon of a definition that came from the cooked table, streamed in on demand by RequestIcon
+	FSoftObjectPath IconPath;
+
+	// A live definition has been checked against this cooked entry
+	bool bLiveChecked = false;
+};
+
+// Registry of every item definition seen this session, keyed by ItemID. Starts out with the cooked
+// definition table, so every item is known without loading its Blueprint. Entries are never removed,
+// so indices stay valid for the lifetime of the engine.
+UCLASS()
+class LOTA_API UItemRegistrySubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	// Convenience accessor, returns null before the engine is up
+	static UItemRegistrySubsystem* Get();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Register an item definition and return its index. Re-registering a known ID is a map lookup,
+	// except that a live definition differing from its cooked entry replaces it with a warning.
+	int32 RegisterItem(const FS_ItemInfo& ItemInfo);
+
+	// Find the index of a registered item, INDEX_NONE if unknown
+	int32 FindItemIndex(FName ItemID) const;
+
+	const FItemRegistryEntry* GetEntry(int32 Index) const { return Entries.IsValidIndex(Index) ? &Entries[Index] : nullptr; }
+	const FItemRegistryEntry* FindEntry(FName ItemID) const { return GetEntry(FindItemIndex(ItemID)); }
+
+	int32 Num() const { return Entries.Num(); }
+
+	// Entries below this index came from the cooked table and have the same index in every process
+	// running the same build, so replication can send the index instead of the ItemID
+	int32 GetNumNetIndexed() const { return NumCookedEntries; }
+
+	// The entry's icon if it is loaded. Otherwise start streaming it and return null; OnLoaded runs
+	// once it is in Info.ItemIcon. Cooked definitions start without one.
+	UTexture2D* RequestIcon(int32 Index, FSimpleDelegate OnLoaded = FSimpleDelegate());
+
+private:
+	UPROPERTY()
+	TArray<FItemRegistryEntry> Entries;
+	TMap<FName, int32> IndexByID;
+	int32 NumCookedEntries = 0;
+
+	struct FIconRequest
+	{
+		TSharedPtr<FStreamableHandle> Handle;
+		TArray<FSimpleDelegate> Waiters;
+	};
+
+	// In-flight icon loads by entry index
+	TMap<int32, FIconRequest> IconRequests;
+
+	FDelegateHandle CultureChangedHandle;
+
+	// Register everything in the cooked definition table, if one has been built
+	void LoadCookedDefinitions();
+
+	static void BuildSearchKey(FItemRegistryEntry& Entry);
+
+	// Whether two definitions of one ItemID disagree on anything the cooked table stores
+	static bool DefinitionsDiffer(const FS_ItemInfo& A, const FS_ItemInfo& B);
+
+	void HandleIconLoaded(int32 Index);
+
+	// Display names are localized, so search keys follow the active culture
+	void HandleCultureChanged();
+};
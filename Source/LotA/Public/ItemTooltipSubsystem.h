@@ -0,0 +1,52 @@
+// ItemTooltipSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "S_ItemInfo.h"
+#include "ItemTooltipSubsystem.generated.h"
+
+class APlayerController;
+class UItemTooltipWidget;
+
+// Tooltips for item slots of one local player. The text describing an item definition is formatted
+// once per item and culture and cached; every slot shares a single tooltip widget that is filled in
+// when hovered.
+UCLASS(Config = Game)
+class LOTA_API UItemTooltipSubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UItemTooltipSubsystem();
+
+	static UItemTooltipSubsystem* Get(const APlayerController* PlayerController);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Fill the shared tooltip widget for a stack and return it, null if the widget class is missing.
+	// WeightReductionPercentage is that of the bag holding the stack.
+	UItemTooltipWidget* GetTooltipFor(APlayerController* OwningPlayer, const FS_ItemInfo& Item, int32 Quantity, float WeightReductionPercentage = 0.0f);
+
+	// Name, description and definition stats, formatted on first use
+	const FText& GetDefinitionText(const FS_ItemInfo& Item);
+
+protected:
+	// Loaded on first hover, so players who never open the inventory don't pay for it
+	UPROPERTY(Config)
+	TSoftClassPtr<UItemTooltipWidget> TooltipWidgetClass;
+
+private:
+	TMap<FName, FText> DefinitionTexts;
+
+	UPROPERTY()
+	TObjectPtr<UItemTooltipWidget> TooltipWidget;
+
+	FDelegateHandle CultureChangedHandle;
+
+	static FText BuildDefinitionText(const FS_ItemInfo& Item);
+
+	// Cached text is in the old language
+	void HandleCultureChanged();
+};
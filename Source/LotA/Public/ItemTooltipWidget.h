@@ -0,0 +1,40 @@
+// ItemTooltipWidget.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "ItemTooltipWidget.generated.h"
+
+class UTextBlock;
+
+// The one tooltip widget a local player uses for every item. The definition text arrives already
+// formatted; the stack weight line is the only thing formatted here, and only when it changes.
+UCLASS()
+class LOTA_API UItemTooltipWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+	UItemTooltipWidget(const FObjectInitializer& ObjectInitializer);
+
+	// Show cached definition text. Passing the same cached FText again is a no-op.
+	void SetDefinitionText(const FText& InText);
+
+	// Total weight of the hovered stack; hidden for single items
+	void SetStackWeight(float TotalWeight, int32 Quantity);
+
+	// Forget what is shown so the next Set calls reformat, e.g. after the culture changed
+	void ResetShownText();
+
+protected:
+	UPROPERTY(meta = (BindWidget))
+	UTextBlock* DefinitionText;
+
+	UPROPERTY(meta = (BindWidgetOptional))
+	UTextBlock* StackWeightText;
+
+private:
+	FText ShownDefinitionText;
+	float ShownStackWeight;
+	bool bStackWeightVisible;
+};
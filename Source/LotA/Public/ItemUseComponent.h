@@ -0,0 +1,91 @@
+// ItemUseComponent.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "S_ItemInfo.h"
+#include "CooldownWheel.h"
+#include "ItemUseComponent.generated.h"
+
+class UBagComponent;
+class UInventoryRegistryComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnItemUsed, const FS_ItemInfo&, Item);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnCooldownStarted, FName, CooldownGroup, float, Duration);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnCooldownEnded, FName, CooldownGroup);
+
+// Uses consumables on behalf of a player. Lives on the player controller so it has an owning
+// connection for its RPCs; the bags it consumes from live on the controlled pawn.
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class LOTA_API UItemUseComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UItemUseComponent();
+
+	// Use the item in a specific bag slot. Safe to call on the owning client.
+	UFUNCTION(BlueprintCallable, Category = "Item Use")
+	void UseItemInSlot(UBagComponent* Bag, int32 SlotIndex);
+
+	// Use the first stack of an item wherever it is, e.g. from a hotbar. Safe to call on the owning client.
+	UFUNCTION(BlueprintCallable, Category = "Item Use")
+	void UseItemByID(FName ItemID);
+
+	UFUNCTION(BlueprintPure, Category = "Item Use")
+	bool IsOnCooldown(FName CooldownGroup) const;
+
+	UFUNCTION(BlueprintPure, Category = "Item Use")
+	float GetCooldownRemaining(FName CooldownGroup) const;
+
+	// Fired on the server after an item was consumed; gameplay effects hook in here
+	UPROPERTY(BlueprintAssignable, Category = "Item Use")
+	FOnItemUsed OnItemUsed;
+
+	// Fired on the server and the owning client
+	UPROPERTY(BlueprintAssignable, Category = "Item Use")
+	FOnCooldownStarted OnCooldownStarted;
+
+	UPROPERTY(BlueprintAssignable, Category = "Item Use")
+	FOnCooldownEnded OnCooldownEnded;
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	// Where an item ID was last found, so repeated hotbar presses skip the bag scan
+	struct FItemSlotRef
+	{
+		TWeakObjectPtr<UBagComponent> Bag;
+		int32 SlotIndex = INDEX_NONE;
+	};
+
+	TMap<FName, FItemSlotRef> ItemLocationCache;
+
+	FCooldownWheel Cooldowns;
+	FTimerHandle CooldownTickHandle;
+
+	// The bag goes by its registry handle, which also limits the request to the player's own bags
+	UFUNCTION(Server, Reliable)
+	void ServerUseItemInSlot(int32 ContainerHandle, int32 SlotIndex);
+
+	UFUNCTION(Server, Reliable)
+	void ServerUseItemByID(FName ItemID);
+
+	UFUNCTION(Client, Reliable)
+	void ClientCooldownStarted(FName CooldownGroup, float Duration);
+
+	// Consume one item from the slot if it's usable; authority only
+	bool TryUseSlot(UBagComponent* Bag, int32 SlotIndex);
+
+	// Resolve an item ID to a slot through the cache, rescanning the pawn's bags on a miss
+	bool FindItemSlot(FName ItemID, UBagComponent*& OutBag, int32& OutSlotIndex);
+
+	// Whether a bag belongs to the pawn this component's controller possesses
+	bool OwnsBag(const UBagComponent* Bag) const;
+
+	UInventoryRegistryComponent* GetRegistry() const;
+
+	void StartCooldown(FName CooldownGroup, float Duration);
+	void TickCooldowns();
+};
@@ -0,0 +1,33 @@
+// LootBenchCommandlet.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ItemBase.h"
+#include "LootBenchCommandlet.generated.h"
+
+// Measures loot rolls per second. Rolls the given table, or a generated one with nested tables and
+// many weighted entries, in batches and reports throughput and drops per kill.
+//
+// Usage: UnrealEditor-Cmd LotA -run=LootBench [-Table=/Game/Path/LootTable] [-Kills=1000000]
+//        [-Batch=1000] [-Entries=200] [-Seed=1]
+UCLASS()
+class LOTA_API ULootBenchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	ULootBenchCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
+
+// What the synthetic table drops. Its own class so the bench never edits AItemBase's defaults.
+UCLASS(Transient, NotPlaceable, HideDropdown)
+class LOTA_API ALootBenchItem : public AItemBase
+{
+	GENERATED_BODY()
+
+public:
+	ALootBenchItem();
+};
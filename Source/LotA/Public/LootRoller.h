@@ -0,0 +1,80 @@
+// LootRoller.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class ULootTable;
+
+// One rolled stack. The full definition is in UItemRegistrySubsystem under ItemID; the roller
+// registers every item it compiles.
+struct FLootDrop
+{
+	FName ItemID;
+	int32 MaxStack = 1;
+	int32 Count = 0;
+
+	// Which kill of a batch produced the drop
+	int32 KillIndex = 0;
+};
+
+// Rolls loot tables. Each table is compiled once into a Walker alias table over its weighted
+// entries, so a weighted draw is one random index and one comparison no matter how many entries
+// the table has. Nested tables are compiled alongside and referenced by index.
+//
+// The roller doesn't keep tables alive; whoever owns it holds the tables it compiles, see ULootSubsystem.
+class LOTA_API FLootRoller
+{
+public:
+	// Deepest chain of nested tables followed; cycles are rejected when compiling
+	static constexpr int32 MaxNestingDepth = 8;
+
+	// Roll Table once per kill, appending to OutDrops. Returns the number of drops added.
+	int32 RollBatch(const ULootTable* Table, int32 NumKills, FRandomStream& Stream, TArray<FLootDrop>& OutDrops);
+
+	// Split form of RollBatch for rolling off the game thread: compile on the game thread, then
+	// RollCompiled only reads the compiled tables and may run on any thread while nothing compiles.
+	int32 CompileTable(const ULootTable* Table);
+	int32 RollCompiled(int32 TableIndex, int32 NumKills, FRandomStream& Stream, TArray<FLootDrop>& OutDrops) const;
+
+	// Forget compiled tables, e.g. after an edit. Invalidate returns whether anything was forgotten.
+	void Reset();
+	bool Invalidate(const ULootTable* Table);
+
+	int32 GetNumCompiledTables() const { return CompiledIndices.Num(); }
+
+private:
+	struct FCompiledEntry
+	{
+		// None for entries that drop nothing
+		FName ItemID;
+		int32 MaxStack = 1;
+		int32 NestedTable = INDEX_NONE;
+		int32 MinQuantity = 1;
+		int32 MaxQuantity = 1;
+	};
+
+	struct FCompiledTable
+	{
+		TArray<FCompiledEntry> Guaranteed;
+		TArray<FCompiledEntry> Weighted;
+
+		// Alias table over Weighted: column i is kept with Probability[i], otherwise Alias[i] is used
+		TArray<float> Probability;
+		TArray<int32> Alias;
+
+		int32 MinRolls = 0;
+		int32 MaxRolls = 0;
+	};
+
+	TArray<FCompiledTable> CompiledTables;
+	TMap<TObjectKey<ULootTable>, int32> CompiledIndices;
+
+	// Compile Table and any nested tables, returning its index or INDEX_NONE for a cycle
+	int32 Compile(const ULootTable* Table, TArray<const ULootTable*, TInlineAllocator<MaxNestingDepth>>& Path);
+
+	static void BuildAliasTable(TConstArrayView<float> Weights, TArray<float>& OutProbability, TArray<int32>& OutAlias);
+
+	void RollTable(int32 TableIndex, int32 KillIndex, int32 Depth, FRandomStream& Stream, TArray<FLootDrop>& OutDrops) const;
+	void EmitEntry(const FCompiledEntry& Entry, int32 KillIndex, int32 Depth, FRandomStream& Stream, TArray<FLootDrop>& OutDrops) const;
+};
@@ -0,0 +1,68 @@
+// LootSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "LootRoller.h"
+#include "InventoryStore.h"
+#include "LootSubsystem.generated.h"
+
+class AItemBase;
+class APlayerController;
+class UBagComponent;
+class ULootTable;
+
+// Server-side loot for one world: rolls tables for batches of kills and delivers the results,
+// either as pickups at the kill locations or straight into a bag.
+UCLASS()
+class LOTA_API ULootSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static ULootSubsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	// Roll Table for NumKills kills; see FLootRoller::RollBatch
+	int32 RollBatch(const ULootTable* Table, int32 NumKills, TArray<FLootDrop>& OutDrops);
+
+	// Spawn a pickup per drop at the location of the kill that produced it. Unique items get one
+	// pickup each, since every copy is its own instance.
+	void SpawnWorldDrops(TConstArrayView<FLootDrop> Drops, TConstArrayView<FVector> KillLocations, TSubclassOf<AItemBase> DropClass);
+
+	// Put drops into a bag, recorded as items created. Whatever doesn't fit goes to OutLeftovers.
+	void GrantDrops(TConstArrayView<FLootDrop> Drops, UBagComponent* Bag, TArray<FLootDrop>& OutLeftovers);
+
+	// Put drops into an inventory in the world's store, for NPCs that carry loot without bags.
+	// Whatever doesn't fit goes to OutLeftovers.
+	void GrantDrops(TConstArrayView<FLootDrop> Drops, FInventoryEntityHandle Inventory, TArray<FLootDrop>& OutLeftovers);
+
+	// Roll NumKills kills for a player and put the result in Bag, through the player's inventory
+	// command queue. The rolling runs on a worker thread; whatever doesn't fit drops at the pawn.
+	void QueueGrant(APlayerController* Player, const ULootTable* Table, int32 NumKills, UBagComponent* Bag, TSubclassOf<AItemBase> LeftoverDropClass);
+
+	// Roll one kill and drop the result at Location. Blueprint entry point for simple cases.
+	UFUNCTION(BlueprintCallable, Category = "Loot")
+	void RollAndSpawn(const ULootTable* Table, FVector Location);
+
+private:
+	friend class FLootGrantCommand;
+
+	FLootRoller Roller;
+	FRandomStream Stream;
+
+	// Tables the roller has compiled, kept alive so its entries never outlive their source. Nested
+	// tables are held by their parents.
+	UPROPERTY()
+	TSet<TObjectPtr<const ULootTable>> CompiledTables;
+
+	// Compile through the roller and hold on to the table
+	int32 CompileTable(const ULootTable* Table);
+
+	// Registered definition of a drop, null if the registry doesn't know it
+	static const FS_ItemInfo* FindDropItem(const FLootDrop& Drop);
+
+	FDelegateHandle TableChangedHandle;
+};
@@ -0,0 +1,66 @@
+// LootTable.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "LootTable.generated.h"
+
+class AItemBase;
+class ULootTable;
+
+// One possible outcome of a loot roll: an item, a nested table to roll instead, or (with neither
+// set) nothing at all, which is how "no drop" chances are expressed.
+USTRUCT(BlueprintType)
+struct LOTA_API FLootEntry
+{
+	GENERATED_BODY()
+
+	// Item whose ItemDetails defaults are dropped
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Loot")
+	TSubclassOf<AItemBase> ItemClass;
+
+	// Rolled in place of an item when set
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Loot")
+	TObjectPtr<ULootTable> NestedTable;
+
+	// Relative chance among the table's weighted entries; ignored for guaranteed drops
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Loot", meta = (ClampMin = "0.0"))
+	float Weight = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Loot", meta = (ClampMin = "1"))
+	int32 MinQuantity = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Loot", meta = (ClampMin = "1"))
+	int32 MaxQuantity = 1;
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnLootTableChanged, const ULootTable*);
+
+// What a kill can drop. Tables are compiled into alias tables by FLootRoller before rolling.
+UCLASS(BlueprintType)
+class LOTA_API ULootTable : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	// Dropped on every roll of this table
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Loot")
+	TArray<FLootEntry> GuaranteedDrops;
+
+	// Drawn from by weight, a number of times between MinRolls and MaxRolls
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Loot")
+	TArray<FLootEntry> WeightedDrops;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Loot", meta = (ClampMin = "0"))
+	int32 MinRolls = 1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Loot", meta = (ClampMin = "0"))
+	int32 MaxRolls = 1;
+
+	// Lets compiled copies be thrown away when a table is edited
+	static FOnLootTableChanged OnLootTableChanged;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+};
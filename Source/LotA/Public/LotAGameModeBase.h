@@ -4,7 +4,13 @@
 #include "GameFramework/GameModeBase.h"
 #include "LotAGameModeBase.generated.h"
 
-UCLASS()
+class UInventoryWidget;
+struct FStreamableHandle;
+
+// Classes are soft references read from config ([/Script/LotA.LotAGameModeBase] in DefaultGame.ini),
+// so building the class default object loads nothing. The pawn class is streamed in during InitGame;
+// UI classes are only resolved where UI is shown.
+UCLASS(Config = Game)
 class LOTA_API ALotAGameModeBase : public AGameModeBase
 {
 	GENERATED_BODY()
@@ -12,12 +18,25 @@ class LOTA_API ALotAGameModeBase : public AGameModeBase
 public:
 	ALotAGameModeBase();
 
+	virtual UClass* GetDefaultPawnClassForController_Implementation(AController* InController) override;
+
+	// Loads the inventory widget class on first use. Null on dedicated servers.
+	UFUNCTION(BlueprintPure, Category = "UI")
+	TSubclassOf<UInventoryWidget> GetInventoryWidgetClass() const;
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void InitGame(const FString& MapName, const FString& Options, FString& ErrorMessage) override;
 
+	// Pawn spawned for players unless the Blueprint sets DefaultPawnClass itself
+	UPROPERTY(Config, EditDefaultsOnly, Category = "Classes")
+	TSoftClassPtr<APawn> PlayerPawnClass;
+
 private:
 	// Inventory widget reference
-	UPROPERTY(EditDefaultsOnly, BlueprintReadWrite, Category = "UI", meta = (AllowPrivateAccess = "true"))
-	TSubclassOf<class UInventoryWidget> DefaultInventoryWidgetClass;
+	UPROPERTY(Config, EditDefaultsOnly, BlueprintReadOnly, Category = "UI", meta = (AllowPrivateAccess = "true"))
+	TSoftClassPtr<UInventoryWidget> DefaultInventoryWidgetClass;
+
+	// Keeps the pawn class loading between InitGame and the first spawn
+	TSharedPtr<FStreamableHandle> PlayerPawnClassHandle;
 };
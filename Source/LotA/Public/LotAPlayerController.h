@@ -7,8 +7,19 @@
 #include "InputMappingContext.h"
 #include "MainInventoryWidget.h"
 #include "BagComponent.h"
+#include "TradeTypes.h"
 #include "LotAPlayerController.generated.h"
 
+class UItemUseComponent;
+class UHotbarComponent;
+class UInventoryRouterComponent;
+class UItemInspectComponent;
+class UTradeComponent;
+class UInventoryRegistryComponent;
+class UTradeWindowWidget;
+class UHotbarWidget;
+class UBagWidget;
+
 UCLASS()
 class LOTA_API ALotAPlayerController : public APlayerController
 {
@@ -17,6 +28,8 @@ class LOTA_API ALotAPlayerController : public APlayerController
 public:
     ALotAPlayerController();
 
+    virtual void SetPawn(APawn* InPawn) override;
+
 protected:
     virtual void BeginPlay() override;
     virtual void SetupInputComponent() override;
@@ -31,16 +44,78 @@ public:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Input")
     TObjectPtr<UInputAction> IA_OpenAllBags;
 
+    // One action per hotbar slot, in slot order
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Input")
+    TArray<TObjectPtr<UInputAction>> IA_HotbarSlots;
+
+    // UI classes are soft so the server never loads them; they're resolved on the local controller only
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
+    TSoftClassPtr<UMainInventoryWidget> MainInventoryWidgetClass;
+
+    // Bags of the controlled pawn, with the handles UI and RPCs address them by
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+    TObjectPtr<UInventoryRegistryComponent> InventoryRegistry;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+    TObjectPtr<UItemUseComponent> ItemUseComponent;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+    TObjectPtr<UHotbarComponent> HotbarComponent;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+    TObjectPtr<UInventoryRouterComponent> InventoryRouter;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+    TObjectPtr<UItemInspectComponent> ItemInspect;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Inventory")
+    TObjectPtr<UTradeComponent> TradeComponent;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
+    TSoftClassPtr<UHotbarWidget> HotbarWidgetClass;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
+    TSoftClassPtr<UBagWidget> BagWidgetClass;
+
+    // Opened when a trade starts and removed when it closes
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
+    TSoftClassPtr<UTradeWindowWidget> TradeWindowClass;
+
+    // Bag window layout, in slate units. Windows are sized from these so laying them out needs no widget prepass.
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
+    int32 BagWindowColumns;
+
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
-    TSubclassOf<UMainInventoryWidget> MainInventoryWidgetClass;
+    float BagWindowSlotSize;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
+    float BagWindowChromeHeight;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "UI")
+    float BagWindowSpacing;
 
 private:
     UPROPERTY()
     TObjectPtr<UMainInventoryWidget> MainInventoryWidget;
 
-    // Track open bags
     UPROPERTY()
-    TArray<UBagComponent*> OpenBags;
+    TObjectPtr<UHotbarWidget> HotbarWidget;
+
+    UPROPERTY()
+    TObjectPtr<UTradeWindowWidget> TradeWindow;
+
+    // Open bags and their windows
+    UPROPERTY()
+    TMap<TObjectPtr<UBagComponent>, TObjectPtr<UBagWidget>> OpenBags;
+
+    // Bags opened during a batch, windowed together when the batch ends
+    TArray<TWeakObjectPtr<UBagComponent>> PendingBagWindows;
+
+    // Set while OpenAllBags/CloseAllBags run so per-bag events don't do per-bag work
+    bool bBatchingBagWindows;
+
+    // Pawn whose bag windows are currently shown
+    TWeakObjectPtr<APawn> BagEventPawn;
 
     UFUNCTION()
     void ToggleMainInventory();
@@ -48,9 +123,27 @@ private:
     UFUNCTION()
     void OpenAllBags();
 
+    void ActivateHotbarSlot(int32 SlotIndex);
+
+    UFUNCTION()
+    void OnTradeUpdated(const FTradeWindowState& State);
+
+    UFUNCTION()
+    void OnTradeClosed(bool bCompleted);
+
     UFUNCTION()
     void OnBagOpened(UBagComponent* Bag);
 
     UFUNCTION()
     void OnBagClosed(UBagComponent* Bag);
+
+    // Close every open bag and drop all windows in one pass
+    void CloseAllBags();
+
+    void SubscribeToBag(UBagComponent* Bag);
+
+    // Create windows for all pending bags and position them in a single pass
+    void FlushPendingBagWindows();
+    void RemoveBagWindow(UBagComponent* Bag, UBagWidget* Window);
+    FVector2D GetBagWindowSize(const UBagComponent* Bag) const;
 };
\ No newline at end of file
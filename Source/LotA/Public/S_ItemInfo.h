@@ -13,6 +13,81 @@ enum class EItemType : uint8
     Bag UMETA(DisplayName = "Bag")
 };
 
+// Paper-doll slot an item can be equipped into
+UENUM(BlueprintType)
+enum class EEquipmentSlot : uint8
+{
+    None UMETA(DisplayName = "None"),
+    Head UMETA(DisplayName = "Head"),
+    Shoulders UMETA(DisplayName = "Shoulders"),
+    Chest UMETA(DisplayName = "Chest"),
+    Hands UMETA(DisplayName = "Hands"),
+    Legs UMETA(DisplayName = "Legs"),
+    Feet UMETA(DisplayName = "Feet"),
+    MainHand UMETA(DisplayName = "Main Hand"),
+    OffHand UMETA(DisplayName = "Off Hand"),
+    Bag1 UMETA(DisplayName = "Bag 1"),
+    Bag2 UMETA(DisplayName = "Bag 2"),
+    Bag3 UMETA(DisplayName = "Bag 3"),
+    Bag4 UMETA(DisplayName = "Bag 4"),
+    MAX UMETA(Hidden)
+};
+
+// Bit helpers for filtering by EItemType, one bit per enum value
+namespace ItemTypeMask
+{
+    constexpr uint8 All = 0xFF;
+
+    constexpr uint8 FromType(EItemType Type) { return static_cast<uint8>(1u << static_cast<uint8>(Type)); }
+}
+
+// Flat stat block granted by equipment. Kept trivially copyable so totals can be adjusted incrementally.
+USTRUCT(BlueprintType)
+struct LOTA_API FItemStats
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+    int32 Armor = 0;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+    int32 Damage = 0;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+    int32 Strength = 0;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+    int32 Agility = 0;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+    int32 Stamina = 0;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Stats")
+    int32 Intellect = 0;
+
+    FItemStats& operator+=(const FItemStats& Other)
+    {
+        Armor += Other.Armor;
+        Damage += Other.Damage;
+        Strength += Other.Strength;
+        Agility += Other.Agility;
+        Stamina += Other.Stamina;
+        Intellect += Other.Intellect;
+        return *this;
+    }
+
+    FItemStats& operator-=(const FItemStats& Other)
+    {
+        Armor -= Other.Armor;
+        Damage -= Other.Damage;
+        Strength -= Other.Strength;
+        Agility -= Other.Agility;
+        Stamina -= Other.Stamina;
+        Intellect -= Other.Intellect;
+        return *this;
+    }
+};
+
 USTRUCT(BlueprintType)
 struct LOTA_API FS_ItemInfo
 {
@@ -54,6 +129,28 @@ public:
     UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Info", meta = (EditCondition = "ItemType == EItemType::Bag"))
     float WeightReductionPercentage;
 
+    // Consumable-specific properties. Items sharing a cooldown group go on cooldown together.
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Info", meta = (EditCondition = "ItemType == EItemType::Consumable"))
+    FName CooldownGroup;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Info", meta = (EditCondition = "ItemType == EItemType::Consumable", ClampMin = "0.0"))
+    float CooldownSeconds;
+
+    // Equipment-specific properties
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Info", meta = (EditCondition = "ItemType == EItemType::Equipment"))
+    EEquipmentSlot EquipSlot;
+
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Info", meta = (EditCondition = "ItemType == EItemType::Equipment"))
+    FItemStats Stats;
+
+    // Each copy is a unique instance with its own GUID, durability and rolled stats. Never stacks.
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Info")
+    bool bUniqueInstance;
+
+    // Durability new instances start with; 0 means the item doesn't wear
+    UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "Item Info", meta = (EditCondition = "bUniqueInstance", ClampMin = "0.0"))
+    float MaxDurability;
+
     // Default constructor
     FS_ItemInfo()
         : ItemID(NAME_None)
@@ -65,5 +162,13 @@ public:
         , MaxStackSize(1)
         , BagSlots(0)
         , WeightReductionPercentage(0.0f)
+        , CooldownGroup(NAME_None)
+        , CooldownSeconds(0.0f)
+        , EquipSlot(EEquipmentSlot::None)
+        , bUniqueInstance(false)
+        , MaxDurability(0.0f)
     {}
+
+    // Stack limit actually enforced; definitions with MaxStackSize <= 0 still hold one
+    int32 GetMaxStack() const { return bUniqueInstance ? 1 : FMath::Max(1, MaxStackSize); }
 };
\ No newline at end of file
@@ -0,0 +1,45 @@
+// StartupBenchmarkSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "StartupBenchmarkSubsystem.generated.h"
+
+class UWorld;
+
+// Times startup when the process is launched with -StartupBenchmark: the time until the engine
+// initializes, the first game map load and the total since process start, plus how many objects and
+// Blueprint widget classes are resident once the map is up. One row is appended to
+// Saved/Profiling/StartupBenchmark.csv and the process exits, so runs can be repeated from a script
+// and compared before and after a change:
+//   UnrealEditor LotA -server -log -StartupBenchmark    (dedicated server; widget classes should be 0)
+//   UnrealEditor LotA -game -StartupBenchmark
+// Add -StartupBenchmarkKeepRunning to record without exiting.
+UCLASS()
+class LOTA_API UStartupBenchmarkSubsystem : public UEngineSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+private:
+	// Seconds since process start
+	double EngineInitSeconds = 0.0;
+	double MapLoadStartSeconds = 0.0;
+
+	FString MapName;
+	bool bRecorded = false;
+
+	FDelegateHandle PreLoadMapHandle;
+	FDelegateHandle PostLoadMapHandle;
+
+	void HandlePreLoadMap(const FString& InMapName);
+	void HandlePostLoadMap(UWorld* World);
+
+	void WriteRow(double MapLoadSeconds, double TotalSeconds) const;
+
+	static double SecondsSinceStart();
+};
@@ -0,0 +1,106 @@
+// TradeComponent.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "TradeTypes.h"
+#include "TradeComponent.generated.h"
+
+class APlayerController;
+class APlayerState;
+class UBagComponent;
+class UTradeSubsystem;
+class UVendorComponent;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTradeRequested, APlayerState*, FromPlayer);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTradeUpdated, const FTradeWindowState&, State);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnTradeClosed, bool, bCompleted);
+
+// The player's side of trading and vendor purchases. Lives on the player controller so it has an
+// owning connection; every call is forwarded to the server, which decides through UTradeSubsystem
+// or the vendor, and reports back through the client events.
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class LOTA_API UTradeComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UTradeComponent();
+
+	// Ask another player to trade; the trade opens once they ask back
+	UFUNCTION(BlueprintCallable, Category = "Trade")
+	void RequestTrade(APlayerState* Partner);
+
+	UFUNCTION(BlueprintCallable, Category = "Trade")
+	void StageItem(UBagComponent* Bag, int32 SlotIndex, int32 Count);
+
+	UFUNCTION(BlueprintCallable, Category = "Trade")
+	void UnstageItem(int32 OfferIndex);
+
+	UFUNCTION(BlueprintCallable, Category = "Trade")
+	void SetAccepted(bool bAccepted);
+
+	UFUNCTION(BlueprintCallable, Category = "Trade")
+	void CancelTrade();
+
+	UFUNCTION(BlueprintCallable, Category = "Vendor")
+	void BuyFromVendor(UVendorComponent* Vendor, int32 StockIndex, int32 Count);
+
+	UFUNCTION(BlueprintCallable, Category = "Vendor")
+	void SellToVendor(UVendorComponent* Vendor, UBagComponent* Bag, int32 SlotIndex, int32 Count);
+
+	UFUNCTION(BlueprintPure, Category = "Trade")
+	const FTradeWindowState& GetTradeState() const { return TradeState; }
+
+	UFUNCTION(BlueprintPure, Category = "Trade")
+	bool IsTrading() const { return TradeState.SessionId != 0; }
+
+	UPROPERTY(BlueprintAssignable, Category = "Trade")
+	FOnTradeRequested OnTradeRequested;
+
+	UPROPERTY(BlueprintAssignable, Category = "Trade")
+	FOnTradeUpdated OnTradeUpdated;
+
+	UPROPERTY(BlueprintAssignable, Category = "Trade")
+	FOnTradeClosed OnTradeClosed;
+
+	// Sent by UTradeSubsystem
+	UFUNCTION(Client, Reliable)
+	void ClientTradeRequested(APlayerState* FromPlayer);
+
+	UFUNCTION(Client, Reliable)
+	void ClientTradeUpdated(const FTradeWindowState& State);
+
+	UFUNCTION(Client, Reliable)
+	void ClientTradeClosed(bool bCompleted);
+
+protected:
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	FTradeWindowState TradeState;
+
+	UFUNCTION(Server, Reliable)
+	void ServerRequestTrade(APlayerState* Partner);
+
+	UFUNCTION(Server, Reliable)
+	void ServerStageItem(UBagComponent* Bag, int32 SlotIndex, int32 Count);
+
+	UFUNCTION(Server, Reliable)
+	void ServerUnstageItem(int32 OfferIndex);
+
+	UFUNCTION(Server, Reliable)
+	void ServerSetAccepted(bool bAccepted);
+
+	UFUNCTION(Server, Reliable)
+	void ServerCancelTrade();
+
+	UFUNCTION(Server, Reliable)
+	void ServerBuyFromVendor(UVendorComponent* Vendor, int32 StockIndex, int32 Count);
+
+	UFUNCTION(Server, Reliable)
+	void ServerSellToVendor(UVendorComponent* Vendor, UBagComponent* Bag, int32 SlotIndex, int32 Count);
+
+	APlayerController* GetPlayerController() const;
+	UTradeSubsystem* GetTradeSubsystem() const;
+};
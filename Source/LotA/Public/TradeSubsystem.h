@@ -0,0 +1,105 @@
+// TradeSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "S_ItemInfo.h"
+#include "ItemInstance.h"
+#include "TradeTypes.h"
+#include "TradeSubsystem.generated.h"
+
+class APawn;
+class APlayerController;
+class UBagComponent;
+
+// Server-side player-to-player trades. Each side stages slots from its own bags; once both accept,
+// the session is queued and committed as one all-or-nothing exchange. Every check (ownership,
+// contents, capacity from the bags' cached free-slot counts) runs before the first item moves.
+// Commits go through both players' inventory command queues, so a commit lands after everything
+// either player queued before it and never interleaves with their other inventory changes.
+UCLASS()
+class LOTA_API UTradeSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UTradeSubsystem();
+
+	static UTradeSubsystem* Get(const UObject* WorldContextObject);
+
+	// Offers are capped so a single commit stays cheap
+	static constexpr int32 MaxOfferItems = 12;
+
+	// Ask Target to trade. Opens the session when Target has already asked Requester.
+	void RequestTrade(APlayerController* Requester, APlayerController* Target);
+
+	// Put Count items from a slot of the party's own bag into their offer, replacing any earlier
+	// offer of the same slot. Clears both acceptances.
+	bool StageItem(APlayerController* Party, UBagComponent* Bag, int32 SlotIndex, int32 Count);
+	bool UnstageItem(APlayerController* Party, int32 OfferIndex);
+	void SetAccepted(APlayerController* Party, bool bAccepted);
+	void CancelTrade(APlayerController* Party);
+
+	bool IsTrading(const APlayerController* Party) const { return SessionByParty.Contains(Party); }
+
+	// Parties further apart than this can't open or complete a trade
+	float MaxTradeDistance;
+
+	// Inventory helpers shared with vendors. All of them look at every bag on the pawn.
+	static void GetBags(const APawn* Pawn, TArray<UBagComponent*>& OutBags);
+	static int32 CountFreeSlots(const APawn* Pawn);
+	static int32 CountItem(const APawn* Pawn, FName ItemID);
+	// Empty slots Count items need at most, ignoring room left in existing stacks
+	static int32 SlotsNeeded(const FS_ItemInfo& Item, int32 Count);
+	// Remove Count of an item spread over any slots; false (and nothing removed) if there aren't enough
+	static bool RemoveFromBags(const APawn* Pawn, FName ItemID, int32 Count);
+	// Add items, or one unique item keeping Instance. Returns how many didn't fit.
+	static int32 AddToBags(const APawn* Pawn, const FS_ItemInfo& Item, int32 Count, FItemInstanceHandle Instance = FItemInstanceHandle());
+
+	virtual void Deinitialize() override;
+
+private:
+	struct FTradeSession
+	{
+		TWeakObjectPtr<APlayerController> Parties[2];
+		TArray<FTradeOfferItem> Offers[2];
+		bool bAccepted[2] = { false, false };
+		bool bCommitQueued = false;
+	};
+
+	TMap<int32, FTradeSession> Sessions;
+	TMap<TWeakObjectPtr<const APlayerController>, int32> SessionByParty;
+
+	// Requester -> target of invitations not yet answered
+	TMap<TWeakObjectPtr<const APlayerController>, TWeakObjectPtr<const APlayerController>> PendingRequests;
+
+	int32 NextSessionId;
+
+	// Bags with staged slots, watched so any change to a staged slot withdraws both acceptances
+	TMap<TWeakObjectPtr<UBagComponent>, FDelegateHandle> WatchedBags;
+
+	// Set while a commit moves items, whose slot changes are the trade itself
+	bool bCommitting = false;
+
+	FTradeSession* FindSession(const APlayerController* Party, int32& OutSide);
+
+	// Run a commit queued once both sides accepted
+	void CommitQueued(int32 SessionId);
+
+	// Clear a queued commit that was dropped without running
+	void CommitDiscarded(int32 SessionId);
+
+	// Validate and apply the whole exchange; nothing changes if it returns false
+	bool Commit(FTradeSession& Session);
+	bool ValidateOffer(const FTradeSession& Session, int32 Side) const;
+	bool InRange(const FTradeSession& Session) const;
+
+	void ResetAcceptance(FTradeSession& Session);
+
+	void WatchBag(UBagComponent* Bag);
+	void UnwatchUnstagedBags();
+	void HandleBagSlotChanged(UBagComponent* Bag, int32 SlotIndex);
+
+	void SendState(int32 SessionId, const FTradeSession& Session) const;
+	void EndSession(int32 SessionId, bool bCompleted);
+};
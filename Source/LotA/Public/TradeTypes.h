@@ -0,0 +1,59 @@
+// TradeTypes.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ItemInstance.h"
+#include "TradeTypes.generated.h"
+
+class APlayerState;
+class UBagComponent;
+
+// One stack a player has put up in a trade. Items stay in the bag until the trade commits; the
+// entry only says which slot to take them from. Entries describing the partner's side carry no bag.
+USTRUCT(BlueprintType)
+struct LOTA_API FTradeOfferItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Trade")
+	TObjectPtr<UBagComponent> Bag = nullptr;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Trade")
+	int32 SlotIndex = INDEX_NONE;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Trade")
+	FName ItemID;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Trade")
+	int32 Count = 0;
+
+	// Instance in the slot when it was staged, so a different copy of a unique item can't be swapped in
+	UPROPERTY()
+	FItemInstanceHandle Instance;
+};
+
+// A trade as one party sees it. Sent to each client whenever either side changes anything.
+USTRUCT(BlueprintType)
+struct LOTA_API FTradeWindowState
+{
+	GENERATED_BODY()
+
+	// 0 when no trade is open
+	UPROPERTY(BlueprintReadOnly, Category = "Trade")
+	int32 SessionId = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Trade")
+	TObjectPtr<APlayerState> Partner = nullptr;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Trade")
+	TArray<FTradeOfferItem> MyOffer;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Trade")
+	TArray<FTradeOfferItem> PartnerOffer;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Trade")
+	bool bMyAccepted = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Trade")
+	bool bPartnerAccepted = false;
+};
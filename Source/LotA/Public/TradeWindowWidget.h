@@ -0,0 +1,71 @@
+// TradeWindowWidget.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DraggableWindowBase.h"
+#include "TradeTypes.h"
+#include "TradeWindowWidget.generated.h"
+
+class UButton;
+class UPanelWidget;
+class UTextBlock;
+class UInventorySlotWidget;
+class UTradeComponent;
+
+// Both sides of an open trade. Offers are drawn from the state the server sends, with slot widgets
+// taken from the shared pool; items dropped on the window are staged through the inventory router.
+UCLASS()
+class LOTA_API UTradeWindowWidget : public UDraggableWindowBase
+{
+	GENERATED_BODY()
+
+public:
+	UTradeWindowWidget(const FObjectInitializer& ObjectInitializer);
+
+	UFUNCTION(BlueprintCallable, Category = "Trade")
+	void BindToTrade(UTradeComponent* InTrade);
+
+protected:
+	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
+	virtual bool NativeOnDrop(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation) override;
+
+	UPROPERTY(meta = (BindWidget))
+	UPanelWidget* MyOfferPanel;
+
+	UPROPERTY(meta = (BindWidget))
+	UPanelWidget* PartnerOfferPanel;
+
+	UPROPERTY(meta = (BindWidgetOptional))
+	UButton* AcceptButton;
+
+	UPROPERTY(meta = (BindWidgetOptional))
+	UButton* CancelButton;
+
+	UPROPERTY(meta = (BindWidgetOptional))
+	UTextBlock* PartnerNameText;
+
+	UPROPERTY(meta = (BindWidgetOptional))
+	UTextBlock* StatusText;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UInventorySlotWidget>> MyOfferWidgets;
+
+	UPROPERTY()
+	TArray<TObjectPtr<UInventorySlotWidget>> PartnerOfferWidgets;
+
+private:
+	TWeakObjectPtr<UTradeComponent> Trade;
+
+	UFUNCTION()
+	void HandleTradeUpdated(const FTradeWindowState& State);
+
+	UFUNCTION()
+	void HandleAcceptClicked();
+
+	UFUNCTION()
+	void HandleCancelClicked();
+
+	void FillOfferPanel(UPanelWidget* Panel, TArray<TObjectPtr<UInventorySlotWidget>>& Widgets, const TArray<FTradeOfferItem>& Offer);
+	void ReleaseOfferWidgets(TArray<TObjectPtr<UInventorySlotWidget>>& Widgets);
+};
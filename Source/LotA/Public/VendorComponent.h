@@ -0,0 +1,87 @@
+// VendorComponent.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "VendorComponent.generated.h"
+
+class AItemBase;
+class APawn;
+class APlayerController;
+class UBagComponent;
+struct FS_ItemInfo;
+
+// One line of a vendor's stock
+USTRUCT(BlueprintType)
+struct LOTA_API FVendorStockEntry
+{
+	GENERATED_BODY()
+
+	// Item whose ItemDetails defaults are sold
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Vendor")
+	TSubclassOf<AItemBase> ItemClass;
+
+	// Cost of one item in the vendor's currency
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Vendor", meta = (ClampMin = "1"))
+	int32 Price = 1;
+
+	// How many are left; -1 never runs out
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Vendor", meta = (ClampMin = "-1"))
+	int32 Quantity = -1;
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnVendorStockChanged, class UVendorComponent* /*Vendor*/);
+
+// Shop on an NPC. The stock is one read-only array on the vendor actor, replicated to whichever
+// clients the actor is relevant to, so players nearby share it instead of each getting a copy.
+// Purchases and sales arrive through the player's UTradeComponent and are queued on
+// UInventoryCommandSubsystem, so they land in order with the player's other inventory changes; they
+// are checked when they run.
+UCLASS(ClassGroup=(Custom), meta=(BlueprintSpawnableComponent))
+class LOTA_API UVendorComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UVendorComponent();
+
+	UFUNCTION(BlueprintPure, Category = "Vendor")
+	const TArray<FVendorStockEntry>& GetStock() const { return Stock; }
+
+	// Queue Purchase or Sell for Player's pawn behind the player's other inventory commands (authority only)
+	void QueuePurchase(APlayerController* Player, int32 StockIndex, int32 Count);
+	void QueueSell(APlayerController* Player, UBagComponent* Bag, int32 SlotIndex, int32 Count);
+
+	// Buy Count of a stock entry for Buyer (authority only). Nothing changes unless the buyer can pay
+	// and has room for all of it.
+	bool Purchase(APawn* Buyer, int32 StockIndex, int32 Count);
+
+	// Sell items from one of Seller's bag slots (authority only). Vendors only buy what they stock.
+	bool Sell(APawn* Seller, UBagComponent* Bag, int32 SlotIndex, int32 Count);
+
+	bool IsInRange(const APawn* Pawn) const;
+
+	// Fired when stock replicates or changes on the server
+	FOnVendorStockChanged OnStockChanged;
+
+protected:
+	UPROPERTY(EditAnywhere, ReplicatedUsing = OnRep_Stock, Category = "Vendor")
+	TArray<FVendorStockEntry> Stock;
+
+	// Item used as money
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Vendor")
+	TSubclassOf<AItemBase> CurrencyClass;
+
+	// Fraction of the stock price paid when the vendor buys an item back
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Vendor", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float SellPriceScale;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Vendor", meta = (ClampMin = "0.0"))
+	float InteractionRange;
+
+private:
+	UFUNCTION()
+	void OnRep_Stock();
+
+	const FS_ItemInfo* GetCurrency() const;
+};
@@ -0,0 +1,33 @@
+// WindowLayoutSubsystem.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/LocalPlayerSubsystem.h"
+#include "WindowLayoutSubsystem.generated.h"
+
+class APlayerController;
+
+// Remembers where a local player left each window. Positions are whole slate units keyed by window name
+// and stored one line per window ("Key=X,Y") in that player's section of GameUserSettings.ini.
+UCLASS()
+class LOTA_API UWindowLayoutSubsystem : public ULocalPlayerSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UWindowLayoutSubsystem* Get(const APlayerController* PlayerController);
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	bool FindWindowPosition(FName WindowKey, FVector2D& OutPosition) const;
+	void SetWindowPosition(FName WindowKey, const FVector2D& Position);
+
+	// Write pending changes to disk
+	void SaveLayout();
+
+private:
+	TMap<FName, FIntPoint> Positions;
+	FString ConfigSection;
+	bool bDirty = false;
+};
@@ -0,0 +1,18 @@
+// WorldDropTargetWidget.h
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "WorldDropTargetWidget.generated.h"
+
+// The game area as a drop target: items released over it are dropped on the ground. Put it at the
+// bottom of the HUD as a sibling behind the inventory windows, not as their parent, so drops on a
+// window never bubble into it. A drag released anywhere else is cancelled and the item stays put.
+UCLASS()
+class LOTA_API UWorldDropTargetWidget : public UUserWidget
+{
+	GENERATED_BODY()
+
+protected:
+	virtual bool NativeOnDrop(const FGeometry& InGeometry, const FDragDropEvent& InDragDropEvent, UDragDropOperation* InOperation) override;
+};